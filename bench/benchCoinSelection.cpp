@@ -0,0 +1,58 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarks.h"
+#include "benchmark.h"
+#include "../util/ui.h"
+#include "../wallet/wallet.h"
+
+namespace bench {
+
+using wallet::WalletOutput;
+
+static void runCoinSelection(const QString & name, int iterations, const QVector<WalletOutput> & outputs, int64_t amount) {
+    printResult(runBenchmark(name, iterations, 1, [&]() {
+        QStringList resultOutputs;
+        util::calcOutputsToSpend(amount, outputs, resultOutputs);
+    }));
+}
+
+void benchmarkCoinSelection(int iterations) {
+    // Reproducible data
+    qsrand(1);
+
+    for (int outputNum : {1000, 10000, 50000}) {
+        // Mining wallet: mostly block rewards with some fees, plus a few larger outputs
+        QVector<WalletOutput> mining;
+        // Random values, every output is different
+        QVector<WalletOutput> random;
+
+        for (int i = 0; i < outputNum; i++) {
+            int64_t amount = (i%10==0) ? int64_t(qrand() % 100000) * 1000000LL : 600000000LL + (qrand() % 1000);
+            mining.push_back(WalletOutput::create(QString::number(amount), "", "", "", "Unspent", true, "", amount, 1L));
+            mining.last().weight = 1.0;
+
+            amount = int64_t(qrand() % 1000000) * 1000LL + i;
+            random.push_back(WalletOutput::create(QString::number(amount), "", "", "", "Unspent", false, "", amount, 1L));
+            random.last().weight = 1.0;
+        }
+
+        const QString sz = QString::number(outputNum);
+        runCoinSelection("coin selection, mining " + sz, iterations, mining, 77777777777LL);
+        runCoinSelection("coin selection, random " + sz, iterations, random, 77777777777LL);
+        runCoinSelection("coin selection, exact " + sz, iterations, random, random[outputNum/2].valueNano);
+    }
+}
+
+}
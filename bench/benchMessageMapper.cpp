@@ -0,0 +1,43 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarks.h"
+#include "benchmark.h"
+#include "../core/MessageMapper.h"
+#include "../util/Files.h"
+
+namespace bench {
+
+void benchmarkMessageMapper(int iterations) {
+    const QString configFileName(":/resource/mwc713_mappers.txt");
+    notify::MessageMapper mapper(configFileName);
+
+    // Config comments have the samples of the real messages. Adding some normal messages as well,
+    // most of the traffic doesn't need any mapping.
+    QStringList messages;
+    for (const auto & l : util::readTextFile( configFileName, true, false)) {
+        if (l.startsWith("# ") && l.contains("Error"))
+            messages.push_back(l.mid(2).simplified());
+    }
+    messages.push_back("Some normal message");
+    messages.push_back("Tx Pool Duplicate tx");
+    messages.push_back("Wallet is syncing with the node, please wait");
+
+    printResult(runBenchmark("mwc713 message mapper, per message", iterations, messages.size(), [&]() {
+        for (const QString & msg : messages)
+            mapper.processMessage(msg);
+    }));
+}
+
+}
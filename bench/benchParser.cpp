@@ -0,0 +1,130 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarks.h"
+#include "benchmark.h"
+#include "../tries/mwc713inputparser.h"
+#include "../wallet/mwc713events.h"
+#include "../core/global.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+
+namespace bench {
+
+// mwc713 stdout comes by pieces, process is reading what is available
+const static int STDOUT_CHUNK_SIZE = 4096;
+
+// Output of the typical session: start, account info, transactions and outputs listing, sync.
+static QString buildSyntheticCapture() {
+    QStringList lines;
+    lines << "Welcome to wallet713 for MWC v4.4.0"
+          << "Unlock your existing wallet or type `init` to initiate a new one"
+          << mwc::PROMPTS_MWC713
+          << "Your mwcmqs address: xmgcJYZG6eG5ajHdZZGh8gXv5Ne4rdArrKwpSajQGhenUXdJQA5V"
+          << "mwcmqs listener started for [xmgcJYZG6eG5ajHdZZGh8gXv5Ne4rdArrKwpSajQGhenUXdJQA5V] tid=[xa5ktaMRCEmj151Rfxr7a]"
+          << mwc::PROMPTS_MWC713;
+
+    for (int k = 0; k < 100; k++)
+        lines << "Checking " + QString::number(k*1000) + " blocks, Height: " + QString::number(331630 + k*1000) + " - " +
+                 QString::number(331630 + k*1000 + 999) + ", " + QString::number(k) + "% complete";
+    lines << "Scanning Complete" << mwc::PROMPTS_MWC713;
+
+    lines << "____ Wallet Summary Info - Account 'default' as of height 813472 ____"
+          << " Confirmed Total                  | 1247.234000000"
+          << " Awaiting Confirmation (< 10)     | 0.000000000"
+          << " Awaiting Finalization            | 0.000000000"
+          << " Locked by previous transaction   | 0.000000000"
+          << " -------------------------------- | -------------"
+          << " Currently Spendable              | 1247.234000000"
+          << mwc::PROMPTS_MWC713;
+
+    lines << "Transaction Log - Account 'default' - Block Height: 813472";
+    for (int k = 0; k < 2000; k++)
+        lines << QString(" %1  Received Tx   None  8a4b6f2e-%2-4f6b-9c1d-2f3a5b7c9d0e  2021-03-%3 11:22:33  true  2021-03-%3 11:25:01  1  0  %4.000000000  0.000000000  %4.000000000  None  true  None")
+                 .arg(k, 5).arg(k, 4, 10, QChar('0')).arg(k % 28 + 1, 2, 10, QChar('0')).arg(k % 97 + 1);
+    lines << mwc::PROMPTS_MWC713;
+
+    lines << "Wallet Outputs - Account 'default' - Block Height: 813472";
+    for (int k = 0; k < 2000; k++)
+        lines << QString(" 08a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9b0c1d2e3f4a5b6c7d8e9f0%1  %2  None  Unspent  false  1  %3  %4.000000000  %5")
+                 .arg(k, 4, 10, QChar('0')).arg(800000 + k).arg(813472 - 800000 - k).arg(k % 97 + 1).arg(k);
+    lines << mwc::PROMPTS_MWC713;
+
+    for (int k = 0; k < 50; k++) {
+        lines << "slate [b2822262-4760-4907-923f-e2459ed5d" + QString::number(k % 10) + "54] received from [jbyrer] for [1.000000000] MWCs."
+              << "WARNING: listener [xmgcJYZG6eG5ajHdZZGh8gXv5Ne4rdArrKwpSajQGhenUXdJQA5V] lost connection. it will keep trying to restore connection in the background."
+              << "INFO: listener [xmgcJYZG6eG5ajHdZZGh8gXv5Ne4rdArrKwpSajQGhenUXdJQA5V] reestablished connection."
+              << mwc::PROMPTS_MWC713;
+    }
+    return lines.join("\n") + "\n";
+}
+
+static QStringList splitToChunks(const QString & capture) {
+    QStringList chunks;
+    for (int pos = 0; pos < capture.size(); pos += STDOUT_CHUNK_SIZE)
+        chunks.push_back(capture.mid(pos, STDOUT_CHUNK_SIZE));
+    return chunks;
+}
+
+void benchmarkMwc713Parser(const QStringList & captureFiles, int iterations) {
+    QString capture;
+    if (captureFiles.isEmpty()) {
+        capture = buildSyntheticCapture();
+    }
+    else {
+        for (const QString & fn : captureFiles) {
+            QFile file(fn);
+            if (!file.open(QIODevice::ReadOnly)) {
+                QTextStream(stderr) << "Unable to read capture file " << fn << "\n";
+                continue;
+            }
+            capture += QString::fromUtf8(file.readAll());
+        }
+    }
+
+    if (capture.isEmpty())
+        return;
+
+    const QStringList chunks = splitToChunks(capture);
+    const qint64 lines = capture.count('\n') + 1;
+
+    tries::Mwc713InputParser parser;
+    qint64 events = 0;
+    QObject::connect(&parser, &tries::Mwc713InputParser::sgGenericEvent,
+                     [&events](wallet::WALLET_EVENTS, QString) {events++;});
+
+    printResult(runBenchmark("mwc713 parser, per line", iterations, lines, [&]() {
+        for (const QString & ch : chunks)
+            parser.processInput(ch);
+    }));
+
+    const qint64 eventsPerCapture = events / (iterations + 1);
+    if (eventsPerCapture == 0)
+        return;
+
+    // Event manager is connected with a queued connection, as in the wallet. Dispatch is done by the event loop.
+    // There is no mwc713 process, so no tasks. It is the routing and listeners cost.
+    wallet::Mwc713EventManager eventManager(nullptr);
+    eventManager.connectWith(&parser);
+
+    printResult(runBenchmark("mwc713 parser + event manager, per event", iterations, eventsPerCapture, [&]() {
+        for (const QString & ch : chunks) {
+            parser.processInput(ch);
+            QCoreApplication::processEvents();
+        }
+    }));
+}
+
+}
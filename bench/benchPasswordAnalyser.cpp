@@ -0,0 +1,60 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarks.h"
+#include "benchmark.h"
+#include "../util/passwordanalyser.h"
+
+namespace bench {
+
+static QStringList generatePasswords(int count) {
+    static const QStringList words{"password", "dragon", "monkey", "sunshine", "mwc", "wallet", "qwerty", "letmein"};
+    static const QString symbols("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*");
+
+    // Reproducible data
+    qsrand(2);
+    QStringList res;
+    for (int i = 0; i < count; i++) {
+        QString pass;
+        switch (i % 3) {
+            case 0: // dictionary words with a number
+                pass = words[qrand() % words.size()] + QString::number(qrand() % 10000);
+                break;
+            case 1: // sequences
+                pass = "abcd1234" + QString::number(i);
+                break;
+            default: // random
+                for (int k = 0; k < 8 + qrand() % 12; k++)
+                    pass += symbols[qrand() % symbols.size()];
+        }
+        res.push_back(pass);
+    }
+    return res;
+}
+
+void benchmarkPasswordAnalyser(int iterations) {
+    util::PasswordAnalyser analyser;
+    const QStringList passwords = generatePasswords(1000);
+
+    printResult(runBenchmark("password analyser, per password", iterations, passwords.size(), [&]() {
+        for (const QString & pass : passwords) {
+            QVector<double> weight;
+            QStringList seqWords;
+            QStringList dictWords;
+            analyser.getPasswordQualityReport(pass, weight, seqWords, dictWords);
+        }
+    }));
+}
+
+}
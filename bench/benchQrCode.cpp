@@ -0,0 +1,61 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarks.h"
+#include "benchmark.h"
+#include "../util/QrCode.h"
+#include "../util/qrimage.h"
+
+namespace bench {
+
+// Slatepack armor alphabet, the largest payload that still fits version 40 with medium error correction
+static QString generateMaxPayload(int seed) {
+    static const QString symbols("123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz");
+    qsrand(uint(seed));
+    QString res = "BEGINSLATEPACK. ";
+    while (res.size() < 2300)
+        res += symbols[qrand() % symbols.size()];
+    return res + ". ENDSLATEPACK.";
+}
+
+void benchmarkQrCode(int iterations) {
+    const QString payload = generateMaxPayload(3);
+    const std::string payloadStr = payload.toStdString();
+    Q_ASSERT( qrcodegen::QrCode::encodeText(payloadStr.c_str(), qrcodegen::QrCode::Ecc::MEDIUM).getVersion() == 40 );
+
+    printResult(runBenchmark("qr encode, version 40", iterations, 1, [&]() {
+        qrcodegen::QrCode::encodeText(payloadStr.c_str(), qrcodegen::QrCode::Ecc::MEDIUM);
+    }));
+
+    // Every payload is new, encoding and rendering
+    int payloadIdx = 100;
+    printResult(runBenchmark("qr image, new payload 600px", iterations, 1, [&]() {
+        util::getQrCodeImage(generateMaxPayload(payloadIdx++), QSize(600, 600));
+    }));
+
+    // Resizing: payload is encoded already, only rendering
+    int sizeIdx = 0;
+    printResult(runBenchmark("qr image, resize 400-800px", iterations, 10, [&]() {
+        for (int i = 0; i < 10; i++, sizeIdx++)
+            util::getQrCodeImage(payload, QSize(400 + sizeIdx % 400, 400 + sizeIdx % 400));
+    }));
+
+    // Paint or reopen: image is cached
+    printResult(runBenchmark("qr image, cached 600px", iterations, 1000, [&]() {
+        for (int i = 0; i < 1000; i++)
+            util::getQrCodeImage(payload, QSize(600, 600));
+    }));
+}
+
+}
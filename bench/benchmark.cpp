@@ -0,0 +1,132 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark.h"
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+// Counting allocations. This executable only, the wallet doesn't have that.
+static std::atomic<quint64> allocationsCount(0);
+
+void * operator new(std::size_t size) {
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    void * p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void * operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace bench {
+
+quint64 getAllocationsCount() {
+    return allocationsCount.load(std::memory_order_relaxed);
+}
+
+qint64 getPeakMemoryKb() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return qint64(pmc.PeakWorkingSetSize / 1024);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef Q_OS_MAC
+    return qint64(usage.ru_maxrss / 1024); // bytes at mac
+#else
+    return qint64(usage.ru_maxrss);
+#endif
+#endif
+}
+
+BenchmarkResult runBenchmark(const QString & name, int iterations, qint64 opsPerIteration,
+                             const std::function<void()> & body) {
+    Q_ASSERT(iterations > 0 && opsPerIteration > 0);
+
+    // Warm up: caches, lazy initialization, dictionaries loading
+    body();
+
+    const quint64 allocs = getAllocationsCount();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++)
+        body();
+
+    const qint64 ns = timer.nsecsElapsed();
+
+    BenchmarkResult res;
+    res.name = name;
+    res.ops = opsPerIteration * iterations;
+    res.nsPerOp = double(ns) / double(res.ops);
+    res.allocsPerOp = double(getAllocationsCount() - allocs) / double(res.ops);
+    res.peakMemoryKb = getPeakMemoryKb();
+    return res;
+}
+
+void printHeader() {
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5\n")
+                .arg("Benchmark", -40)
+                .arg("ops", 12)
+                .arg("ns/op", 14)
+                .arg("allocs/op", 12)
+                .arg("peak Kb", 12);
+}
+
+void printResult(const BenchmarkResult & result) {
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5\n")
+                .arg(result.name, -40)
+                .arg(result.ops, 12)
+                .arg(result.nsPerOp, 14, 'f', 1)
+                .arg(result.allocsPerOp, 12, 'f', 2)
+                .arg(result.peakMemoryKb, 12);
+}
+
+}
@@ -0,0 +1,48 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHMARK_H
+#define MWC_QT_WALLET_BENCHMARK_H
+
+#include <QString>
+#include <functional>
+
+namespace bench {
+
+struct BenchmarkResult {
+    QString name;
+    qint64  ops = 0;            // operations that was done by all iterations
+    double  nsPerOp = 0.0;
+    double  allocsPerOp = 0.0;  // heap allocations per operation
+    qint64  peakMemoryKb = 0;   // process peak memory after the run
+};
+
+// Run 'body' for 'iterations' times. Every call of body does 'opsPerIteration' operations.
+// First call is a warm up and not measured.
+BenchmarkResult runBenchmark(const QString & name, int iterations, qint64 opsPerIteration,
+                             const std::function<void()> & body);
+
+// Print the result as a single table line. Print header first.
+void printHeader();
+void printResult(const BenchmarkResult & result);
+
+// Heap allocations since the start. Counted by operator new replacement at benchmark.cpp
+quint64 getAllocationsCount();
+
+// Peak process memory (RSS/working set) in Kb
+qint64 getPeakMemoryKb();
+
+}
+
+#endif //MWC_QT_WALLET_BENCHMARK_H
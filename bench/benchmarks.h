@@ -0,0 +1,40 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHMARKS_H
+#define MWC_QT_WALLET_BENCHMARKS_H
+
+#include <QStringList>
+
+namespace bench {
+
+// Replay mwc713 stdout through Mwc713InputParser and Mwc713EventManager.
+// captureFiles - recorded mwc713 output. If empty, synthetic capture is used.
+void benchmarkMwc713Parser(const QStringList & captureFiles, int iterations);
+
+// notify::MessageMapper for the samples from the mwc713 mappers config
+void benchmarkMessageMapper(int iterations);
+
+// util::calcOutputsToSpend for the mining and random wallets
+void benchmarkCoinSelection(int iterations);
+
+// util::PasswordAnalyser for generated passwords
+void benchmarkPasswordAnalyser(int iterations);
+
+// QR code encoding and image rendering for the max size slatepack payloads
+void benchmarkQrCode(int iterations);
+
+}
+
+#endif //MWC_QT_WALLET_BENCHMARKS_H
@@ -0,0 +1,57 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <algorithm>
+#include "benchmark.h"
+#include "benchmarks.h"
+#include "../util/Log.h"
+
+// Benchmarks for the performance critical parts of the wallet: mwc713 output parsing and messages mapping, coin selection, password analysis,
+// QR code rendering.
+// Usage: mwc-qt-wallet-bench [--capture <mwc713 stdout file>]... [--iterations N] [--filter parser|coins|passwords|qr]
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser cmdParser;
+    cmdParser.addHelpOption();
+    cmdParser.addOptions({
+        {"capture", "Recorded mwc713 stdout to replay. Can be used several times.", "file"},
+        {"iterations", "Number of iterations for every benchmark, default 10.", "count", "10"},
+        {"filter", "Run only benchmarks from the group: parser, coins, passwords, qr.", "group"},
+    });
+    cmdParser.process(app);
+
+    const QStringList captureFiles = cmdParser.values("capture");
+    const int iterations = std::max(1, cmdParser.value("iterations").toInt());
+    const QString filter = cmdParser.value("filter");
+
+    // Parser is logging the events
+    logger::initLogger(false);
+
+    bench::printHeader();
+    if (filter.isEmpty() || filter == "parser") {
+        bench::benchmarkMwc713Parser(captureFiles, iterations);
+        bench::benchmarkMessageMapper(iterations);
+    }
+    if (filter.isEmpty() || filter == "coins")
+        bench::benchmarkCoinSelection(iterations);
+    if (filter.isEmpty() || filter == "passwords")
+        bench::benchmarkPasswordAnalyser(iterations);
+    if (filter.isEmpty() || filter == "qr")
+        bench::benchmarkQrCode(iterations);
+
+    return 0;
+}
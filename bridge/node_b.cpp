@@ -41,8 +41,28 @@ QString Node::getLogsLocation() {
     return getNode()->getLogsLocation();
 }
 
-QStringList Node::getOutputLines() {
-    return getNode()->getOutputLines();
+QStringList Node::getOutputLines(int maxLines) {
+    return getNode()->getOutputLines().snapshot(maxLines);
+}
+
+QStringList Node::searchOutputLines(QString text, int maxLines) {
+    const util::LinesRingBuffer & lines = getNode()->getOutputLines();
+    QStringList res;
+    for (quint64 seq : lines.search(text, maxLines))
+        res.push_back(lines.line(seq));
+    return res;
+}
+
+QVector<QString> Node::getHealthHistory() {
+    QVector<QString> res;
+    for (const node::NodeHealthSample & s : getNode()->getHealthHistory()) {
+        res.push_back(QString::number(s.time));
+        res.push_back(QString::number(s.height));
+        res.push_back(QString::number(s.peersHeight));
+        res.push_back(QString::number(s.connections));
+        res.push_back(QString::number(s.syncRate, 'f', 1));
+    }
+    return res;
 }
 
 void Node::onMwcOutputLine(QString line) {
@@ -16,6 +16,7 @@
 #define MWC_QT_WALLET_NODE_B_H
 
 #include <QObject>
+#include <QVector>
 
 namespace bridge {
 
@@ -29,8 +30,15 @@ public:
     // Node log location
     Q_INVOKABLE QString getLogsLocation();
 
-    // Last log lines from the node.
-    Q_INVOKABLE QStringList getOutputLines();
+    // Last log lines from the node, the newest first. maxLines<0 - all of them
+    Q_INVOKABLE QStringList getOutputLines(int maxLines = -1);
+
+    // Node log lines that contain text (case insensitive), the newest first.
+    Q_INVOKABLE QStringList searchOutputLines(QString text, int maxLines);
+
+    // Node health history for the charts, the oldest first. Data returned in series of
+    // [time (ms since epoch), height, peers height, connections, sync rate (blocks per minute)]
+    Q_INVOKABLE QVector<QString> getHealthHistory();
 
 signals:
     // New line at Node logs
@@ -16,6 +16,7 @@
 #include "../core/Notification.h"
 #include "../state/state.h"
 #include "../wallet/wallet.h"
+#include <QMetaMethod>
 
 
 namespace bridge {
@@ -164,19 +165,33 @@ void Wallet::onFileProofAddress(QString address) {
 }
 
 void Wallet::onOutputs( QString account, bool showSpent, int64_t height, QVector<wallet::WalletOutput> outputs) {
-    QVector<QString> outs;
-    for (const auto & o : outputs) {
-        outs.push_back( o.toJson() );
+    const QString heightStr = QString::number(height);
+    emit sgnOutputList( account, showSpent, heightStr, outputs);
+
+    // Json is needed by QML only. Desktop windows are using sgnOutputList
+    if (isSignalConnected(QMetaMethod::fromSignal(&Wallet::sgnOutputs))) {
+        QVector<QString> outs;
+        outs.reserve(outputs.size());
+        for (const auto & o : outputs) {
+            outs.push_back( o.toJson() );
+        }
+        emit sgnOutputs( account, showSpent, heightStr, outs);
     }
-    emit sgnOutputs( account, showSpent, QString::number(height), outs);
 }
 
 void Wallet::onTransactions( QString account, int64_t height, QVector<wallet::WalletTransaction> transactions) {
-    QVector<QString> trans;
-    for (auto & t : transactions)
-        trans.push_back(t.toJson());
+    const QString heightStr = QString::number(height);
+    emit sgnTransactionList( account, heightStr, transactions);
+
+    // Json is needed by QML only. Desktop windows are using sgnTransactionList
+    if (isSignalConnected(QMetaMethod::fromSignal(&Wallet::sgnTransactions))) {
+        QVector<QString> trans;
+        trans.reserve(transactions.size());
+        for (const auto & t : transactions)
+            trans.push_back(t.toJson());
 
-    emit sgnTransactions( account, QString::number(height), trans);
+        emit sgnTransactions( account, heightStr, trans);
+    }
 }
 void Wallet::onCancelTransacton( bool success, QString account, int64_t trIdx, QString errMessage ) {
     emit sgnCancelTransacton(success, account, QString::number(trIdx), errMessage);
@@ -378,15 +393,15 @@ void Wallet::requestWalletBalanceUpdate() {
 }
 
 // Request list of outputs for the account.
-// Respond will be with sgnOutputs
-void Wallet::requestOutputs(QString account, bool show_spent, bool enforceSync) {
-    getWallet()->getOutputs(account,show_spent, enforceSync);
+// Respond will be with sgnOutputList and sgnOutputs
+void Wallet::requestOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache) {
+    getWallet()->getOutputs(account,show_spent, enforceSync, fromCache);
 }
 
 // Show all transactions for current account
-// Respond: sgnTransactions( QString account, QString height, QVector<QString> Transactions);
-void Wallet::requestTransactions(QString account, bool enforceSync) {
-    getWallet()->getTransactions(account, enforceSync);
+// Respond: sgnTransactionList and sgnTransactions( QString account, QString height, QVector<QString> Transactions);
+void Wallet::requestTransactions(QString account, bool enforceSync, bool fromCache) {
+    getWallet()->getTransactions(account, enforceSync, fromCache);
 }
 
 // get Extended info for specific transaction
@@ -101,12 +101,14 @@ public:
     Q_INVOKABLE void requestWalletBalanceUpdate();
 
     // Request list of outputs for the account.
-    // Respond will be with sgnOutputs
-    Q_INVOKABLE void requestOutputs(QString account, bool show_spent, bool enforceSync);
+    // fromCache - cached outputs are responded first, then the fresh ones. Use for the initial page load.
+    // Respond will be with sgnOutputList and sgnOutputs
+    Q_INVOKABLE void requestOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache);
 
     // Show all transactions for current account
-    // Respond: sgnTransactions( QString account, QString height, QVector<QString> Transactions);
-    Q_INVOKABLE void requestTransactions(QString account, bool enforceSync);
+    // fromCache - cached transactions are responded first, then the fresh ones. Use for the initial page load.
+    // Respond: sgnTransactionList and sgnTransactions( QString account, QString height, QVector<QString> Transactions);
+    Q_INVOKABLE void requestTransactions(QString account, bool enforceSync, bool fromCache);
 
     // get Extended info for specific transaction
     // Respond:  sgnTransactionById( bool success, QString account, QString height, QString transaction,
@@ -186,11 +188,17 @@ signals:
 
     // Outputs requested form the wallet.
     // outputs are in Json format, see wallet::WalletOutput for details
+    // Json is built only if the signal is connected (QML). C++ clients should use sgnOutputList.
     void sgnOutputs( QString account, bool showSpent, QString height, QVector<QString> outputs);
+    // The same outputs as sgnOutputs. The vector is shared with the wallet data, no copy or conversion is made.
+    void sgnOutputList( QString account, bool showSpent, QString height, QVector<wallet::WalletOutput> outputs);
 
     //  Transactions from the requestTransactions request
     // Transactions are in Json format, see wallet::WalletTransaction for details
+    // Json is built only if the signal is connected (QML). C++ clients should use sgnTransactionList.
     void sgnTransactions( QString account, QString height, QVector<QString> transactions);
+    // The same transactions as sgnTransactions. The vector is shared with the wallet data, no copy or conversion is made.
+    void sgnTransactionList( QString account, QString height, QVector<wallet::WalletTransaction> transactions);
     // Transaction from getTransactionById request
     // transaction: JSON for wallet::WalletTransaction
     // outputs: JSON for  wallet::WalletOutput
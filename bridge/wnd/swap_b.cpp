@@ -291,6 +291,14 @@ QVector<QString> Swap::getRunningCriticalTrades() {
     return getSwap()->getRunningCriticalTrades();
 }
 
+int Swap::getStepLatencyMs(QString swapId) {
+    return int(getSwap()->getTradeStepLatencyMs(swapId));
+}
+
+int Swap::getAvgStepLatencyMs(QString swapId) {
+    return int(getSwap()->getTradeAvgStepLatencyMs(swapId));
+}
+
 void Swap::adjustSwapData( QString swapId, QString call_tag,
                                   QString destinationMethod, QString destinationDest,
                                   QString secondaryAddress,
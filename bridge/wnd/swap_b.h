@@ -60,6 +60,11 @@ public:
     // Critical Trade Ids that are in progress
     Q_INVOKABLE QVector<QString> getRunningCriticalTrades();
 
+    // Duration of the last auto swap step for the trade in ms. -1 if trade isn't running or no steps was done yet
+    Q_INVOKABLE int getStepLatencyMs(QString swapId);
+    // Average duration of the auto swap step for the trade in ms. -1 if trade isn't running or no steps was done yet
+    Q_INVOKABLE int getAvgStepLatencyMs(QString swapId);
+
     // Update communication method.
     // Respond will be at sgnAdjustSwapTrade(QString swapId, QString call_tag, QString errMsg)
     Q_INVOKABLE void adjustSwapData( QString swapId, QString call_tag,
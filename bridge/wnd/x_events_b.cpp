@@ -50,9 +50,10 @@ void Events::eventsWndIsDeleted() {
     return getEvents()->eventsWndIsDeleted();
 }
 
-QVector<QString> Events::getWalletNotificationMessages() {
-    QVector<notify::NotificationMessage> messages = getEvents()->getWalletNotificationMessages();
+// Groups of 5: [time short, time long, level short, level full, message]
+static QVector<QString> messages2strings(const QVector<notify::NotificationMessage> & messages) {
     QVector<QString> res;
+    res.reserve(messages.size() * 5);
     for (auto & msg : messages) {
         res.push_back(msg.time.toString("HH:mm:ss"));
         res.push_back(msg.time.toString("MMM d, yyyy / H:mm:ss ap"));
@@ -63,7 +64,20 @@ QVector<QString> Events::getWalletNotificationMessages() {
     return res;
 }
 
+QVector<QString> Events::getWalletNotificationMessages() {
+    QVector<notify::NotificationMessage> messages = getEvents()->getWalletNotificationMessages();
+    if (!messages.isEmpty())
+        lastMessageSeq = messages.last().seq;
+    return messages2strings(messages);
+}
 
+// Request notification messages that arrived after the previous getWalletNotificationMessages
+// or getNewNotificationMessages call.
+QVector<QString> Events::getNewNotificationMessages() {
+    QVector<notify::NotificationMessage> messages = getEvents()->getWalletNotificationMessages(lastMessageSeq);
+    if (!messages.isEmpty())
+        lastMessageSeq = messages.last().seq;
+    return messages2strings(messages);
+}
 
-
-}
\ No newline at end of file
+}
@@ -43,10 +43,17 @@ public:
     // Return groups of 5: [time short, time long, level short, level full, message]
     Q_INVOKABLE QVector<QString> getWalletNotificationMessages();
 
+    // Request notification messages that arrived after the previous getWalletNotificationMessages
+    // or getNewNotificationMessages call. Same groups of 5 as getWalletNotificationMessages.
+    Q_INVOKABLE QVector<QString> getNewNotificationMessages();
+
 
 signals:
     void sgnUpdateShowMessages();
     void sgnUpdateNonShownWarnings(bool hasNonShownWarns);
+
+private:
+    int64_t lastMessageSeq = 0; // Sequence number of the last message that was returned
 };
 
 }
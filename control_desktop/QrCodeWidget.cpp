@@ -13,19 +13,14 @@
 // limitations under the License.
 
 #include "QrCodeWidget.h"
-#include "../bridge/util_b.h"
-#include "../util/QrCode.h"
+#include "../util/qrimage.h"
 
 #include <QPainter>
 #include <QPaintEvent>
-#include <QSvgRenderer>
-
-using namespace qrcodegen;
 
 namespace control {
 
 QrCodeWidget::QrCodeWidget(QWidget *parent) : QWidget(parent) {
-    util = new bridge::Util(this);
     show();
 }
 
@@ -41,8 +36,13 @@ void QrCodeWidget::paintEvent(QPaintEvent *event) {
 
     painter.fillRect(0,0,w,h, QColor(255,255,255,255));
 
-    QSvgRenderer renderer( svgPath.toUtf8(), this );
-    renderer.render(&painter, QRectF(0.0, 0.0, qreal(w) , qreal(h)) );
+    // Image is cached, paint and resize to the same size are not rendering it again.
+    // It is rendered in device pixels, so it stays sharp at high DPI screens.
+    if (qrSize>0) {
+        const qreal dpr = devicePixelRatioF();
+        QSize imageSize( qRound(w * dpr), qRound(h * dpr) );
+        painter.drawImage(QRect(0, 0, w, h), util::getQrCodeImage(encodedData, imageSize));
+    }
 }
 
 void QrCodeWidget::setContent(QString text) {
@@ -50,12 +50,9 @@ void QrCodeWidget::setContent(QString text) {
         return;
 
     encodedData = text;
-    QVector<QString> res = util->generateQrCode(text);
-    Q_ASSERT(res.size()==2);
-    qrSize = res[0].toInt();
+    qrSize = util::getQrCodeSize(text);
     Q_ASSERT(qrSize>0);
-    svgPath = res[1];
-    QWidget::repaint();
+    QWidget::update();
 }
 
 // Generate the image only.
@@ -69,17 +66,7 @@ QImage QrCodeWidget::generateQrImage() {
     while (qrSize * k < 300 )
         k++;
 
-    // Prepare a QImage with desired characteritisc
-    QImage image(qrSize * k, qrSize * k, QImage::Format_ARGB32);
-    image.fill(0x00000000); // Transparent background
-
-    QSvgRenderer renderer( svgPath.toUtf8(), this );
-
-    // Get QPainter that paints to the image
-    QPainter painter(&image);
-    renderer.render(&painter);
-
-    return image;
+    return util::getQrCodeImage(encodedData, QSize(qrSize * k, qrSize * k));
 }
 
 QString QrCodeWidget::generateQrImage(QString fileName) {
@@ -21,10 +21,6 @@
 
 class QPaintEvent;
 
-namespace bridge {
-class Util;
-}
-
 namespace control {
 
 class QrCodeWidget : public QWidget {
@@ -45,10 +41,8 @@ protected:
     void paintEvent(QPaintEvent *event);
 
 private:
-    bridge::Util * util;
     QString encodedData;
     int     qrSize = 0;
-    QString svgPath;
 };
 
 }
@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include "richitem.h"
-#include "richvbox.h"
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QKeyEvent>
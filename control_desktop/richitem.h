@@ -20,7 +20,18 @@
 
 namespace control {
 
-class RichVBox;
+class RichItem;
+
+// Receiver of the RichItem events. Implemented by the lists that holds the items: RichVBox, RichListView
+class RichItemEventsHandler {
+public:
+    virtual ~RichItemEventsHandler() {}
+
+    virtual void itemClicked(QString id, RichItem * item) = 0;
+    virtual void itemDblClicked(QString id, RichItem * item) = 0;
+    virtual void itemFocus(QString id, RichItem * item) = 0;
+    virtual void itemActivated(QString id, RichItem * item) = 0;
+};
 
 inline QString LEFT_MARK_ON(QString color) {
     if (color.isEmpty())
@@ -76,7 +87,8 @@ public:
     RichItem & apply(); // last step, first item form activeLayoutStack will be applyed
 
     ///////////////////////////////
-    void setParent(RichVBox * p) {eventsHandler=p;}
+    void setParent(RichItemEventsHandler * p) {eventsHandler=p;}
+    const QString & getId() const {return id;}
 
     void setFocusState(bool focus);
 signals:
@@ -91,7 +103,7 @@ private:
     QVector< QLayout * > layoutStack;
     QWidget * curWidget = nullptr;
 
-    RichVBox * eventsHandler;
+    RichItemEventsHandler * eventsHandler = nullptr;
 };
 
 // Helpers, Control builder
@@ -0,0 +1,362 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "richlistview.h"
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QStyledItemDelegate>
+#include <QScrollBar>
+#include <QTimer>
+#include <algorithm>
+
+namespace control {
+
+// Spacing between the items, the same as RichVBox has
+const int ITEM_SPACING = VBOX_SPACING;
+// Space on the right because of the scroll bar, the same as RichVBox has
+const int SCROLL_BAR_SPACING = 3;
+// Rows height until the first item is measured
+const int INITIAL_ROW_HEIGHT = 100;
+
+// Rows of the list. The data lives in the window, the model knows only the number of rows.
+class RichListModel : public QAbstractListModel {
+public:
+    explicit RichListModel(QObject * parent) : QAbstractListModel(parent) {}
+
+    void setRowCount(int rows) {
+        beginResetModel();
+        rowCnt = rows;
+        endResetModel();
+    }
+    int getRowCount() const {return rowCnt;}
+
+    virtual int rowCount(const QModelIndex & parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : rowCnt;
+    }
+    virtual QVariant data(const QModelIndex & index, int role) const override {
+        Q_UNUSED(index)
+        Q_UNUSED(role)
+        return QVariant(); // Items are widgets, nothing to show for the view
+    }
+private:
+    int rowCnt = 0;
+};
+
+// Sorting and filtering are asking the factory directly, so there are no QVariant conversions for the large lists
+class RichListProxyModel : public QSortFilterProxyModel {
+public:
+    explicit RichListProxyModel(QObject * parent) : QSortFilterProxyModel(parent) {}
+
+    void setFactory(RichListItemFactory * f) {
+        factory = f;
+        invalidate();
+    }
+
+    void setFilterText(const QString & text) {
+        if (filterText == text)
+            return;
+        filterText = text;
+        invalidateFilter();
+    }
+
+protected:
+    virtual bool filterAcceptsRow(int sourceRow, const QModelIndex & sourceParent) const override {
+        Q_UNUSED(sourceParent)
+        if (filterText.isEmpty() || factory == nullptr)
+            return true;
+        return factory->getRichItemFilterText(sourceRow).contains(filterText, Qt::CaseInsensitive);
+    }
+
+    virtual bool lessThan(const QModelIndex & sourceLeft, const QModelIndex & sourceRight) const override {
+        if (factory == nullptr)
+            return sourceLeft.row() < sourceRight.row();
+        return factory->isRichItemLess(sourceLeft.row(), sourceRight.row());
+    }
+
+private:
+    RichListItemFactory * factory = nullptr;
+    QString filterText;
+};
+
+// Rows are covered by the items, delegate only provides the size
+class RichListDelegate : public QStyledItemDelegate {
+public:
+    explicit RichListDelegate(RichListView * _view) : QStyledItemDelegate(_view), view(_view) {}
+
+    virtual void paint(QPainter * painter, const QStyleOptionViewItem & option, const QModelIndex & index) const override {
+        Q_UNUSED(painter)
+        Q_UNUSED(option)
+        Q_UNUSED(index)
+    }
+
+    virtual QSize sizeHint(const QStyleOptionViewItem & option, const QModelIndex & index) const override {
+        Q_UNUSED(option)
+        return QSize(std::max(1, view->getItemsWidth()), view->getRowHeight(index));
+    }
+private:
+    RichListView * view;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+RichListView::RichListView(QWidget *parent) : QListView(parent)
+{
+    setSizePolicy( QSizePolicy::Preferred, QSizePolicy::Preferred );
+
+    setStyleSheet( "border: 1px solid rgba(255, 255, 255, 0.2); background: transparent" );
+    viewport()->setStyleSheet( "border: transparent; padding: 0px" );
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+
+    // Items has different heights, scrolling by pixels is expected
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setUniformItemSizes(false);
+
+    model = new RichListModel(this);
+    proxy = new RichListProxyModel(this);
+    proxy->setSourceModel(model);
+    proxy->setDynamicSortFilter(true);
+    proxy->sort(0, Qt::AscendingOrder);
+
+    setItemDelegate(new RichListDelegate(this));
+    setModel(proxy);
+
+    QObject::connect( proxy, &QAbstractItemModel::modelReset, this, &RichListView::onModelReset);
+    QObject::connect( proxy, &QAbstractItemModel::layoutChanged, this, &RichListView::onRowsChanged);
+    QObject::connect( proxy, &QAbstractItemModel::rowsInserted, this, &RichListView::onRowsChanged);
+    QObject::connect( proxy, &QAbstractItemModel::rowsRemoved, this, &RichListView::onRowsChanged);
+
+    Q_ASSERT(verticalScrollBar() != nullptr);
+    QObject::connect( verticalScrollBar(), &QAbstractSlider::valueChanged,
+                     this, &RichListView::onVertValueChanged);
+    QObject::connect( verticalScrollBar(), &QAbstractSlider::rangeChanged,
+                     this, &RichListView::onVertRangeChanged);
+}
+
+RichListView::~RichListView() {}
+
+void RichListView::setItemFactory(RichListItemFactory * _factory) {
+    factory = _factory;
+    proxy->setFactory(factory);
+    onModelReset();
+}
+
+void RichListView::setRowCount(int rowCount, bool resetScrollValue) {
+    if (resetScrollValue) {
+        scrollValue = 0;
+        needSetValue = false;
+    }
+    else {
+        needSetValue = true;
+    }
+
+    model->setRowCount(rowCount);
+
+    if (resetScrollValue)
+        verticalScrollBar()->setValue(0);
+}
+
+int RichListView::getRowCount() const {
+    return model->getRowCount();
+}
+
+int RichListView::getShownRowCount() const {
+    return proxy->rowCount();
+}
+
+void RichListView::setSortOrder(Qt::SortOrder order) {
+    proxy->sort(0, order);
+}
+
+void RichListView::setFilterText(const QString & text) {
+    proxy->setFilterText(text);
+}
+
+void RichListView::refreshRow(int row) {
+    RichItem * item = items.take(row);
+    if (item != nullptr) {
+        deleteItem(item);
+        scheduleItemsUpdate();
+    }
+}
+
+int RichListView::getRowHeight(const QModelIndex & index) const {
+    const int defHeight = defaultRowHeight > 0 ? defaultRowHeight : INITIAL_ROW_HEIGHT;
+    if (rowHeights.isEmpty())
+        return defHeight;
+    return rowHeights.value(proxy->mapToSource(index).row(), defHeight);
+}
+
+void RichListView::itemClicked(QString id, RichItem * item) {
+    Q_UNUSED(item);
+    emit onItemClicked(id);
+}
+void RichListView::itemDblClicked(QString id, RichItem * item) {
+    Q_UNUSED(item);
+    emit onItemDblClicked(id);
+}
+void RichListView::itemFocus(QString id, RichItem * item) {
+    if (focusItem != item ) {
+        if (focusItem != nullptr) {
+            focusItem->setFocusState(false);
+        }
+        focusItem = item;
+        focusItem->setFocusState(true);
+    }
+    focusId = id;
+
+    emit onItemFocus(id);
+}
+void RichListView::itemActivated(QString id, RichItem * item) {
+    Q_UNUSED(item);
+    emit onItemActivated(id);
+}
+
+void RichListView::scrollContentsBy(int dx, int dy) {
+    QListView::scrollContentsBy(dx, dy);
+    // Building right away, otherwise the new rows will be empty for a moment
+    updateItems();
+}
+
+void RichListView::resizeEvent(QResizeEvent * event) {
+    QListView::resizeEvent(event);
+    scheduleItemsUpdate();
+}
+
+void RichListView::updateGeometries() {
+    QListView::updateGeometries();
+    scheduleItemsUpdate();
+}
+
+void RichListView::onModelReset() {
+    // Rows are different now
+    deleteAllItems();
+    rowHeights.clear();
+    scheduleItemsUpdate();
+}
+
+void RichListView::onRowsChanged() {
+    // Items are keyed by the data row, sorting or filtering only moves them
+    scheduleItemsUpdate();
+}
+
+void RichListView::scheduleItemsUpdate() {
+    if (itemsUpdateScheduled)
+        return;
+    itemsUpdateScheduled = true;
+    QTimer::singleShot(0, this, [this]() {
+        updateItems();
+    });
+}
+
+void RichListView::updateItems() {
+    itemsUpdateScheduled = false;
+    if (factory == nullptr)
+        return;
+
+    const int width = std::max(1, viewport()->width() - SCROLL_BAR_SPACING);
+    if (width != itemsWidth) {
+        // Word wrapped labels have different height now
+        itemsWidth = width;
+        rowHeights.clear();
+    }
+
+    const int viewHeight = viewport()->height();
+    const int rowCount = proxy->rowCount();
+    QHash<int, RichItem *> visibleItems;
+    bool heightsChanged = false;
+
+    const QModelIndex topIndex = indexAt(QPoint(0, 0));
+    for (int r = topIndex.isValid() ? topIndex.row() : rowCount; r < rowCount; r++) {
+        const QModelIndex index = proxy->index(r, 0);
+        const QRect rect = visualRect(index);
+        if (rect.top() >= viewHeight)
+            break;
+
+        const int row = proxy->mapToSource(index).row();
+        RichItem * item = items.take(row);
+        if (item == nullptr) {
+            item = factory->createRichItem(row, viewport());
+            Q_ASSERT(item != nullptr);
+            item->setParent(this);
+            if (!focusId.isEmpty() && item->getId() == focusId) {
+                focusItem = item;
+                item->setFocusState(true);
+            }
+            // Style sheets define the fonts, the item must be polished before the measurement
+            item->ensurePolished();
+            item->show();
+        }
+        visibleItems.insert(row, item);
+
+        const int height = item->hasHeightForWidth() ? item->heightForWidth(itemsWidth) : item->sizeHint().height();
+        if (defaultRowHeight == 0)
+            defaultRowHeight = height + ITEM_SPACING;
+        if (getRowHeight(index) != height + ITEM_SPACING)
+            heightsChanged = true;
+        rowHeights.insert(row, height + ITEM_SPACING);
+
+        item->setGeometry(0, rect.top(), itemsWidth, height);
+    }
+
+    // The rest of the items are out of the view
+    for (RichItem * item : items)
+        deleteItem(item);
+    items = visibleItems;
+
+    if (heightsChanged)
+        scheduleDelayedItemsLayout(); // will call updateGeometries, the items will be moved
+}
+
+void RichListView::deleteItem(RichItem * item) {
+    if (item == focusItem)
+        focusItem = nullptr;
+    item->hide();
+    // Item might be in the middle of the event processing, the button callback can refresh the row
+    item->deleteLater();
+}
+
+void RichListView::deleteAllItems() {
+    for (RichItem * item : items)
+        deleteItem(item);
+    items.clear();
+    focusId = "";
+}
+
+void RichListView::onVertValueChanged(int value) {
+    if (value == 0) {
+        QScrollBar * sb = verticalScrollBar();
+        if (sb != nullptr) {
+            int minV = sb->minimum();
+            int maxV = sb->maximum();
+            if (minV>=0 && minV<maxV)
+                scrollValue = value;
+        }
+    }
+    else {
+        scrollValue = value;
+    }
+}
+
+void RichListView::onVertRangeChanged(int min, int max) {
+    if (needSetValue && min>=0 && min<max) {
+        needSetValue = false;
+        if (scrollValue<=max)
+            verticalScrollBar()->setValue(scrollValue);
+    }
+}
+
+}
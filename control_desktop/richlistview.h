@@ -0,0 +1,121 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RICHLISTVIEW_H
+#define RICHLISTVIEW_H
+
+#include <QListView>
+#include <QHash>
+#include "richitem.h"
+
+namespace control {
+
+class RichListModel;
+class RichListProxyModel;
+
+// Builder for the RichListView rows. Rows are indexes in the window data: 0..rowCount-1
+class RichListItemFactory {
+public:
+    virtual ~RichListItemFactory() {}
+
+    // Build the item for the row. Item id must be the row number.
+    virtual RichItem * createRichItem(int row, QWidget * parent) = 0;
+    // Text that the filter is applied to. Called only when the filter is set.
+    virtual QString getRichItemFilterText(int row) {Q_UNUSED(row); return "";}
+    // Sorting order of the rows. Default order is the data order
+    virtual bool isRichItemLess(int row1, int row2) {return row1 < row2;}
+};
+
+// The list of the rich items for the large data sets. Rows live in the model, sorting and filtering
+// are done by the proxy model. RichItem widgets are built only for the visible rows and deleted when row
+// goes out of the view, so the number of rows doesn't matter.
+// Items height is measured when item is built, rows that were never shown are expected to have the same height
+// as the first measured one.
+class RichListView : public QListView, public RichItemEventsHandler
+{
+    Q_OBJECT
+public:
+    explicit RichListView(QWidget *parent);
+    virtual ~RichListView() override;
+
+    void setItemFactory(RichListItemFactory * factory);
+
+    // Data was changed, all rows will be rebuilt
+    void setRowCount(int rowCount, bool resetScrollValue);
+    int getRowCount() const;
+    // Number of the rows that pass the filter
+    int getShownRowCount() const;
+
+    // Sorting by RichListItemFactory::isRichItemLess
+    void setSortOrder(Qt::SortOrder order);
+    // Show only rows with filter text that contains the text. Empty text - show all rows.
+    void setFilterText(const QString & text);
+
+    // Row data was changed, the item will be rebuilt if it is visible
+    void refreshRow(int row);
+
+    virtual void itemClicked(QString id, RichItem * item) override;
+    virtual void itemDblClicked(QString id, RichItem * item) override;
+    virtual void itemFocus(QString id, RichItem * item) override;
+    virtual void itemActivated(QString id, RichItem * item) override;
+
+    // Used by the delegate. index - view model index
+    int getRowHeight(const QModelIndex & index) const;
+    int getItemsWidth() const {return itemsWidth;}
+
+protected:
+    virtual void scrollContentsBy(int dx, int dy) override;
+    virtual void resizeEvent(QResizeEvent * event) override;
+    virtual void updateGeometries() override;
+
+private
+slots:
+    void onModelReset();
+    void onRowsChanged();
+    void onVertValueChanged(int value);
+    void onVertRangeChanged(int min, int max);
+
+signals:
+    void onItemClicked(QString id);
+    void onItemDblClicked(QString id);
+    void onItemFocus(QString id);
+    void onItemActivated(QString id);
+
+private:
+    void scheduleItemsUpdate();
+    void updateItems();
+    void deleteItem(RichItem * item);
+    void deleteAllItems();
+
+private:
+    RichListItemFactory * factory = nullptr;
+    RichListModel * model = nullptr;
+    RichListProxyModel * proxy = nullptr;
+
+    QHash<int, RichItem *> items; // key: row. Built items for the visible rows
+    QHash<int, int> rowHeights;    // key: row. Measured heights, including the spacing
+    int defaultRowHeight = 0;      // Height of the rows that was never shown
+    int itemsWidth = 0;            // Width that heights are measured for
+
+    QString focusId;
+    RichItem * focusItem = nullptr;
+    bool itemsUpdateScheduled = false;
+
+    int scrollValue = 0;
+    bool needSetValue = false;
+};
+
+}
+
+#endif // RICHLISTVIEW_H
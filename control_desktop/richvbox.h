@@ -22,7 +22,7 @@ class QVBoxLayout;
 
 namespace control {
 
-class RichVBox : public QScrollArea
+class RichVBox : public QScrollArea, public RichItemEventsHandler
 {
     Q_OBJECT
 public:
@@ -35,10 +35,10 @@ public:
     // Done with adding
     RichVBox & apply();
 
-    void itemClicked(QString id, RichItem * item);
-    void itemDblClicked(QString id, RichItem * item);
-    void itemFocus(QString id, RichItem * item);
-    void itemActivated(QString id, RichItem * item);
+    virtual void itemClicked(QString id, RichItem * item) override;
+    virtual void itemDblClicked(QString id, RichItem * item) override;
+    virtual void itemFocus(QString id, RichItem * item) override;
+    virtual void itemActivated(QString id, RichItem * item) override;
 
 private
 slots:
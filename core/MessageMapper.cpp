@@ -14,6 +14,8 @@
 
 #include "MessageMapper.h"
 #include "../util/Files.h"
+#include <QDebug>
+#include <algorithm>
 
 namespace test {
 void testMessageMapper() {
@@ -22,41 +24,55 @@ void testMessageMapper() {
     Q_ASSERT( mapper.processMessage("Some normal message") == "Some normal message");
     Q_ASSERT(mapper.processMessage("Swap Error , Electrum Node error, Unable to contact the secondary ElectrumX client btc.test2.swap.mwc.mw:8000, Swap Rpc error: Unable connect to btc.test2.swap.mwc.mw:8000, Swap I/O: Connection refused (os error 61)") ==
                 "The secondary ElectrumX client is not accessible. Unable connect to btc.test2.swap.mwc.mw:8000, Connection refused (os error 61)");
+    // First mapper in the config order wins, even if another one match earlier in the string
+    Q_ASSERT(mapper.processMessage("LibWallet Error, Swap Error , Electrum Node error, Unable to contact the secondary ElectrumX client host:8000, Swap Rpc error: Unable connect, Swap I/O: Connection refused") ==
+                "The secondary ElectrumX client is not accessible. Unable connect, Connection refused");
+    Q_ASSERT(mapper.processMessage("LibWallet Error, Swap Error , Electrum Node error, Unable to determine height") ==
+                "ElectrumX server error: Unable to determine height");
+    Q_ASSERT(mapper.processMessage("Error: LibWallet Error, Slatepack decode error, Bad armor header") ==
+                "Unable to recognize slatepack content in the string.");
+    Q_ASSERT(mapper.processMessage("LibWallet Error, Slatepack decode error, Something   else") ==
+                "Unable to decode the slatepack, Something else");
+    // Captured text is not a template
+    Q_ASSERT(mapper.processMessage("LibWallet Error, Unable to export trade data, Swap I/O: $1 $2") == "$1 $2");
+
+    // Combined parser must give the same results as the parsers one by one, the way it is defined by config.
+    QVector<QPair<QRegularExpression, QString>> reference;
+    QStringList lns = util::readTextFile( ":/resource/mwc713_mappers.txt", true, false);
+    for (int q=0; q<lns.size()-1; q++ ) {
+        if (lns[q].isEmpty() || lns[q].startsWith('#'))
+            continue;
+        reference.push_back( QPair<QRegularExpression, QString>(QRegularExpression(lns[q]), lns[q+1]) );
+        q++;
+    }
+
+    // Config comments have the samples of the real messages
+    QStringList messages;
+    for (const auto & l : lns) {
+        if (l.startsWith("# ") && l.contains("Error"))
+            messages.push_back(l.mid(2).simplified());
+    }
+    messages.push_back("Tx Pool Duplicate tx");
+    Q_ASSERT(messages.size() > 10);
+
+    for (const auto & msg : messages) {
+        QString expected = msg;
+        for (const auto & r : reference) {
+            QRegularExpressionMatch match = r.first.match(msg);
+            if (!match.hasMatch())
+                continue;
+            expected = r.second;
+            for (int grIdx=9; grIdx>0; grIdx--)
+                expected.replace("$" + QString::number(grIdx), match.captured(grIdx));
+            break;
+        }
+        Q_ASSERT(mapper.processMessage(msg) == expected);
+    }
 }
 }
 
 namespace notify {
 
-void Mapper::init(const QString & regexPattern, const QString & _mapper ) {
-    parser.setPattern(regexPattern);
-    mapper = _mapper;
-}
-
-// Parse and return string if pattern match. Otherwise return the empty value
-QString Mapper::process(const QString & str) const {
-     QRegularExpressionMatch match = parser.match(str);
-     if (!match.hasMatch())
-         return "";
-
-     QString resStr = mapper;
-     // Substitute groups until we don't have 2 in the row
-
-     int notFound = 0;
-     for (int grIdx=1; grIdx<100 && notFound<2; grIdx++) {
-         QString groupPattern = "$" + QString::number(grIdx);
-         int idx = resStr.indexOf(groupPattern);
-         if (idx<0) {
-             notFound++;
-             continue;
-         }
-
-         notFound=0;
-         resStr.replace(groupPattern, match.captured(grIdx));
-     }
-
-     return resStr;
-}
-
 MessageMapper::MessageMapper(const QString & fileName) {
     readMappingConfig(fileName);
 }
@@ -66,12 +82,30 @@ MessageMapper::~MessageMapper() {
 
 QString MessageMapper::processMessage(QString message) const {
     message = message.simplified();
-    for (const auto & m : mappers) {
-        QString res = m.process(message);
-        if (!res.isEmpty())
-            return res;
+    if (mappers.isEmpty())
+        return message;
+
+    QRegularExpressionMatch match = parser.match(message);
+    if (!match.hasMatch())
+        return message;
+
+    // Groups of other alternatives are not captured, so the last captured one belongs to the matched mapper
+    auto m = std::upper_bound(mappers.begin(), mappers.end(), match.lastCapturedIndex(),
+                              [](int group, const Mapper & mpr) {return group < mpr.matchGroup;});
+    Q_ASSERT(m != mappers.begin());
+    m--;
+
+    QString res;
+    for (const auto & s : m->segments) {
+        if (s.group < 0)
+            res.append(s.literal);
+        else
+            res.append(match.capturedRef(s.group));
     }
-    return message;
+
+    if (res.isEmpty())
+        return message;
+    return res;
 }
 
 // Reading config with regular expressions.
@@ -80,6 +114,9 @@ void MessageMapper::readMappingConfig(const QString & configFileName) {
 
     Q_ASSERT(!lns.isEmpty());
 
+    QString pattern;
+    int groupNum = 0;
+
     for (int q=0; q<lns.size()-1; q++ ) {
         const QString & l = lns[q];
         if (l.isEmpty() || l.startsWith('#'))
@@ -91,10 +128,57 @@ void MessageMapper::readMappingConfig(const QString & configFileName) {
         const QString & mapperLine = lns[q];
         Q_ASSERT( !mapperLine.isEmpty() && !mapperLine.startsWith('#') );
 
+        // Invalid regex never match. We don't want it to break the combined parser.
+        QRegularExpression regex(l);
+        if (!regex.isValid()) {
+            qDebug() << "MessageMapper: skipping invalid regex at " << configFileName << ": " << l << ", " << regex.errorString();
+            continue;
+        }
+
         Mapper mpr;
-        mpr.init(l, mapperLine);
+        mpr.matchGroup = ++groupNum;
+        const int captureCount = regex.captureCount();
+        groupNum += captureCount;
+
+        // Template: literals and $1..$9 groups
+        Segment literal;
+        for (int i=0; i<mapperLine.size(); i++) {
+            const QChar ch = mapperLine[i];
+            if (ch == '$' && i+1 < mapperLine.size() && mapperLine[i+1] >= '1' && mapperLine[i+1] <= '9') {
+                const int grIdx = mapperLine[++i].digitValue();
+                if (!literal.literal.isEmpty()) {
+                    mpr.segments.push_back(literal);
+                    literal.literal.clear();
+                }
+                // Group that doesn't exist is empty
+                if (grIdx <= captureCount) {
+                    Segment group;
+                    group.group = mpr.matchGroup + grIdx;
+                    mpr.segments.push_back(group);
+                }
+                continue;
+            }
+            literal.literal.append(ch);
+        }
+        if (!literal.literal.isEmpty())
+            mpr.segments.push_back(literal);
+
         mappers.push_back(mpr);
+
+        // Leading lazy '.*?' makes every alternative to find its leftmost match before the next one is tried,
+        // so the first mapper in the config order wins, same as applying them one by one.
+        if (!pattern.isEmpty())
+            pattern += '|';
+        pattern += "(.*?(?:" + l + "))";
     }
+
+    if (mappers.isEmpty())
+        return;
+
+    parser.setPattern("^(?:" + pattern + ")");
+    parser.optimize();
+    Q_ASSERT(parser.isValid());
+    Q_ASSERT(parser.captureCount() == groupNum);
 }
 
 }
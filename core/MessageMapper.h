@@ -24,20 +24,10 @@ namespace notify {
 // Message mapper needed for notificaitons mapping. We want to handle messages like this:
 // Swap Error , Electrum Node error, Unable to contact the secondary ElectrumX client btc.test2.swap.mwc.mw:8000, Swap Rpc error: Unable connect to btc.test2.swap.mwc.mw:8000, Swap I/O: Connection refused (os error 61)
 //
-// Mapper is providing bunch of regex parsers that will be apply to every income messge.
-// Note!!!  Parsers are applied one by one, so performance is limited. For notifications it is good enough.
-//          But if you want to handle high traffic, please concider to use one parser for all.
+// All regex parsers from the config are compiled into a single expression, so every income message is parsed once.
+// Parsers are the alternatives of that expression, in the config order, every one is wrapped into the group.
+// The captured group tells which mapper template to apply. Templates are pre-split into literal and group segments.
 // Note!!!  This mapper has tests, maintain it for every new mapper!!!!
-struct Mapper {
-    QRegularExpression parser;
-    QString mapper;
-
-    void init(const QString & regexPattern, const QString & mapper );
-
-    // Parse and return string if pattern match. Otherwise return the empty value
-    QString process(const QString & str) const;
-};
-
 class MessageMapper {
 public:
     MessageMapper(const QString & configFileName);
@@ -50,7 +40,18 @@ private:
     void readMappingConfig(const QString & fileName);
 
 private:
-    QVector<Mapper> mappers;
+    struct Segment {
+        QString literal;
+        int group = -1; // Group of the combined parser. -1 for the literal
+    };
+
+    struct Mapper {
+        int matchGroup = 0; // Group of the combined parser that wraps this mapper regex
+        QVector<Segment> segments;
+    };
+
+    QRegularExpression parser;
+    QVector<Mapper> mappers; // Sorted by matchGroup
 };
 
 }
@@ -18,6 +18,8 @@
 #include "../util/Log.h"
 #include <QSet>
 #include <QVector>
+#include <QMutex>
+#include <algorithm>
 #include "WndManager.h"
 #include "MessageMapper.h"
 #include "../bridge/notification_b.h"
@@ -49,7 +51,14 @@ void remeoveFalseMessage(const QString & msg) {
 }
 
 const int MESSAGE_SIZE_LIMIT = 1000;
-static QVector<NotificationMessage> notificationMessages;
+const int MESSAGE_LEVELS = int(bridge::MESSAGE_LEVEL::DEBUG) + 1;
+
+// Ring of the last MESSAGE_SIZE_LIMIT messages. Message with sequence number S is at (S-1) % MESSAGE_SIZE_LIMIT.
+// Messages can be appended and read from any thread.
+static QMutex notificationMutex;
+static QVector<NotificationMessage> notificationMessages(MESSAGE_SIZE_LIMIT);
+static int64_t lastNotificationSeq = 0;
+static int64_t lastLevelSeq[MESSAGE_LEVELS] = {0}; // Last message sequence number per level
 
 // Enum to string
 QString toString(bridge::MESSAGE_LEVEL level) {
@@ -118,10 +127,35 @@ void Notification::sendNewNotificationMessage(bridge::MESSAGE_LEVEL level, QStri
 }
 
 
-// Get all notification messages
+// Get notification messages with sequence number larger than sinceSeq. sinceSeq=0 - all stored messages.
 // Check signal: Notification::onNewNotificationMessage
-QVector<NotificationMessage> getNotificationMessages() {
-    return notificationMessages;
+QVector<NotificationMessage> getNotificationMessages(int64_t sinceSeq) {
+    QMutexLocker l(&notificationMutex);
+
+    int64_t firstSeq = std::max( sinceSeq, lastNotificationSeq - MESSAGE_SIZE_LIMIT ) + 1;
+    QVector<NotificationMessage> res;
+    if (firstSeq > lastNotificationSeq)
+        return res;
+
+    res.reserve( int(lastNotificationSeq - firstSeq + 1) );
+    for (int64_t seq = firstSeq; seq <= lastNotificationSeq; seq++)
+        res.push_back( notificationMessages[int((seq-1) % MESSAGE_SIZE_LIMIT)] );
+    return res;
+}
+
+// Sequence number of the last stored message. 0 if there are no messages.
+int64_t getLastNotificationSeq() {
+    QMutexLocker l(&notificationMutex);
+    return lastNotificationSeq;
+}
+
+// Sequence number of the last stored message with the level 'level' or more severe. 0 if there are no such messages.
+int64_t getLastNotificationSeq(bridge::MESSAGE_LEVEL level) {
+    QMutexLocker l(&notificationMutex);
+    int64_t res = 0;
+    for (int lv = int(bridge::MESSAGE_LEVEL::FATAL_ERROR); lv <= int(level); lv++)
+        res = std::max(res, lastLevelSeq[lv]);
+    return res;
 }
 
 // Generic. Reporting fatal error that somebody will process and exit app
@@ -161,12 +195,14 @@ void appendNotificationMessage( bridge::MESSAGE_LEVEL level, QString message ) {
 
     NotificationMessage msg(level, message);
 
-    // check if it is duplicate message. Duplicates will be ignored.
-    if (! ( notificationMessages.size()>0 && notificationMessages.last().message == message ) ) {
-        notificationMessages.push_back(msg);
-
-        while (notificationMessages.size() > MESSAGE_SIZE_LIMIT)
-            notificationMessages.pop_front();
+    {
+        QMutexLocker l(&notificationMutex);
+        // check if it is duplicate message. Duplicates will be ignored.
+        if (! ( lastNotificationSeq>0 && notificationMessages[int((lastNotificationSeq-1) % MESSAGE_SIZE_LIMIT)].message == message ) ) {
+            msg.seq = ++lastNotificationSeq;
+            notificationMessages[int((msg.seq-1) % MESSAGE_SIZE_LIMIT)] = msg;
+            lastLevelSeq[int(msg.level)] = msg.seq;
+        }
     }
 
     logger::logEmit( "MWC713", "onNewNotificationMessage", msg.toString() );
@@ -38,6 +38,7 @@ struct NotificationMessage {
     bridge::MESSAGE_LEVEL level = bridge::MESSAGE_LEVEL::DEBUG;
     QString message;
     QDateTime time;
+    int64_t seq = 0; // Sequence number, assigned when message is stored. First message has 1.
 
     NotificationMessage() {time=QDateTime::currentDateTime();}
     NotificationMessage(bridge::MESSAGE_LEVEL _level, QString _message) : level(_level), message(_message) { time = QDateTime::currentDateTime(); }
@@ -77,9 +78,15 @@ signals:
 // Generic. Reporting fatal error that somebody will process and exit app
 void reportFatalError( QString message );
 
-// Get all notification messages
+// Notification messages are stored at the fixed size ring, the oldest ones are dropped.
+// Get notification messages with sequence number larger than sinceSeq. sinceSeq=0 - all stored messages.
 // Check signal: Notification::onNewNotificationMessage
-QVector<NotificationMessage> getNotificationMessages();
+QVector<NotificationMessage> getNotificationMessages(int64_t sinceSeq = 0);
+
+// Sequence number of the last stored message. 0 if there are no messages.
+int64_t getLastNotificationSeq();
+// Sequence number of the last stored message with the level 'level' or more severe. 0 if there are no such messages.
+int64_t getLastNotificationSeq(bridge::MESSAGE_LEVEL level);
 
 
 void appendNotificationMessage( bridge::MESSAGE_LEVEL level, QString message );
@@ -0,0 +1,192 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "Scheduler.h"
+#include "../util/Log.h"
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QThread>
+#include <algorithm>
+
+namespace core {
+
+// Slack is a fraction of the job period, so rare polls can share the wakeup with the frequent ones
+const static int JOB_SLACK_DIVIDER = 10;
+const static int JOB_MAX_SLACK_MS = 5000;
+// How often the jobs run time is reported to the log
+const static int STATS_LOG_PERIOD_MS = 3600 * 1000;
+
+static int calcSlack(int periodMs) {
+    return std::min(periodMs / JOB_SLACK_DIVIDER, JOB_MAX_SLACK_MS);
+}
+
+Scheduler::Scheduler(QObject * parent) : QObject(parent) {
+    clock.start();
+
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::CoarseTimer);
+    connect(timer, &QTimer::timeout, this, &Scheduler::onTimer);
+
+    addPeriodicJob("SchedulerStats", STATS_LOG_PERIOD_MS, this, [this]() {logJobStats();});
+}
+
+Scheduler::~Scheduler() {}
+
+int Scheduler::addPeriodicJob(const QString & name, int periodMs, QObject * context, std::function<void()> job, bool active) {
+    Q_ASSERT(periodMs > 0);
+    Job j;
+    j.name = name;
+    j.context = context;
+    j.job = job;
+    j.periodMs = periodMs;
+    j.slackMs = calcSlack(periodMs);
+    j.nextRunMs = clock.elapsed() + periodMs;
+    j.active = active;
+    return addJob(j);
+}
+
+int Scheduler::addJob(Job job) {
+    Q_ASSERT(QThread::currentThread() == thread());
+    Q_ASSERT(job.context);
+
+    connect(job.context, &QObject::destroyed, this, &Scheduler::onContextDestroyed, Qt::UniqueConnection);
+
+    SchedulerJobStats & st = stats[job.name];
+    st.name = job.name;
+    st.periodMs = job.periodMs;
+
+    const int jobId = nextJobId++;
+    jobs.insert(jobId, job);
+    rearmTimer();
+    return jobId;
+}
+
+void Scheduler::setJobActive(int jobId, bool active) {
+    auto j = jobs.find(jobId);
+    if (j == jobs.end() || j->active == active)
+        return;
+
+    j->active = active;
+    if (active)
+        j->nextRunMs = std::max(j->nextRunMs, clock.elapsed());
+    rearmTimer();
+}
+
+QVector<SchedulerJobStats> Scheduler::getJobStats() const {
+    QVector<SchedulerJobStats> res;
+    for (auto st : stats) {
+        st.active = false;
+        for (const auto & j : jobs) {
+            if (j.name == st.name && j.active) {
+                st.active = true;
+                break;
+            }
+        }
+        res.push_back(st);
+    }
+    return res;
+}
+
+void Scheduler::onTimer() {
+    armedTimeMs = -1;
+    const int64_t now = clock.elapsed();
+
+    QVector<int> dueJobs;
+    for (auto j = jobs.constBegin(); j != jobs.constEnd(); j++) {
+        if (j->active && !j->running && j->nextRunMs - j->slackMs <= now)
+            dueJobs.push_back(j.key());
+    }
+
+    for (int jobId : dueJobs) {
+        // Previous jobs might remove or suspend this one. Or run it from the nested onTimer, if they
+        // were processing events.
+        auto j = jobs.find(jobId);
+        if (j == jobs.end() || !j->active || j->running || j->nextRunMs - j->slackMs > now)
+            continue;
+
+        const QString name = j->name;
+        std::function<void()> job = j->job;
+        j->nextRunMs = now + j->periodMs;
+        j->running = true;
+
+        // Job might show a modal dialog, other jobs must keep running from its event loop
+        rearmTimer();
+
+        QElapsedTimer runTime;
+        runTime.start();
+        job();
+        const int64_t runUs = runTime.nsecsElapsed() / 1000;
+
+        j = jobs.find(jobId);
+        if (j != jobs.end())
+            j->running = false;
+
+        SchedulerJobStats & st = stats[name];
+        st.runs++;
+        st.totalRunUs += runUs;
+        st.maxRunUs = std::max(st.maxRunUs, runUs);
+    }
+
+    rearmTimer();
+}
+
+void Scheduler::onContextDestroyed(QObject * context) {
+    for (auto j = jobs.begin(); j != jobs.end(); ) {
+        if (j->context == context)
+            j = jobs.erase(j);
+        else
+            j++;
+    }
+    rearmTimer();
+}
+
+void Scheduler::rearmTimer() {
+    int64_t nextRunMs = -1;
+    for (const auto & j : jobs) {
+        if (j.active && !j.running && (nextRunMs < 0 || j.nextRunMs < nextRunMs))
+            nextRunMs = j.nextRunMs;
+    }
+
+    if (nextRunMs == armedTimeMs)
+        return;
+
+    armedTimeMs = nextRunMs;
+    if (nextRunMs < 0) {
+        timer->stop();
+        return;
+    }
+    timer->start(int(std::max(int64_t(0), nextRunMs - clock.elapsed())));
+}
+
+void Scheduler::logJobStats() const {
+    for (const auto & st : getJobStats()) {
+        if (st.runs == 0)
+            continue;
+        logger::logInfo("Scheduler", st.name + " runs: " + QString::number(st.runs) +
+                        " avg: " + QString::number(st.totalRunUs / st.runs) + "us" +
+                        " max: " + QString::number(st.maxRunUs) + "us");
+    }
+}
+
+Scheduler * getScheduler() {
+    static Scheduler * scheduler = nullptr;
+    if (scheduler == nullptr)
+        scheduler = new Scheduler(QCoreApplication::instance());
+    return scheduler;
+}
+
+}
@@ -0,0 +1,92 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MWC_QT_WALLET_SCHEDULER_H
+#define MWC_QT_WALLET_SCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <QElapsedTimer>
+#include <functional>
+
+class QTimer;
+
+namespace core {
+
+struct SchedulerJobStats {
+    QString name;
+    bool    active = false;
+    int     periodMs = 0;
+    int64_t runs = 0;
+    int64_t totalRunUs = 0;
+    int64_t maxRunUs = 0;
+};
+
+// Shared timer service for the polls. All jobs are running at the main thread,
+// one OS timer is armed for the nearest job. Jobs that are due within their slack are executed together,
+// so a bunch of periodic polls produce a single wakeup.
+// Job is removed automatically when its context object is destroyed.
+// Use getScheduler() to access singleton instance.
+class Scheduler : public QObject {
+    Q_OBJECT
+public:
+    Scheduler(QObject * parent = nullptr);
+    virtual ~Scheduler() override;
+
+    // Job is called every periodMs. Inactive job is suspended until it is activated.
+    // Return job id.
+    int addPeriodicJob(const QString & name, int periodMs, QObject * context, std::function<void()> job, bool active = true);
+    // Suspend/resume the job. Periodic job that missed its time while suspended is called at resume.
+    void setJobActive(int jobId, bool active);
+
+    // Run time statistic, per job name
+    QVector<SchedulerJobStats> getJobStats() const;
+
+private slots:
+    void onTimer();
+    void onContextDestroyed(QObject * context);
+
+private:
+    struct Job {
+        QString name;
+        QObject * context = nullptr;
+        std::function<void()> job;
+        int     periodMs = 0;
+        int     slackMs = 0;  // job can be called that earlier to share the wakeup with others
+        int64_t nextRunMs = 0; // clock time
+        bool    active = true;
+        bool    running = false; // job is never called recursively
+    };
+
+    int addJob(Job job);
+    void rearmTimer();
+    void logJobStats() const;
+
+private:
+    QMap<int, Job> jobs;
+    QMap<QString, SchedulerJobStats> stats; // key: job name
+    QTimer * timer = nullptr;
+    QElapsedTimer clock; // Monotonic, jobs don't stall if the wall clock goes back
+    int nextJobId = 1;
+    int64_t armedTimeMs = -1; // -1 - timer is not armed
+};
+
+Scheduler * getScheduler();
+
+}
+
+#endif //MWC_QT_WALLET_SCHEDULER_H
@@ -32,9 +32,40 @@
 
 namespace core {
 
+// Single file formats of the previous versions, only read for migration
 const static QString settingsFileName("context.dat");
 const static QString notesFileName("notes.dat");
 
+const static QString contextStoreFileName("context.jdb");
+const static QString notesStoreFileName("notes.jdb");
+
+// Record keys for the per item settings
+const static QString LOCKED_OUTPUT_PREFIX("lock_");
+const static QString SWAP_BACKUP_PREFIX("swapbk_");
+
+template <class T>
+static QByteArray toBytes(const T & val) {
+    QByteArray res;
+    QDataStream out(&res, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_7);
+    out << val;
+    return res;
+}
+
+// Read the value if the record exist. Otherwise val keeps the default.
+template <class T>
+static void readValue(const util::JournalStore & store, const QString & key, T & val) {
+    if (!store.contains(key))
+        return;
+
+    QDataStream in(store.value(key));
+    in.setVersion(QDataStream::Qt_5_7);
+    T v = val;
+    in >> v;
+    if (in.status() == QDataStream::Ok)
+        val = v;
+}
+
 
 void SendCoinsParams::saveData(QDataStream & out) const {
     out << int(0x348A4);
@@ -169,7 +200,58 @@ bool AppContext::loadDataImpl() {
         return false;
     }
 
-    QFile file(dataPath.second + "/" + settingsFileName);
+    const QString storePath = dataPath.second + "/" + contextStoreFileName;
+    const bool storeExist = QFile::exists(storePath);
+
+    bool res = true;
+    QString errorMessage;
+    if (!contextStore.open(storePath, errorMessage)) {
+        QMessageBox::critical(nullptr, "Error", "Unable to read gui-wallet settings, default values will be used.\n" + errorMessage);
+        res = false;
+        // Starting from the clean store, the broken one is overwritten
+        if (!contextStore.create(storePath, errorMessage))
+            qDebug() << "Unable to reset settings store: " << errorMessage;
+    }
+    else if (!storeExist) {
+        // First run or upgrade from the single file format. context.dat is kept for the older wallet versions.
+        res = loadLegacyData(dataPath.second);
+        if (res) {
+            storeData();
+            for (auto i = lockedOutputs.constBegin(); i != lockedOutputs.constEnd(); i++) {
+                if (i.value().isEmpty())
+                    contextStore.put(LOCKED_OUTPUT_PREFIX + i.key(), QByteArray());
+            }
+            for (auto i = swapTradesBackupStatus.constBegin(); i != swapTradesBackupStatus.constEnd(); i++)
+                contextStore.put(SWAP_BACKUP_PREFIX + i.key(), toBytes(i.value()));
+        }
+        if (!contextStore.compact(errorMessage))
+            qDebug() << "Unable to write settings store: " << errorMessage;
+    }
+    else {
+        loadStoreData();
+    }
+
+    if (activeWndState == state::STATE::RESYNC || activeWndState == state::STATE::MIGRATION ) {
+        // Invalid states, let's regirect to Node info
+        activeWndState = state::STATE::NODE_INFO;
+    }
+
+    // for the mobile wallet we always want to start from the home page.
+#ifdef WALLET_MOBILE
+    activeWndState = state::STATE::WALLET_HOME;
+#endif
+
+#ifdef Q_OS_WIN
+    // Disable in windows because notification bring the whole QT wallet on the top of other windows.
+    // Notications overlap other windows.
+    notificationWindowsEnabled = false;
+#endif
+
+    return res;
+}
+
+bool AppContext::loadLegacyData(const QString & contextDir) {
+    QFile file(contextDir + "/" + settingsFileName);
     if ( !file.open(QIODevice::ReadOnly) ) {
         // first run, no file exist
         return false;
@@ -192,16 +274,6 @@ bool AppContext::loadDataImpl() {
     in >> st;
     activeWndState = (state::STATE)st;
 
-    if (activeWndState == state::STATE::RESYNC || activeWndState == state::STATE::MIGRATION ) {
-        // Invalid states, let's regirect to Node info
-        activeWndState = state::STATE::NODE_INFO;
-    }
-
-    // for the mobile wallet we always want to start from the home page.
-#ifdef WALLET_MOBILE
-    activeWndState = state::STATE::WALLET_HOME;
-#endif
-
     in >> pathStates;
     in >> intVectorStates;
 
@@ -322,12 +394,6 @@ bool AppContext::loadDataImpl() {
         in >> notificationWindowsEnabled;
     }
 
-#ifdef Q_OS_WIN
-    // Disable in windows because notification bring the whole QT wallet on the top of other windows.
-    // Notications overlap other windows.
-    notificationWindowsEnabled = false;
-#endif
-
     if (id>=0x479C) {
         in >> swapTabSelection;
     }
@@ -386,134 +452,193 @@ bool AppContext::loadDataImpl() {
     return true;
 }
 
+void AppContext::loadStoreData() {
+    int st = int(activeWndState);
+    readValue(contextStore, "activeWndState", st);
+    activeWndState = (state::STATE)st;
 
-void AppContext::saveData() const {
-    QPair<bool,QString> dataPath = ioutils::getAppDataPath("context");
-    if (!dataPath.first) {
-        core::getWndManager()->messageTextDlg("Error", dataPath.second);
-        QCoreApplication::exit();
-        return;
-    }
+    readValue(contextStore, "pathStates", pathStates);
+    readValue(contextStore, "intVectorStates", intVectorStates);
 
-    QString filePath = dataPath.second + "/" + settingsFileName;
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly)) {
-        core::getWndManager()->messageTextDlg(
-              "ERROR",
-              "Unable to save gui-wallet settings to " + filePath +
-              "\nError: " + file.errorString());
-        return;
+    if (contextStore.contains("sendCoinsParams")) {
+        QDataStream in(contextStore.value("sendCoinsParams"));
+        in.setVersion(QDataStream::Qt_5_7);
+        sendCoinsParams.loadData(in);
     }
 
-    QDataStream out(&file);
-    out.setVersion(QDataStream::Qt_5_7);
+    if (contextStore.contains("contactList")) {
+        QDataStream in(contextStore.value("contactList"));
+        in.setVersion(QDataStream::Qt_5_7);
+        int contSz = 0;
+        in >> contSz;
+        contactList.clear();
+        for (int i=0;i<contSz;i++) {
+            core::ContactRecord cnt;
+            if (!cnt.loadData(in))
+                break;
+            contactList.push_back(cnt);
+        }
+    }
 
-    QString mockStr;
+    readValue(contextStore, "guiScale", guiScale);
+    readValue(contextStore, "logsEnabled", logsEnabled);
+    readValue(contextStore, "showOutputAll", showOutputAll);
+    readValue(contextStore, "hodlRegistrations", hodlRegistrations);
+    readValue(contextStore, "autoStartMQSEnabled", autoStartMQSEnabled);
+    readValue(contextStore, "oldFormatOutputNotes", oldFormatOutputNotes);
+    readValue(contextStore, "oldFormatTxnNotes", oldFormatTxnNotes);
+    readValue(contextStore, "lockOutputEnabled", lockOutputEnabled);
+
+    // Only permanent locks are stored, record per output
+    lockedOutputs.clear();
+    for (const QString & key : contextStore.keys(LOCKED_OUTPUT_PREFIX))
+        lockedOutputs.insert(key.mid(LOCKED_OUTPUT_PREFIX.size()), "");
+
+    readValue(contextStore, "fluffTransactions", fluffTransactions);
+    readValue(contextStore, "receiveAccount", receiveAccount);
+    readValue(contextStore, "currentAccountName", currentAccountName);
+    readValue(contextStore, "autoStartTorEnabled", autoStartTorEnabled);
+
+    if (contextStore.contains("nodeConnection")) {
+        QDataStream in(contextStore.value("nodeConnection"));
+        in.setVersion(QDataStream::Qt_5_7);
+        int sz = 0;
+        in >> sz;
+        for (int r=0; r<sz; r++) {
+            QString key;
+            in >> key;
+            wallet::MwcNodeConnection val;
+            val.loadData(in);
+            nodeConnection.insert(key,val);
+        }
+    }
 
-    out << 0x47A5;
-    out << mockStr;
-    out << mockStr;
-    out << int(activeWndState);
-    out << pathStates;
-    out << intVectorStates;
+    readValue(contextStore, "walletInstancePaths", walletInstancePaths);
+    readValue(contextStore, "currentWalletInstanceIdx", currentWalletInstanceIdx);
+    readValue(contextStore, "isOnlineNodeMainNetwork", isOnlineNodeMainNetwork);
+    readValue(contextStore, "generateProof", generateProof);
+    readValue(contextStore, "notificationWindowsEnabled", notificationWindowsEnabled);
+    readValue(contextStore, "swapTabSelection", swapTabSelection);
+    readValue(contextStore, "lastUsedSwapCurrency", lastUsedSwapCurrency);
+
+    swapTradesBackupStatus.clear();
+    for (const QString & key : contextStore.keys(SWAP_BACKUP_PREFIX)) {
+        int status = 0;
+        readValue(contextStore, key, status);
+        swapTradesBackupStatus.insert(key.mid(SWAP_BACKUP_PREFIX.size()), status);
+    }
 
-    sendCoinsParams.saveData(out);
+    readValue(contextStore, "swapMaxBackupStatus", swapMaxBackupStatus);
+    readValue(contextStore, "acceptedSwaps", acceptedSwaps);
+    readValue(contextStore, "noTorForEmbeddedNode", noTorForEmbeddedNode);
 
-    out << (int)contactList.size();
-    for ( const auto & c : contactList ) {
-        c.saveData(out);
-    }
+    int sm = int(sendMethod);
+    readValue(contextStore, "sendMethod", sm);
+    sendMethod = bridge::SEND_SELECTED_METHOD(sm);
+    readValue(contextStore, "sendLockOutput", sendLockOutput);
 
-    out << guiScale;
-    out << logsEnabled;
+    readValue(contextStore, "mktFeeReservedAmount", mktFeeReservedAmount);
+    readValue(contextStore, "mktFeeDepositAccount", mktFeeDepositAccount);
+    readValue(contextStore, "mktFeeLevel", mktFeeLevel);
+    readValue(contextStore, "mktPlaceSelectedBtn", mktPlaceSelectedBtn);
 
-    wallet::MwcNodeConnection nc;
-    nc.saveData(out);
-    nc.saveData(out);
+    readValue(contextStore, "swapBackupDir", swapBackupDir);
+}
 
-    QString s;
-    out << s;
-    out << s;
+void AppContext::storeData() {
+    contextStore.put("activeWndState", toBytes(int(activeWndState)));
+    contextStore.put("pathStates", toBytes(pathStates));
+    contextStore.put("intVectorStates", toBytes(intVectorStates));
 
-    out << showOutputAll;
+    {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_7);
+        sendCoinsParams.saveData(out);
+        contextStore.put("sendCoinsParams", data);
+    }
 
-    out << hodlRegistrations;
+    {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_7);
+        out << (int)contactList.size();
+        for ( const auto & c : contactList ) {
+            c.saveData(out);
+        }
+        contextStore.put("contactList", data);
+    }
 
-    out << autoStartMQSEnabled;
-    bool b = false; // legacy autoStartKeybaseEnabled
-    out << b;
+    contextStore.put("guiScale", toBytes(guiScale));
+    contextStore.put("logsEnabled", toBytes(logsEnabled));
+    contextStore.put("showOutputAll", toBytes(showOutputAll));
+    contextStore.put("hodlRegistrations", toBytes(hodlRegistrations));
+    contextStore.put("autoStartMQSEnabled", toBytes(autoStartMQSEnabled));
 
     // if dialogs which display notes have not been accessed, the
     // older format notes will not have been migrated, so we need to
     // continue to save them
-    out << oldFormatOutputNotes;
-    out << oldFormatTxnNotes;
+    contextStore.put("oldFormatOutputNotes", toBytes(oldFormatOutputNotes));
+    contextStore.put("oldFormatTxnNotes", toBytes(oldFormatTxnNotes));
 
-    out << lockOutputEnabled;
+    contextStore.put("lockOutputEnabled", toBytes(lockOutputEnabled));
+    contextStore.put("fluffTransactions", toBytes(fluffTransactions));
+    contextStore.put("receiveAccount", toBytes(receiveAccount));
+    contextStore.put("currentAccountName", toBytes(currentAccountName));
+    contextStore.put("autoStartTorEnabled", toBytes(autoStartTorEnabled));
 
-    // Storing only a set of keys with empty values
-    QSet<QString> lockedOuts;
-    for ( auto io = lockedOutputs.begin(); io != lockedOutputs.end(); io++ ) {
-        if (io.value().isEmpty())
-            lockedOuts += io.key();
-    }
-    out << lockedOuts;
-
-    out << fluffTransactions;
-
-    out << receiveAccount;
-    out << currentAccountName;
-
-    out << autoStartTorEnabled;
-
-    int sz = nodeConnection.size();
-    out << sz;
-    for (QMap<QString, wallet::MwcNodeConnection>::const_iterator i = nodeConnection.constBegin(); i != nodeConnection.constEnd(); ++i) {
-        out << i.key();
-        i.value().saveData(out);
+    {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_7);
+        int sz = nodeConnection.size();
+        out << sz;
+        for (QMap<QString, wallet::MwcNodeConnection>::const_iterator i = nodeConnection.constBegin(); i != nodeConnection.constEnd(); ++i) {
+            out << i.key();
+            i.value().saveData(out);
+        }
+        contextStore.put("nodeConnection", data);
     }
-    out << walletInstancePaths;
-    out << currentWalletInstanceIdx;
-
-    out << isOnlineNodeMainNetwork;
-
-    out << generateProof;
 
-    out << notificationWindowsEnabled;
+    contextStore.put("walletInstancePaths", toBytes(walletInstancePaths));
+    contextStore.put("currentWalletInstanceIdx", toBytes(currentWalletInstanceIdx));
+    contextStore.put("isOnlineNodeMainNetwork", toBytes(isOnlineNodeMainNetwork));
+    contextStore.put("generateProof", toBytes(generateProof));
+    contextStore.put("notificationWindowsEnabled", toBytes(notificationWindowsEnabled));
+    contextStore.put("swapTabSelection", toBytes(swapTabSelection));
+    contextStore.put("lastUsedSwapCurrency", toBytes(lastUsedSwapCurrency));
+    contextStore.put("swapMaxBackupStatus", toBytes(swapMaxBackupStatus));
+    contextStore.put("acceptedSwaps", toBytes(acceptedSwaps));
+    contextStore.put("noTorForEmbeddedNode", toBytes(noTorForEmbeddedNode));
+    contextStore.put("sendMethod", toBytes(int(sendMethod)));
+    contextStore.put("sendLockOutput", toBytes(sendLockOutput));
 
-    out << swapTabSelection;
+    contextStore.put("mktFeeReservedAmount", toBytes(mktFeeReservedAmount));
+    contextStore.put("mktFeeDepositAccount", toBytes(mktFeeDepositAccount));
+    contextStore.put("mktFeeLevel", toBytes(mktFeeLevel));
+    contextStore.put("mktPlaceSelectedBtn", toBytes(mktPlaceSelectedBtn));
 
-    b = true; // legacy swapEnforceBackup
-    out << b;
-
-    out << lastUsedSwapCurrency;
-
-    out << swapTradesBackupStatus;
-
-    out << swapMaxBackupStatus;
-
-    out << acceptedSwaps;
+    contextStore.put("swapBackupDir", toBytes(swapBackupDir));
+}
 
-    out << noTorForEmbeddedNode;
+void AppContext::saveData() {
+    if (!contextStore.isOpen())
+        return; // App data path is not available, error was already reported
 
-    int sm = int(sendMethod);
-    out << sm;
-    out << sendLockOutput;
+    storeData();
+    commitStore(contextStore, "gui-wallet settings");
+}
 
-    out << mktFeeReservedAmount;
-    out << mktFeeDepositAccount;
-    out << mktFeeLevel;
-    out << mktPlaceSelectedBtn;
-    // Feedback,
-    double d = 0.0;
-    out << d; // mktPlaceMinFeeLevel;
-    qint8 i8 = 0;
-    out << i8; // mktPlaceSelling;
-    out << s; // mktPlaceCurrency;
-    out << d;
-    out << d;
+void AppContext::commitStore(util::JournalStore & store, const QString & name) {
+    if (!store.isOpen())
+        return;
 
-    out << swapBackupDir;
+    QString errorMessage;
+    if (!store.commit(errorMessage)) {
+        core::getWndManager()->messageTextDlg(
+                "ERROR",
+                "Unable to save " + name + "\nError: " + errorMessage);
+    }
 }
 
 void AppContext::loadNotesData() {
@@ -526,67 +651,43 @@ void AppContext::loadNotesData() {
 
     notesLoaded = true;
 
-    QFile file(dataPath.second + "/" + notesFileName);
-    if ( !file.open(QIODevice::ReadOnly) ) {
-        // first run, no file exists with notes in new format
-        // migrate any notes in the old format to the new format
-        migrateOutputNotes();
+    const QString storePath = dataPath.second + "/" + notesStoreFileName;
+    const bool storeExist = QFile::exists(storePath);
+
+    QString errorMessage;
+    if (!notesStore.open(storePath, errorMessage)) {
+        // Not overwriting the notes, user might want to recover them
+        core::getWndManager()->messageTextDlg("ERROR", "Unable to read Notes data.\n" + errorMessage);
         return;
     }
 
-    QDataStream in(&file);
-    in.setVersion(QDataStream::Qt_5_7);
-
-    int id = 0;
-    in >> id;
+    if (!storeExist) {
+        // Notes from notes.dat of the previous versions. The file is kept for the older wallets.
+        QFile file(dataPath.second + "/" + notesFileName);
+        if ( file.open(QIODevice::ReadOnly) ) {
+            QDataStream in(&file);
+            in.setVersion(QDataStream::Qt_5_7);
+
+            int id = 0;
+            in >> id;
+
+            if (id==0x4580) {
+                QMap<QString, QString> notes;
+                in >> notes;
+                for (auto i = notes.constBegin(); i != notes.constEnd(); i++)
+                    notesStore.put(i.key(), i.value().toUtf8());
+            }
+        }
 
-    if (id!=0x4580) {
-        // migrate any notes in the old format to the new format
-        migrateOutputNotes();
-        return;
+        if (!notesStore.compact(errorMessage))
+            core::getWndManager()->messageTextDlg("ERROR", "Unable to save Notes data.\n" + errorMessage);
     }
 
-    in >> notes;
     // migrate any notes in the old format to the new format
-    // the old format notes will be added to the notes map
+    // the old format notes will be added to the notes store
     migrateOutputNotes();
 }
 
-void AppContext::saveNotesData() const {
-    QPair<bool,QString> dataPath = ioutils::getAppDataPath("context");
-    if (!dataPath.first) {
-        core::getWndManager()->messageTextDlg("Error", dataPath.second);
-        QCoreApplication::exit();
-        return;
-    }
-
-    QString filePath = dataPath.second + "/" + notesFileName;
-    {
-        QFile file(filePath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            core::getWndManager()->messageTextDlg(
-                    "ERROR",
-                    "Unable to save Notes data to " + filePath +
-                    "\nError: " + file.errorString());
-            return;
-        }
-
-        QDataStream out(&file);
-        out.setVersion(QDataStream::Qt_5_7);
-
-        out << 0x4580;
-        out << notes;
-
-        if (out.status() != QDataStream::Ok) {
-            core::getWndManager()->messageTextDlg(
-                    "ERROR",
-                    "Unable to save Notes data to " + filePath);
-            return;
-        }
-        file.close();
-    }
-}
-
 void AppContext::migrateOutputNotes()
 {
     if (oldFormatOutputNotes.size() <= 0)
@@ -602,11 +703,11 @@ void AppContext::migrateOutputNotes()
             for (QString commitment : op_notes.keys()) {
                 QString note = op_notes.value(commitment);
                 QString key = "c_" + commitment;
-                notes.insert(key, note);
+                notesStore.put(key, note.toUtf8());
             }
         }
     }
-    saveNotesData();
+    commitStore(notesStore, "Notes data");
     oldFormatOutputNotes.clear();
 }
 
@@ -921,8 +1022,10 @@ void AppContext::setLockOutputEnabled(bool enabled) {
 void AppContext::setLockedOutput(const QString & output, bool lock, QString id) {
     if (lock) {
             lockedOutputs.insert(output, id);
-            if (id.isEmpty())
-                saveData();
+            if (id.isEmpty()) {
+                contextStore.put(LOCKED_OUTPUT_PREFIX + output, QByteArray());
+                commitStore(contextStore, "gui-wallet settings");
+            }
             logger::logEmit("AppContext", "onOutputLockChanged", output + " locked" );
             emit onOutputLockChanged(output);
     }
@@ -933,8 +1036,10 @@ void AppContext::setLockedOutput(const QString & output, bool lock, QString id)
             return;
         }
         if (lockedOutputs.remove(output)) {
-            if (prevKey.isEmpty())
-                saveData();
+            if (prevKey.isEmpty()) {
+                contextStore.remove(LOCKED_OUTPUT_PREFIX + output);
+                commitStore(contextStore, "gui-wallet settings");
+            }
             logger::logEmit("AppContext", "onOutputLockChanged", output + " unlocked" );
             emit onOutputLockChanged(output);
         }
@@ -953,7 +1058,12 @@ void AppContext::unlockOutputsById(QString id) {
     }
 
     if (!updatedOutputs.isEmpty()) {
-        saveData();
+        if (id.isEmpty()) {
+            // Only permanent locks are stored
+            for (auto & o : updatedOutputs)
+                contextStore.remove(LOCKED_OUTPUT_PREFIX + o);
+            commitStore(contextStore, "gui-wallet settings");
+        }
         for (auto & o : updatedOutputs) {
             logger::logEmit("AppContext", "onOutputLockChanged", o + " unlocked");
             emit onOutputLockChanged(o);
@@ -985,7 +1095,7 @@ QString AppContext::getNote(const QString& key) {
     if (!notesLoaded) {
         loadNotesData();
     }
-    return notes.value(key);
+    return QString::fromUtf8(notesStore.value(key));
 }
 
 void AppContext::updateNote(const QString& key, const QString& note) {
@@ -994,18 +1104,18 @@ void AppContext::updateNote(const QString& key, const QString& note) {
     }
 
     if (note.isEmpty())
-        notes.remove(key);
+        notesStore.remove(key);
     else
-        notes.insert(key, note);
-    saveNotesData();
+        notesStore.put(key, note.toUtf8());
+    commitStore(notesStore, "Notes data");
 }
 
 void AppContext::deleteNote(const QString& key) {
     if (!notesLoaded) {
         loadNotesData();
     }
-    notes.remove(key);
-    saveNotesData();
+    notesStore.remove(key);
+    commitStore(notesStore, "Notes data");
 }
 
 void AppContext::setNotificationWindowsEnabled(bool enable) {
@@ -1029,7 +1139,8 @@ int  AppContext::getSwapBackStatus(const QString & swapId) const {
 
 void AppContext::setSwapBackStatus(const QString & swapId, int status) {
     swapTradesBackupStatus[swapId] = status;
-    saveData();
+    contextStore.put(SWAP_BACKUP_PREFIX + swapId, toBytes(status));
+    commitStore(contextStore, "gui-wallet settings");
 }
 
 int AppContext::getMaxBackupStatus(QString swapId, int status) {
@@ -21,6 +21,7 @@
 #include "../wallet/wallet.h"
 #include "../core/Config.h"
 #include "../bridge/wnd/g_send_b.h"
+#include "../util/journalstore.h"
 #include <QDebug>
 #include <QHash>
 
@@ -255,13 +256,19 @@ signals:
 private:
     bool loadData();
     bool loadDataImpl();
+    // Read context.dat from the versions before the journaled store
+    bool loadLegacyData(const QString & contextDir);
+    void loadStoreData();
 
-    void saveData() const;
+    // Put all settings into the store. Permanent locks and swap backup statuses are written by their setters.
+    void storeData();
+    void saveData();
 
     void loadNotesData();
-    void saveNotesData() const;
     void migrateOutputNotes();
 
+    void commitStore(util::JournalStore & store, const QString & name);
+
 private:
     // 16 bit hash from the password. Can be used for the password verification
     // Don't use many bits because we don't want it be much usable for attacks.
@@ -329,9 +336,12 @@ private:
     // Notes data. Notes can be done for Commits, transactions or may be something else.
     // By definition tx uuid and commits are unique, that it why we can use them as a key across all wallets
     // Notes are stored in it's own location, because of data importance and corruption possibility.
-    // For notes we need to do save and move
+    // Every note is a separate store record, update of the note is a single journal append.
     bool notesLoaded = false;
-    QMap<QString, QString> notes;
+    util::JournalStore notesStore;
+
+    // All settings. Every setting is a separate record, only changed ones are written.
+    util::JournalStore contextStore;
 
     // Earlier versions of Qt wallet stored notes in a different format by wallet and account
     // We read these notes in and migrate them to the new format for storing notes
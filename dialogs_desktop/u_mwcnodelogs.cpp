@@ -19,6 +19,9 @@
 
 namespace dlg {
 
+// Search results are limited, it is enough to see what is going on
+const static int SEARCH_MAX_LINES = 1000;
+
 MwcNodeLogs::MwcNodeLogs(QWidget *parent) :
     control::MwcDialog(parent),
     ui(new Ui::MwcNodeLogs)
@@ -29,7 +32,7 @@ MwcNodeLogs::MwcNodeLogs(QWidget *parent) :
 
     ui->fullLogsLink->setText("mwc-node logs location: " + node->getLogsLocation() );
 
-    ui->logsEdit->setPlainText( node->getOutputLines().join("\n") );
+    updateLogs();
 
     QObject::connect(node, &bridge::Node::sgnMwcOutputLine,
                      this, &MwcNodeLogs::onMwcOutputLine, Qt::QueuedConnection);
@@ -54,7 +57,20 @@ void MwcNodeLogs::onMwcOutputLine(QString line) {
             return;
     }
 
-    ui->logsEdit->setPlainText( node->getOutputLines().join("\n") );
+    updateLogs();
+}
+
+void MwcNodeLogs::on_searchEdit_textChanged(const QString & text) {
+    Q_UNUSED(text)
+    updateLogs();
+}
+
+void MwcNodeLogs::updateLogs() {
+    QString text = ui->searchEdit->text();
+    if (text.isEmpty())
+        ui->logsEdit->setPlainText( node->getOutputLines().join("\n") );
+    else
+        ui->logsEdit->setPlainText( node->searchOutputLines(text, SEARCH_MAX_LINES).join("\n") );
 }
 
 
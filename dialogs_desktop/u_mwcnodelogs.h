@@ -39,6 +39,10 @@ public:
 private slots:
     void on_okButton_clicked();
     void onMwcOutputLine(QString line);
+    void on_searchEdit_textChanged(const QString & text);
+
+private:
+    void updateLogs();
 
 private:
     Ui::MwcNodeLogs *ui;
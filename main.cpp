@@ -62,6 +62,11 @@
 #include "tests/testPasswordAnalyser.h"
 #include "tests/testCalcOutputsToSpend.h"
 #include "tests/testLogs.h"
+#include "tests/testHttpClient.h"
+#include "tests/testJournalStore.h"
+#include "tests/testFolderCompressor.h"
+#include "tests/testLinesRingBuffer.h"
+#include "tests/testWalletData.h"
 #include "misk/DictionaryInit.h"
 #include "util/stringutils.h"
 #include "build_version.h"
@@ -361,6 +366,7 @@ int main(int argc, char *argv[])
     // Generation of the dictionaries.
     // Don't uncomment it!
     // misk::provisionDictionary();
+    // misk::compileDictionaries();
 
     // tests are quick, let's run them in debug
 //    test::testCalcOutputsToSpend();  // This test is long and show about 8 Message boxes.
@@ -371,6 +377,10 @@ int main(int argc, char *argv[])
     test::testWordDictionary();
     test::testPasswordAnalyser();
     test::testMessageMapper();
+    test::testJournalStore();
+    test::testFolderCompressor();
+    test::testLinesRingBuffer();
+    test::testWalletDataJson();
 #endif
 #endif
 
@@ -430,6 +440,11 @@ int main(int argc, char *argv[])
         logger::logInfo("mwc-qt-wallet", QString("Starting mwc-gui-wallet version ") + BUILD_VERSION + " with config:\n" + config::toString() );
         qDebug().noquote() << "Starting mwc-gui-wallet with config:\n" << config::toString();
 
+#if defined(QT_DEBUG) && defined(WALLET_DESKTOP) && !defined(Q_OS_WIN)
+        // This test needs the app event loop and logger
+        test::testHttpClient();
+#endif
+
 #ifdef WALLET_DESKTOP
         { // Apply style sheet
             QFile file(":/resource_desktop/mwcwallet_style.css" );
@@ -562,6 +577,9 @@ int main(int argc, char *argv[])
 
         delete mwcNode; mwcNode = nullptr;
 
+        // Writing queued log records and waiting for the log writer thread
+        logger::enableLogs(false);
+
         util::releaseAppGlobalLock();
 
         break;
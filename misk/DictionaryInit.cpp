@@ -14,7 +14,9 @@
 
 #include "DictionaryInit.h"
 #include <QSet>
+#include <QFile>
 #include "../util/WordDictionary.h"
+#include "../util/WordTrie.h"
 
 
 namespace misk {
@@ -80,5 +82,26 @@ void provisionDictionary() {
     Q_ASSERT(dict.findLongestWord("ablue") == "");
 }
 
+bool compileDictionaries() {
+    // Order defines the dictionary number, see PasswordAnalyser
+    QVector<QStringList> dictionaries;
+    for ( const QString & fn : {"/mw/mwc-qt-wallet/resource/passwords-1k.dat",
+                                "/mw/mwc-qt-wallet/resource/passwords-10k.dat",
+                                "/mw/mwc-qt-wallet/resource/passwords-100k.dat",
+                                "/mw/mwc-qt-wallet/resource/passwords-1M.dat"} ) {
+        dictionaries.push_back( dict::unstackWords( dict::decompressWords(fn) ) );
+    }
+
+    QByteArray trie = dict::buildWordTrie( dictionaries );
+
+    QFile outFile("/mw/mwc-qt-wallet/resource/passwords.trie");
+    if (!outFile.open(QIODevice::WriteOnly))
+        return false;
+
+    outFile.write(trie);
+    outFile.close();
+    return true;
+}
+
 
 }
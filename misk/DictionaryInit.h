@@ -25,6 +25,11 @@ namespace misk {
 // Series:  xato-net-10-million-passwords
 void provisionDictionary();
 
+// Compile the dictionaries from provisionDictionary into the single trie that password analyser is using.
+// Result need to be placed into resources uncompressed, see resource/passwords.trie
+// return true if file was written
+bool compileDictionaries();
+
 
 }
 
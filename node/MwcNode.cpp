@@ -41,10 +41,13 @@ namespace node {
 MwcNode::MwcNode(const QString & _nodePath, core::AppContext * _appContext) :
         QObject(),
         appContext(_appContext),
-        nodePath(_nodePath)
+        nodePath(_nodePath),
+        outputLines(NODE_OUTPUT_LINES, true)
 {
-    // Let's check node status every minute
-    startTimer( CHECK_NODE_PERIOD );
+    // Health check period depends on the node state, see scheduleHealthCheck
+    healthTimer = new QTimer(this);
+    healthTimer->setSingleShot(true);
+    connect( healthTimer, &QTimer::timeout, this, &MwcNode::onHealthCheck );
 
     nwManager = new QNetworkAccessManager();
     connect( nwManager, &QNetworkAccessManager::finished, this, &MwcNode::replyFinished, Qt::QueuedConnection );
@@ -90,20 +93,26 @@ void MwcNode::start(const QString & dataPath, const QString & network, bool tor
     if (tor)
         respondTimelimit += START_TOR_TIMEOUT;
 
-    nodeNoPeersFailCounter = 0;
-    nodeOutOfSyncCounter = 0;
+    nodeNoPeersSince = 0;
+    nodeOutOfSyncSince = 0;
     nodeHeight = 0;
     peersMaxHeight = 0;
     txhashsetHeight = 0;
     syncIsDone = false;
     maxBlockHeight = 0;
     initChainHeight = 0;
+    lastCheckFailed = false;
+    healthHistory.clear();
+    healthHistoryHead = 0;
 
     // Creating process and starting
     nodeProcess = initNodeProcess(dataPath, network, tor);
     nodeOutputParser = new tries::NodeOutputParser();
 
     connect( nodeOutputParser, &tries::NodeOutputParser::nodeOutputGenericEvent, this, &MwcNode::nodeOutputGenericEvent, Qt::QueuedConnection);
+
+    healthTimer->stop();
+    scheduleHealthCheck();
 }
 
 void MwcNode::stop() {
@@ -113,6 +122,7 @@ void MwcNode::stop() {
     QCoreApplication::processEvents();
 
     nodeProcDisconnect();
+    healthTimer->stop();
 
     if (nodeProcess) {
 
@@ -391,26 +401,20 @@ void MwcNode::mwcNodeReadyReadStandardOutput() {
 
         nonEmittedOutput += str;
 
-        QString ln;
-
+        int lineStart = 0;
         for (int t=0; t<nonEmittedOutput.length(); t++) {
             QChar ch = nonEmittedOutput[t];
             if ( ch=='\r' || ch=='\n' ) {
-                if (!ln.isEmpty()) {
+                if (t > lineStart) {
+                    QString ln = nonEmittedOutput.mid(lineStart, t-lineStart);
                     emit onMwcOutputLine(ln);
-                    outputLines.push_front(ln);
-                    while( outputLines.size() > 10000 ) // List should be OK with that. It is optimized for head/tail ops.
-                        outputLines.pop_back();
-
-                    ln = "";
+                    outputLines.append(ln);
                 }
-            }
-            else {
-                ln += ch;
+                lineStart = t+1;
             }
         }
 
-        nonEmittedOutput = ln;
+        nonEmittedOutput.remove(0, lineStart);
     }
 }
 
@@ -492,7 +496,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
     switch (event) {
         case tries::NODE_OUTPUT_EVENT::MWC_NODE_STARTED:
             nextTimeLimit += int64_t(MWC_NODE_STARTED_TIMEOUT * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
             lastProcessedEvent = event;
             notify::appendNotificationMessage( bridge::MESSAGE_LEVEL::INFO, "Embedded mwc-node was started" );
             break;
@@ -500,6 +504,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             lastProcessedEvent = event;
             nodeStatusString = "Waiting for peers";
             emit onMwcStatusUpdate(nodeStatusString);
+            requestImmediateHealthCheck();
             break;
 
         case tries::NODE_OUTPUT_EVENT::INITIAL_CHAIN_HEIGHT: {
@@ -523,7 +528,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
                                                   "Embedded mwc-node requesting headers to sync up");
             }
             nextTimeLimit += int64_t(MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             // We are getting headers during all stages. But we want to display progress only for the step 1.
             if (lastProcessedEvent <= event) {
@@ -557,7 +562,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             }
             // archive can be large, let's wait extra
             nextTimeLimit += int64_t( 3 * MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             // for progress need to parse the second element
             QStringList params = message.split('|');
@@ -577,7 +582,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
         case tries::NODE_OUTPUT_EVENT::TXHASHSET_ARCHIVE_IN_PROGRESS: {
             // archive can be large, let's wait extra
             nextTimeLimit += int64_t(MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             // for progress need to parse the second element
             QStringList params = message.split('|');
@@ -603,7 +608,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             }
             // tx Hash really might take a while to process
             nextTimeLimit += int64_t( 10 * MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             if (! message.contains("DONE") ) {
                 nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::TXHASHSET_GET, 0 );
@@ -621,7 +626,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
 
             // tx Hash really might take a while to process
             nextTimeLimit += int64_t( 10 * MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             int handledH = message.trimmed().toInt();
             if (handledH>0 && handledH<txhashsetHeight) {
@@ -638,7 +643,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             }
 
             nextTimeLimit += int64_t(MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             int handledH = message.trimmed().toInt();
             if (handledH>0 && handledH<txhashsetHeight) {
@@ -655,7 +660,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             }
             // expected no break
             nextTimeLimit += int64_t(MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             if (!syncIsDone) { // Async process, order is not guaranteed
 
@@ -683,7 +688,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
         }
         case tries::NODE_OUTPUT_EVENT::SYNC_IS_DONE:{
             nextTimeLimit += int64_t(MWC_NODE_SYNC_MESSAGES * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0;
+            nodeOutOfSyncSince = 0;
 
             syncIsDone = true;
 
@@ -703,7 +708,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
 
         case tries::NODE_OUTPUT_EVENT::RECEIVE_BLOCK_LISTEN: {
             nextTimeLimit += int64_t(RECEIVE_BLOCK_LISTEN * config::getTimeoutMultiplier());
-            nodeOutOfSyncCounter = 0; // It is still normal syncronization, need to reset the counter
+            nodeOutOfSyncSince = 0; // It is still normal syncronization, need to reset the watchdog
 
             // message: 2a695957b396 at 102204 from 34.238.121.224:13414 [in/out/kern: 0/1/1] going to process.
             int idx1 = message.indexOf("at ");
@@ -727,7 +732,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
 
             nodeStatusString = "Waiting for peers";
             emit onMwcStatusUpdate(nodeStatusString);
-
+            requestImmediateHealthCheck();
             break;
         case tries::NODE_OUTPUT_EVENT::ADDRESS_ALREADY_IN_USE:
             if (isFinalRun()) {
@@ -772,16 +777,38 @@ void MwcNode::updateRunningStatus() {
     if (nodeStatusString != newStatus) {
         nodeStatusString = newStatus;
         emit onMwcStatusUpdate(nodeStatusString);
+        // Node might lost the top, need to poll faster
+        scheduleHealthCheck();
     }
 }
 
+void MwcNode::scheduleHealthCheck() {
+    if ( nodeProcess== nullptr )
+        return;
+
+    const bool steady = syncIsDone && !lastCheckFailed && nodeStatusString == "Ready";
+    const int period = int(steady ? CHECK_NODE_STEADY_PERIOD : CHECK_NODE_SYNC_PERIOD);
+
+    // Never postpone the check that is already scheduled sooner
+    if ( !healthTimer->isActive() || healthTimer->remainingTime() > period )
+        healthTimer->start(period);
+}
+
+void MwcNode::requestImmediateHealthCheck() {
+    if ( nodeProcess== nullptr )
+        return;
 
-void MwcNode::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event)
+    const int delay = int(std::max( int64_t(0), lastHealthCheck + CHECK_NODE_MIN_PERIOD - QDateTime::currentMSecsSinceEpoch() ));
+    if ( !healthTimer->isActive() || healthTimer->remainingTime() > delay )
+        healthTimer->start(delay);
+}
 
+void MwcNode::onHealthCheck() {
     if ( nodeProcess== nullptr || nodeOutputParser== nullptr )
         return;
 
+    lastHealthCheck = QDateTime::currentMSecsSinceEpoch();
+
     bool need2restart = false;
 
     // Check if timer expired and we need to logout...
@@ -793,7 +820,9 @@ void MwcNode::timerEvent(QTimerEvent *event) {
         need2restart = true;
     }
 
-    if ( nodeNoPeersFailCounter > NODE_NO_PEERS_FAILURE_LIMITS || nodeOutOfSyncCounter > NODE_OUT_OF_SYNC_FAILURE_LIMIT ) {
+    const int64_t now = QDateTime::currentMSecsSinceEpoch();
+    if ( (nodeNoPeersSince != 0 && now - nodeNoPeersSince > int64_t(NODE_NO_PEERS_FAILURE_LIMITS * config::getTimeoutMultiplier())) ||
+         (nodeOutOfSyncSince != 0 && now - nodeOutOfSyncSince > int64_t(NODE_OUT_OF_SYNC_FAILURE_LIMIT * config::getTimeoutMultiplier())) ) {
         // need to restart
         logger::logInfo("MwcNode", "Restarting node because API didn't get expected info from the node during long time period");
         need2restart = true;
@@ -808,12 +837,55 @@ void MwcNode::timerEvent(QTimerEvent *event) {
     // Let's make API calls to verify the node status
     sendRequest( "Peers", getNodeSecret(), "/v1/peers/connected");
     sendRequest( "Status", getNodeSecret(), "/v1/status");
+
+    scheduleHealthCheck();
+}
+
+void MwcNode::markNoPeersFailure() {
+    if (nodeNoPeersSince == 0)
+        nodeNoPeersSince = QDateTime::currentMSecsSinceEpoch();
+}
+
+void MwcNode::addHealthSample(int height, int connections) {
+    NodeHealthSample sample;
+    sample.time = QDateTime::currentMSecsSinceEpoch();
+    sample.height = height;
+    sample.peersHeight = peersMaxHeight;
+    sample.connections = connections;
+
+    if (!healthHistory.isEmpty()) {
+        const NodeHealthSample & prev = healthHistory[ (healthHistoryHead + healthHistory.size() - 1) % healthHistory.size() ];
+        if (prev.height > 0 && height >= prev.height)
+            sample.syncRate = (height - prev.height) * 60000.0 / double(std::max( int64_t(1), sample.time - prev.time ));
+    }
+
+    if (healthHistory.size() < NODE_HEALTH_HISTORY_SIZE) {
+        healthHistory.push_back(sample);
+    }
+    else {
+        healthHistory[healthHistoryHead] = sample;
+        healthHistoryHead = (healthHistoryHead + 1) % healthHistory.size();
+    }
+}
+
+QVector<NodeHealthSample> MwcNode::getHealthHistory() const {
+    QVector<NodeHealthSample> res;
+    res.reserve(healthHistory.size());
+    for (int i = 0; i < healthHistory.size(); i++)
+        res.push_back( healthHistory[ (healthHistoryHead + i) % healthHistory.size() ] );
+    return res;
 }
 
 // Very simple request. No params, no body, no ssl
 void MwcNode::sendRequest( const QString & tag, QString secret,
                 const QString & api, REQUEST_TYPE reqType) {
 
+    // Slow node can't answer the previous poll yet. No reasons to stack the same requests
+    if (pendingRequests.contains(tag)) {
+        qDebug() << "Skipping request " << tag << ", previous one is still in progress";
+        return;
+    }
+
     QString url = "http://localhost:13413" + api;
 
     qDebug() << "Sending request: " << url << "  tag:" << tag;
@@ -825,6 +897,8 @@ void MwcNode::sendRequest( const QString & tag, QString secret,
     logger::logInfo("MwcNode", "Requesting: " + requestUrl.toString());
     request.setUrl( requestUrl );
     request.setHeader(QNetworkRequest::ServerHeader, "application/json");
+    // Polling the same host, the connection is reused by the manager
+    request.setRawHeader("Connection", "keep-alive");
 
     // HTTP Basic authentication header value: base64(username:password)
     QString user = lastUsedNetwork.toLower().contains("floo") ? QString("mwcfloo") : QString("mwcmain");
@@ -850,6 +924,9 @@ void MwcNode::sendRequest( const QString & tag, QString secret,
 
     if (reply) {
         reply->setProperty("tag", QVariant(tag));
+        pendingRequests.insert(tag);
+        // Hanging request would block the polling, aborted request will be finished with error
+        QTimer::singleShot( int(CHECK_NODE_STEADY_PERIOD * config::getTimeoutMultiplier()), reply, &QNetworkReply::abort );
         // Respond will be send back async
     }
 }
@@ -862,8 +939,12 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
     reply->deleteLater();
     reply = nullptr;
 
+    pendingRequests.remove(tag);
+
     if (errCode != QNetworkReply::NoError) {
-        nodeNoPeersFailCounter++;
+        markNoPeersFailure();
+        lastCheckFailed = true;
+        scheduleHealthCheck();
         return;
     }
 
@@ -871,7 +952,9 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
     QJsonDocument   jsonDoc = QJsonDocument::fromJson(strReply.toUtf8(), &error);
 
     if (error.error != QJsonParseError::NoError) {
-        nodeNoPeersFailCounter++;
+        markNoPeersFailure();
+        lastCheckFailed = true;
+        scheduleHealthCheck();
         return;
     }
 
@@ -892,7 +975,8 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
             }
 
             if (peersMaxHeight > nodeHeight - 3) {
-                nodeOutOfSyncCounter++;
+                if (nodeOutOfSyncSince == 0)
+                    nodeOutOfSyncSince = QDateTime::currentMSecsSinceEpoch();
             }
 
             if (syncIsDone)
@@ -927,8 +1011,16 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
         logger::logInfo("MwcNode", "MWC Node status: connections=" + QString::number(connections) +
                 " height="+QString::number(nodeHeight));
 
-        if (connections == 0)
-            nodeNoPeersFailCounter++;
+        addHealthSample(nodeHeight, connections);
+
+        lastCheckFailed = connections == 0;
+        if (connections == 0) {
+            markNoPeersFailure();
+            scheduleHealthCheck();
+        }
+        else {
+            nodeNoPeersSince = 0;
+        }
     }
 
 }
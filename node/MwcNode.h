@@ -18,10 +18,13 @@
 #include <QObject>
 #include <QProcess>
 #include <QVector>
+#include <QSet>
 #include "../tries/NodeOutputParser.h"
+#include "../util/linesringbuffer.h"
 
 class QNetworkAccessManager;
 class QNetworkReply;
+class QTimer;
 
 namespace core {
 class AppContext;
@@ -34,13 +37,24 @@ class NodeOutputParser;
 namespace node {
 
 // Node management timeouts.
-const int64_t CHECK_NODE_PERIOD = 5 * 1000; // Timer check period. API calls to node will be issued
-const int64_t NODE_OUT_OF_SYNC_FAILURE_LIMIT = 60; // Node ouf of sync and nothing was updated...
-const int64_t NODE_NO_PEERS_FAILURE_LIMITS = 60; // Let's wait 5 minutes before restarts
+// Node API is polled fast while the node is syncing or something looks wrong, and slow when it is steady.
+// Suspicious output events trigger the poll immediately.
+const int64_t CHECK_NODE_SYNC_PERIOD = 5 * 1000;
+const int64_t CHECK_NODE_STEADY_PERIOD = 30 * 1000;
+const int64_t CHECK_NODE_MIN_PERIOD = 1000; // Immediate polls are not issued more often than that
+// Restart the node if it stays without progress that long. Measured in time, so it doesn't depend on the poll period
+const int64_t NODE_OUT_OF_SYNC_FAILURE_LIMIT = 5*60*1000; // Node ouf of sync and nothing was updated...
+const int64_t NODE_NO_PEERS_FAILURE_LIMITS = 5*60*1000; // No peers or API failures
+
+// Number of the health samples that we keep. At sync period it is one hour
+const int NODE_HEALTH_HISTORY_SIZE = 720;
 
 const int64_t START_TIMEOUT   = 120*1000;
 const int64_t START_TOR_TIMEOUT = 60*10*1000; // Tor can start for a very long time. Let's wait for extra 10 minutes if we are using tor
 
+// Number of the node output lines that we keep for the logs page
+const int NODE_OUTPUT_LINES = 10000;
+
 // messages from NodeOutputParser
 const int64_t MWC_NODE_STARTED_TIMEOUT = 180*1000; // It can take some time to find peers
 const int64_t MWC_NODE_SYNC_MESSAGES = 60*1000; // Sync supposed to be agile
@@ -63,6 +77,15 @@ struct NodeStatus {
     int64_t updateTime  = 0;
 };
 
+// Node health sample, one per status API respond
+struct NodeHealthSample {
+    int64_t time        = 0; // ms since epoch
+    int     height      = 0;
+    int     peersHeight = 0;
+    int     connections = 0;
+    double  syncRate    = 0.0; // blocks per minute since the previous sample
+};
+
 // mwc-node lifecycle management
 class MwcNode : public QObject {
 Q_OBJECT
@@ -80,11 +103,14 @@ public:
 
     QString getMwcStatus() const { return nodeStatusString; }
 
-    // Last Many node output lines. There are many of them.
+    // Last Many node output lines. There are many of them, use snapshot/search instead of copying all.
     // Call from the same thread
-    const QStringList & getOutputLines() const {return outputLines;}
+    const util::LinesRingBuffer & getOutputLines() const {return outputLines;}
 
     QString getLogsLocation() const;
+
+    // Rolling history of the node health samples, the oldest first
+    QVector<NodeHealthSample> getHealthHistory() const;
 private:
     QProcess * initNodeProcess( const QString & dataPath, const QString & network, bool tor );
 
@@ -101,8 +127,14 @@ private:
     void updateRunningStatus();
 
     bool isFinalRun() {return restartCounter>2;}
-private:
-    virtual void timerEvent(QTimerEvent *event) override;
+
+    // Schedule the next health check. Fast polling if the node is syncing or the last check failed.
+    void scheduleHealthCheck();
+    // Check now. Events are bursty, so immediate checks are throttled by CHECK_NODE_MIN_PERIOD
+    void requestImmediateHealthCheck();
+
+    void markNoPeersFailure();
+    void addHealthSample(int height, int connections);
 
 private: signals:
     void onMwcOutputLine(QString line);
@@ -120,6 +152,9 @@ private slots:
 
     // One short timer to restart the node. Usinng instead of sleep
     void onRestartNode();
+
+    // Restart checks and node API polling
+    void onHealthCheck();
 private:
     core::AppContext *appContext; // app context to store current account name
 
@@ -137,13 +172,22 @@ private:
 
     QVector< QMetaObject::Connection > processConnections; // open connection to mwc713
 
-    int nodeNoPeersFailCounter = 0;
-    int nodeOutOfSyncCounter = 0;
+    int64_t nodeNoPeersSince = 0; // Time of the first failure since the last good respond, 0 if healthy
+    int64_t nodeOutOfSyncSince = 0; // Time of the first out of sync poll since the last sync progress, 0 if healthy
     int nodeHeight = 0;
     int peersMaxHeight = 0;
     int initChainHeight = 0;
 
+    // Single manager keeps the connection to the node open between the polls
     QNetworkAccessManager *nwManager;
+    QSet<QString> pendingRequests; // tags of the requests that are waiting for respond
+
+    QTimer * healthTimer = nullptr;
+    int64_t lastHealthCheck = 0;
+    bool    lastCheckFailed = false;
+
+    QVector<NodeHealthSample> healthHistory; // ring buffer
+    int healthHistoryHead = 0; // index of the oldest sample when the buffer is full
 
     tries::NODE_OUTPUT_EVENT lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
 
@@ -154,8 +198,8 @@ private:
     int     maxBlockHeight = 0; // backing stopper for getted blocks.
     bool    syncIsDone = false;
 
-    // Last Many node output lines
-    QStringList outputLines;
+    // Last Many node output lines, with search index
+    util::LinesRingBuffer outputLines;
 
     // Will try to restart the node several times.
     // The reason that because of another instance is running
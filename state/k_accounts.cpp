@@ -20,6 +20,7 @@
 #include "../core/global.h"
 #include "../core/Config.h"
 #include "../core/WndManager.h"
+#include "../core/Scheduler.h"
 #include "../bridge/BridgeManager.h"
 #include "../bridge/wnd/k_accounts_b.h"
 
@@ -35,7 +36,8 @@ Accounts::Accounts(StateContext * context) :
 
     startingTime = 0;
 
-    startTimer(61*1000);
+    // Balance refresh is suspended until login
+    balanceJobId = core::getScheduler()->addPeriodicJob("AccountsBalance", 61*1000, this, [this]() {onBalanceTimer();}, false);
 }
 
 Accounts::~Accounts() {}
@@ -78,15 +80,14 @@ void Accounts::deleteAccount( QString accountName ) {
     context->wallet->renameAccount( accountName, newName );
 }
 
-void Accounts::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event);
-
+void Accounts::onBalanceTimer() {
     // Skipping first 5 seconds after start. Let's mwc-node get online
     if ( startingTime==0 || QDateTime::currentMSecsSinceEpoch() - startingTime < 5000 )
         return;
 
     if ( !context->wallet->isWalletRunningAndLoggedIn() ) {
         startingTime=0;
+        core::getScheduler()->setJobActive(balanceJobId, false);
         return;
     }
 
@@ -115,6 +116,7 @@ void Accounts::timerEvent(QTimerEvent *event) {
 void Accounts::onLoginResult(bool ok) {
     Q_UNUSED(ok)
     startingTime = QDateTime::currentMSecsSinceEpoch();
+    core::getScheduler()->setJobActive(balanceJobId, true);
 }
 
 
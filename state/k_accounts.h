@@ -43,7 +43,7 @@ private slots:
     void onNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, int64_t totalDifficulty, int connections );
 
 private:
-    virtual void timerEvent(QTimerEvent *event) override;
+    void onBalanceTimer();
 
     bool isNodeHealthy() const {return nodeIsHealthy;}
 private:
@@ -52,6 +52,7 @@ private:
     bool lastNodeIsHealty = true;
 
     int64_t startingTime = 0;
+    int balanceJobId = 0;
 };
 
 }
@@ -15,7 +15,7 @@
 #include "s_mktswap.h"
 #include "s_swap.h"
 #include "statemachine.h"
-#include "../core/TimerThread.h"
+#include "../core/Scheduler.h"
 #include "../core/appcontext.h"
 #include "../core/WndManager.h"
 #include "../wallet/wallet.h"
@@ -26,6 +26,7 @@
 #include <QDateTime>
 #include "s_swap.h"
 #include <cmath>
+#include <algorithm>
 #include <QFile>
 #include "../util/address.h"
 
@@ -147,6 +148,140 @@ double  MktSwapOffer::calcRate() const {
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+//  MktOrderBook
+////////////////////////////////////////////////////////////////////////////////
+
+// Expiration wheel granularity
+const int64_t EXPIRY_SLOT_SEC = 10;
+
+static bool isRateLess(const MktSwapOffer & o1, const MktSwapOffer & o2) {
+    return o1.calcRate() < o2.calcRate();
+}
+
+static bool isRateGreater(const MktSwapOffer & o1, const MktSwapOffer & o2) {
+    return o1.calcRate() > o2.calcRate();
+}
+
+// Add a new offer or update exist one. Return true if offer is new
+bool MktOrderBook::updateOffer(const MktSwapOffer & offer) {
+    const QString key = offer.getKey();
+    const bool isNew = !offers.contains(key);
+    if (!isNew)
+        removeOffer(key);
+
+    offers.insert(key, offer);
+    books[offer.sell ? 1 : 0][offer.secondaryCurrency].insert( std::make_pair(offer.calcRate(), key) );
+    expiryWheel[offer.timestamp / EXPIRY_SLOT_SEC].insert(key);
+    return isNew;
+}
+
+void MktOrderBook::removeOffer(const QString & key) {
+    auto oi = offers.find(key);
+    if (oi == offers.end())
+        return;
+
+    const MktSwapOffer & offer = oi.value();
+
+    auto bi = books[offer.sell ? 1 : 0].find(offer.secondaryCurrency);
+    Q_ASSERT(bi != books[offer.sell ? 1 : 0].end());
+    bi.value().erase( std::make_pair(offer.calcRate(), key) );
+    if (bi.value().empty())
+        books[offer.sell ? 1 : 0].erase(bi);
+
+    auto wi = expiryWheel.find(offer.timestamp / EXPIRY_SLOT_SEC);
+    Q_ASSERT(wi != expiryWheel.end());
+    wi.value().remove(key);
+    if (wi.value().isEmpty())
+        expiryWheel.erase(wi);
+
+    offers.erase(oi);
+}
+
+// Remove offers with timestamp older than expiredTime. Return number of removed offers
+int MktOrderBook::removeExpired(int64_t expiredTime) {
+    int removed = 0;
+    while (!expiryWheel.isEmpty()) {
+        auto slot = expiryWheel.begin();
+        if (slot.key() > expiredTime / EXPIRY_SLOT_SEC)
+            break;
+
+        // The last slot might be expired partially
+        const bool wholeSlot = (slot.key() + 1) * EXPIRY_SLOT_SEC <= expiredTime;
+        QVector<QString> expired;
+        for (const auto & key : slot.value()) {
+            if (wholeSlot || offers.value(key).timestamp < expiredTime)
+                expired.push_back(key);
+        }
+
+        for (const auto & key : expired)
+            removeOffer(key);
+        removed += expired.size();
+
+        if (!wholeSlot)
+            break;
+    }
+    return removed;
+}
+
+// Offers with timestamp not older than timeLimit, sorted by rate: descending for sell, ascending for others
+QVector<MktSwapOffer> MktOrderBook::getOffers(int selling, const QString & currency, double minFeeLevel,
+                                              int64_t timeLimit, const QString & excludeWalletAddress) const {
+    QVector<const Book *> selectedBooks;
+    for (int sell = 0; sell < 2; sell++) {
+        if ( (sell == 1 && selling == 0) || (sell == 0 && selling == 1) )
+            continue;
+
+        if (currency.isEmpty()) {
+            for (auto bi = books[sell].begin(); bi != books[sell].end(); bi++)
+                selectedBooks.push_back(&bi.value());
+        }
+        else {
+            auto bi = books[sell].find(currency);
+            if (bi != books[sell].end())
+                selectedBooks.push_back(&bi.value());
+        }
+    }
+
+    QVector<MktSwapOffer> result;
+    auto addOffer = [&](const QString & key) {
+        const MktSwapOffer & ofr = offers.find(key).value();
+        if (ofr.timestamp >= timeLimit && ofr.walletAddress != excludeWalletAddress && ofr.getFeeLevel() >= minFeeLevel)
+            result.push_back(ofr);
+    };
+
+    for (const Book * book : selectedBooks) {
+        if (selling == 1) {
+            for (auto ri = book->rbegin(); ri != book->rend(); ri++)
+                addOffer(ri->second);
+        }
+        else {
+            for (const auto & r : *book)
+                addOffer(r.second);
+        }
+    }
+
+    // Every book is sorted already, only several books need to be sorted together
+    if (selectedBooks.size() > 1)
+        std::sort( result.begin(), result.end(), selling == 1 ? isRateGreater : isRateLess );
+
+    return result;
+}
+
+// Number of offers per currency
+QVector<QPair<QString,int>> MktOrderBook::getOffersNumber() const {
+    QMap<QString, int> offersNum;
+    for (int sell = 0; sell < 2; sell++) {
+        for (auto bi = books[sell].begin(); bi != books[sell].end(); bi++)
+            offersNum[bi.key()] += int(bi.value().size());
+    }
+
+    QVector<QPair<QString,int>> result;
+    for (auto oi = offersNum.begin(); oi != offersNum.end(); oi++)
+        result.push_back( QPair<QString,int>(oi.key(), oi.value()) );
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //  MySwapOffer
 ////////////////////////////////////////////////////////////////////////////////
@@ -232,9 +367,7 @@ SwapMarketplace::SwapMarketplace(StateContext * context) :
     // If somebody accept the current offer, we don't want to print errors as forging. We better have 'not found' error.
     currentOfferId = int(QDateTime::currentMSecsSinceEpoch() % 30000);
 
-    timer = new core::TimerThread(this, 5000);
-    QObject::connect( timer, &core::TimerThread::onTimerEvent, this, &SwapMarketplace::onTimerEvent, Qt::QueuedConnection );
-    timer->start();
+    core::getScheduler()->addPeriodicJob("SwapMarketplace", 5000, this, [this]() {onTimerEvent();});
 
     QObject::connect( context->wallet, &wallet::Wallet::onCreateIntegrityFee, this, &SwapMarketplace::respCreateIntegrityFee, Qt::QueuedConnection );
     QObject::connect( context->wallet, &wallet::Wallet::onRequestIntegrityFees, this, &SwapMarketplace::respRequestIntegrityFees, Qt::QueuedConnection );
@@ -254,11 +387,7 @@ SwapMarketplace::SwapMarketplace(StateContext * context) :
     swap = (Swap*) context->stateMachine->getState(STATE::SWAP);
 }
 
-SwapMarketplace::~SwapMarketplace() {
-    timer->stop();
-    timer->wait();
-    delete timer;
-}
+SwapMarketplace::~SwapMarketplace() {}
 
 
 NextStateRespond SwapMarketplace::execute() {
@@ -419,24 +548,10 @@ QVector<MktSwapOffer> SwapMarketplace::getMarketOffers(double minFeeLevel, int s
     QString myTorAddress = util::extractPubKeyFromAddress(context->wallet->getTorAddress());
     int64_t curTime = QDateTime::currentSecsSinceEpoch();
 
-    QVector<MktSwapOffer> result;
-    for ( auto & ofr : marketOffers ) {
-        if (ofr.timestamp < timeLimit)
-            continue;
-
-        if (ofr.walletAddress==myTorAddress)
-            continue;
-
-        if (ofr.sell && selling==0)
-            continue;
-        if (!ofr.sell && selling==1)
-            continue;
-
-        if ( ofr.getFeeLevel() >= minFeeLevel && (currency.isEmpty() || currency==ofr.secondaryCurrency) )
-            result.push_back(ofr);
-    }
+    QVector<MktSwapOffer> result = marketOffers.getOffers(selling, currency, minFeeLevel, timeLimit, myTorAddress);
 
-    if (!myTorAddress.isEmpty()) {
+    if (!myTorAddress.isEmpty() && !myOffers.isEmpty()) {
+        const int mktOffersNum = result.size();
         for (auto &mo : myOffers) {
                 MktSwapOffer offer = mo.offer;
                 offer.walletAddress = myTorAddress;
@@ -444,37 +559,29 @@ QVector<MktSwapOffer> SwapMarketplace::getMarketOffers(double minFeeLevel, int s
                 offer.timestamp = curTime;
                 result.push_back(offer);
         }
-    }
 
-    if (selling == 1)
-        std::sort( result.begin(), result.end(), []( const MktSwapOffer & o1, const MktSwapOffer & o2 ) {
-            return o1.calcRate() > o2.calcRate();
-        } );
-    else
-        std::sort( result.begin(), result.end(), []( const MktSwapOffer & o1, const MktSwapOffer & o2 ) {
-            return o1.calcRate() < o2.calcRate();
-        } );
+        // Market offers are sorted, my offers need to be merged into them
+        auto rateCmp = [selling]( const MktSwapOffer & o1, const MktSwapOffer & o2 ) {
+            return selling == 1 ? o1.calcRate() > o2.calcRate() : o1.calcRate() < o2.calcRate();
+        };
+        std::sort( result.begin() + mktOffersNum, result.end(), rateCmp );
+        std::inplace_merge( result.begin(), result.begin() + mktOffersNum, result.end(), rateCmp );
+    }
 
     return result;
 }
 
 MktSwapOffer SwapMarketplace::getMarketOffer(QString offerId, QString walletAddress) const {
     QString key = walletAddress + "_" + offerId;
-    return marketOffers.value(key);
+    return marketOffers.getOffer(key);
 }
 
 
 // All marketplace offers that are published buy currency. Sorted by largest number
 QVector<QPair<QString,int>> SwapMarketplace::getTotalOffers() {
-    QHash<QString, int> offers;
-    for ( auto & mo : marketOffers ) {
-        offers.insert( mo.secondaryCurrency, offers.value(mo.secondaryCurrency, 0) + 1);
-    }
-
-    QVector<QPair<QString,int>> result;
-    for (auto oi = offers.begin(); oi!=offers.end(); oi++)
-        result.push_back( QPair<QString,int>(oi.key(), oi.value()) );
+    cleanMarketOffers();
 
+    QVector<QPair<QString,int>> result = marketOffers.getOffersNumber();
     std::sort( result.begin(), result.end(), [](const QPair<QString,int> &o1, const QPair<QString,int> &o2) {
         return o1.second > o2.second;
     } );
@@ -881,12 +988,7 @@ void SwapMarketplace::respReceiveMessages(QString error, QVector<wallet::Receive
     if (myTorAddress.isEmpty())
         return;
 
-    QVector<QString> startMsgIds;
-    for (auto & offer : marketOffers) {
-        startMsgIds.push_back(offer.walletAddress + "_" + offer.id);
-    }
-    std::sort(startMsgIds.begin(), startMsgIds.end());
-
+    int newOffers = 0;
     int64_t curTime = QDateTime::currentSecsSinceEpoch();
     int64_t expiredTime = curTime - OFFER_PUBLISHING_INTERVAL_SEC * 2;
 
@@ -921,19 +1023,13 @@ void SwapMarketplace::respReceiveMessages(QString error, QVector<wallet::Receive
         offer.timestamp = m.timestamp;
 
         // Updating this offer
-        QString key = offer.getKey();
-        marketOffers.insert(key, offer);
+        if (marketOffers.updateOffer(offer))
+            newOffers++;
     }
-    cleanMarketOffers();
-
-    QVector<QString> endMsgIds;
-    for (auto & offer : marketOffers) {
-        endMsgIds.push_back(offer.walletAddress + "_" + offer.id);
-    }
-    std::sort(endMsgIds.begin(), endMsgIds.end());
+    int removedOffers = cleanMarketOffers();
 
     // Emit change only if datta was changed because of UI.
-    if (startMsgIds != endMsgIds) {
+    if (newOffers > 0 || removedOffers > 0) {
         emit onMarketPlaceOffersChanged();
     }
 
@@ -1014,21 +1110,10 @@ void SwapMarketplace::pageFeeTransactions() {
     context->stateMachine->notifyAboutNewState(STATE::SWAP_MKT);
 }
 
-void SwapMarketplace::cleanMarketOffers() {
-    int64_t curTime = QDateTime::currentSecsSinceEpoch();
-    if (curTime - OFFER_PUBLISHING_INTERVAL_SEC < lastMarketOffersCleaning)
-        return;
-
-    lastMarketOffersCleaning = curTime;
-    // Removing all records with expired time
-    int64_t expiredTime = curTime - OFFER_PUBLISHING_INTERVAL_SEC * 2;
-
-    QMutableHashIterator<QString, MktSwapOffer> i(marketOffers);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().timestamp < expiredTime)
-            i.remove();
-    }
+int SwapMarketplace::cleanMarketOffers() {
+    // Removing all records with expired time. Order book touch only expired ones, no need to throttle
+    int64_t expiredTime = QDateTime::currentSecsSinceEpoch() - OFFER_PUBLISHING_INTERVAL_SEC * 2;
+    return marketOffers.removeExpired(expiredTime);
 }
 
 void SwapMarketplace::onNewMktMessage(int messageId, QString wallet_tor_address, QString offer_id) {
@@ -1066,7 +1151,7 @@ bool SwapMarketplace::acceptMarketplaceOffer(QString offerId, QString walletAddr
     if ( !getSwap()->verifyBackupDir() )
         return false;
 
-    MktSwapOffer mktOffer = marketOffers.value(key);
+    MktSwapOffer mktOffer = marketOffers.getOffer(key);
     if (mktOffer.isEmpty()) {
         core::getWndManager()->messageTextDlg("Error", "Unfortunately you can't accept offer from "+walletAddress+". It is not on the market any more.");
         return false;
@@ -1099,7 +1184,7 @@ void SwapMarketplace::onSendMarketplaceMessage(QString error, QString response,
 
     QString key = walletAddress + "_" + offerId;
 
-    MktSwapOffer mktOffer = marketOffers.value(key);
+    MktSwapOffer mktOffer = marketOffers.getOffer(key);
     if (mktOffer.isEmpty()) {
         core::getWndManager()->messageTextDlg("Error",
                                               "Unfortunately you can't accept offer from " + walletAddress +
@@ -19,11 +19,9 @@
 #include "../wallet/wallet.h"
 #include <QJsonObject>
 #include <QHash>
+#include <QMap>
 #include <QSet>
-
-namespace core {
-class TimerThread;
-}
+#include <set>
 
 namespace state {
 
@@ -84,6 +82,42 @@ struct MktSwapOffer {
     double  calcRate() const;
 };
 
+// Marketplace offers from other wallets, indexed for the queries.
+// Every currency and side has its own book sorted by rate, so a query reads only the matching offers
+// and the best price is at the book edge. Expiration is handled by the wheel of timestamp slots,
+// only the expired slots are touched.
+class MktOrderBook {
+public:
+    MktOrderBook() = default;
+
+    // Add a new offer or update exist one. Return true if offer is new
+    bool updateOffer(const MktSwapOffer & offer);
+    // Remove offers with timestamp older than expiredTime. Return number of removed offers
+    int removeExpired(int64_t expiredTime);
+
+    int size() const {return offers.size();}
+    // Key: <wallet>_<id>. Empty offer if not found
+    MktSwapOffer getOffer(const QString & key) const {return offers.value(key);}
+
+    // Offers with timestamp not older than timeLimit, sorted by rate: descending for sell, ascending for others
+    // selling: 0 - buy, 1-sell, 2 - all
+    // currency: empty value for all
+    QVector<MktSwapOffer> getOffers(int selling, const QString & currency, double minFeeLevel,
+                                    int64_t timeLimit, const QString & excludeWalletAddress) const;
+    // Number of offers per currency
+    QVector<QPair<QString,int>> getOffersNumber() const;
+
+private:
+    typedef std::set<std::pair<double, QString>> Book; // <rate, offer key>
+
+    void removeOffer(const QString & key);
+
+private:
+    QHash<QString, MktSwapOffer> offers; // Key: <wallet>_<id>
+    QMap<QString, Book> books[2]; // index: sell. Key: currency
+    QMap<int64_t, QSet<QString>> expiryWheel; // Key: timestamp slot
+};
+
 enum class OFFER_STATUS { PENDING=1, STARTING=2, RUNNING=3 };
 
 struct MySwapOffer {
@@ -209,7 +243,8 @@ protected:
     void updateIntegrityFeesAndStart();
     //void startBroadcastMessages( QVector<wallet::IntegrityFees> fees );
 
-    void cleanMarketOffers();
+    // Return number of removed offers
+    int cleanMarketOffers();
 
     // Restore my swap offers.
     void restoreMySwapTrades();
@@ -264,12 +299,9 @@ slots:
     // Response from sendMarketplaceMessage
     void onSendMarketplaceMessage(QString error, QString response, QString offerId, QString walletAddress, QString cookie);
 private:
-    core::TimerThread * timer = nullptr;
     Swap * swap = nullptr;
 
-    // Key: <wallet>_<id>
-    QHash<QString, MktSwapOffer> marketOffers;
-    int64_t lastMarketOffersCleaning = 0;
+    MktOrderBook marketOffers;
     QVector<MySwapOffer>    myOffers;
 
     QSet<QString> acceptedOffers;
@@ -23,12 +23,23 @@
 #include <QDateTime>
 #include "../bridge/wnd/swap_b.h"
 #include <QThread>
-#include "../core/TimerThread.h"
+#include "../core/Scheduler.h"
 #include "s_mktswap.h"
 #include <QDir>
+#include <algorithm>
+#include <limits>
 
 namespace state {
 
+// Auto swap steps scheduling.
+// Steps for different trades are queued to the wallet together, wallet executes them without waiting for the timer.
+const int     SWAP_MAX_PARALLEL_STEPS = 4;
+const int64_t SWAP_STEP_MIN_PERIOD_MS = 5000;     // Period for the trade that just did nothing
+const int64_t SWAP_STEP_MAX_PERIOD_MS = 60000;    // Backoff limit
+const int64_t SWAP_STEP_URGENT_PERIOD_MS = 10000; // Backoff limit if deadline is close
+const int64_t SWAP_DEADLINE_URGENT_SEC = 30*60;
+const int64_t SWAP_STEP_STALE_MS = 10*60*1000;    // Step that is running longer is considered as lost
+
 struct SecCurrencyInfo {
     QString currency;
     int     blockIntervalSec;
@@ -110,19 +121,15 @@ Swap::Swap(StateContext * context) :
     // You get an offer to swap BCH to MWC. SwapID is ffa15dbd-85a9-4fc9-a3c0-4cfdb144862b
     // Listen to a new swaps...
 
-    timer = new core::TimerThread(this, 1000);
-    QObject::connect( timer, &core::TimerThread::onTimerEvent, this, &Swap::onTimerEvent, Qt::QueuedConnection );
-    timer->start();
+    // Trades are processed only while there are some, the job is activated when a trade starts
+    swapJobId = core::getScheduler()->addPeriodicJob("Swap", 1000, this, [this]() {onTimerEvent();}, false);
+    // Fees are refreshed once in 15 minutes, checking them every minute is good enough
+    core::getScheduler()->addPeriodicJob("SwapFees", 60*1000, this, [this]() {updateFeesIsNeeded();});
 
     updateFeesIsNeeded();
 }
 
-Swap::~Swap() {
-    timer->stop();
-    timer->wait();
-
-    delete timer;
-}
+Swap::~Swap() {}
 
 NextStateRespond Swap::execute() {
     selectedPage = SwapWnd::None;
@@ -184,16 +191,28 @@ void Swap::runTrade(QString swapId, QString tag, bool isSeller, QString statusCm
     if (swapId.isEmpty())
         return;
 
+    auto running = runningSwaps.find(swapId);
+    if (running != runningSwaps.end()) {
+        // Keep the step and scheduling state, the step might be in progress
+        running->tag = tag;
+        running->isSeller = isSeller;
+        running->stateCmd = statusCmd;
+        running->nextStepTimeMs = 0;
+        return;
+    }
+
     AutoswapTask task;
     task.setData(swapId, tag, isSeller, statusCmd, 0);
     runningSwaps.insert(swapId, task);
+    core::getScheduler()->setJobActive(swapJobId, true);
 }
 
 void Swap::onTimerEvent() {
-    updateFeesIsNeeded();
-
-    if (runningSwaps.isEmpty() || !runningTask.isEmpty())
+    if (runningSwaps.isEmpty()) {
+        // Nothing to process until the next trade
+        core::getScheduler()->setJobActive(swapJobId, false);
         return;
+    }
 
     int64_t curMsec = QDateTime::currentMSecsSinceEpoch();
     if (curMsec-lastProcessedTimerData < 500)
@@ -201,50 +220,126 @@ void Swap::onTimerEvent() {
 
     lastProcessedTimerData = curMsec;
 
-    int64_t curTime = curMsec/1000;
+    // Steps that never finished. Wallet was restarted or respond was lost, the trade can be scheduled again
+    for (auto i = runningSwaps.begin(); i != runningSwaps.end(); ++i) {
+        if (i->isStepRunning() && curMsec - i->stepStartedMs > SWAP_STEP_STALE_MS) {
+            logger::logInfo("SWAP", "Swap step for " + i->swapId + " didn't finish in time, rescheduling");
+            runningSteps.remove(i->swapId);
+            i->stepStartedMs = 0;
+            scheduleNextStep(i.value(), false);
+        }
+    }
 
-    AutoswapTask nextTask;
-    nextTask.lastUpdatedTime = curTime;
+    if (runningSteps.size() >= SWAP_MAX_PARALLEL_STEPS)
+        return;
 
-    for ( auto i = runningSwaps.constBegin(); i != runningSwaps.constEnd(); ++i ) {
-        if ( i.value().lastUpdatedTime < nextTask.lastUpdatedTime ) {
-            nextTask = i.value();
-        }
+    // Ready trades, the nearest deadline goes first. Trades with unknown deadline go last, by the waiting time
+    QVector<AutoswapTask*> ready;
+    for (auto i = runningSwaps.begin(); i != runningSwaps.end(); ++i) {
+        if (!i->isStepRunning() && i->nextStepTimeMs <= curMsec)
+            ready.push_back(&i.value());
     }
+    if (ready.isEmpty())
+        return;
 
-    // Let's run every 60 seconds, it should be enough
-    if (curTime - nextTask.lastUpdatedTime > 60) {
-        // starting the task
-        runningSwaps[nextTask.swapId].lastUpdatedTime = curTime;
+    std::sort(ready.begin(), ready.end(), [](const AutoswapTask * t1, const AutoswapTask * t2) {
+        int64_t d1 = t1->deadline>0 ? t1->deadline : std::numeric_limits<int64_t>::max();
+        int64_t d2 = t2->deadline>0 ? t2->deadline : std::numeric_limits<int64_t>::max();
+        if (d1 != d2)
+            return d1 < d2;
+        return t1->nextStepTimeMs < t2->nextStepTimeMs;
+    });
 
-        // Let's check if the backup is needed..
-        int taskBkId = bridge::getSwapBackup(nextTask.stateCmd);
-        int expBkId = context->appContext->getSwapBackStatus(nextTask.swapId);
-        if (taskBkId > expBkId) {
-                // Note, we are in the eventing loop, so modal will create a new one and soon timer will be called!!!
+    for (AutoswapTask * task : ready) {
+        if (runningSteps.size() >= SWAP_MAX_PARALLEL_STEPS)
+            break;
+        if (!startSwapStep(*task))
+            continue; // Backup is requested for this trade, others can run
+    }
 
-                QString backupDir = context->appContext->getSwapBackupDir();
-                // QDir::separator does return value that rust doesn't understand well. That will be corrected but still it looks bad.
-                QString backupFn = backupDir + "/trade_" + nextTask.swapId + "_" + QString::number(taskBkId) + ".trade";
-                context->wallet->backupSwapTradeData(nextTask.swapId, backupFn);
+    lastProcessedTimerData = QDateTime::currentMSecsSinceEpoch();
+}
 
-                // continue on onBackupSwapTradeData
-                return;
-        }
+bool Swap::startSwapStep(AutoswapTask & task) {
+    const int64_t curMsec = QDateTime::currentMSecsSinceEpoch();
+    task.lastUpdatedTime = curMsec/1000;
+
+    // Let's check if the backup is needed..
+    int taskBkId = bridge::getSwapBackup(task.stateCmd);
+    int expBkId = context->appContext->getSwapBackStatus(task.swapId);
+    if (taskBkId > expBkId) {
+        // Waiting for the backup, onBackupSwapTradeData will reschedule the trade
+        task.nextStepTimeMs = curMsec + SWAP_STEP_MAX_PERIOD_MS;
 
-        runningTask = nextTask.swapId;
+        QString backupDir = context->appContext->getSwapBackupDir();
+        // QDir::separator does return value that rust doesn't understand well. That will be corrected but still it looks bad.
+        QString backupFn = backupDir + "/trade_" + task.swapId + "_" + QString::number(taskBkId) + ".trade";
+        context->wallet->backupSwapTradeData(task.swapId, backupFn);
 
-        bool waiting4backup = /*context->appContext->getSwapEnforceBackup() &&*/ expBkId==0;
-        logger::logInfo( "SWAP", "Swap processing step for " + nextTask.swapId + ", " + nextTask.stateCmd + " ,waiting4backup=" + (waiting4backup?"true":"false") );
-        context->wallet->performAutoSwapStep(nextTask.swapId, waiting4backup);
+        // continue on onBackupSwapTradeData
+        return false;
     }
-    lastProcessedTimerData = QDateTime::currentMSecsSinceEpoch();
+
+    task.stepStartedMs = curMsec;
+    runningSteps.insert(task.swapId);
+
+    bool waiting4backup = /*context->appContext->getSwapEnforceBackup() &&*/ expBkId==0;
+    logger::logInfo( "SWAP", "Swap processing step for " + task.swapId + ", " + task.stateCmd + " ,waiting4backup=" + (waiting4backup?"true":"false") +
+                     ", running steps: " + QString::number(runningSteps.size()) );
+    context->wallet->performAutoSwapStep(task.swapId, waiting4backup);
+    return true;
+}
+
+void Swap::scheduleNextStep(AutoswapTask & task, bool progressed) {
+    const int64_t curMsec = QDateTime::currentMSecsSinceEpoch();
+
+    if (progressed) {
+        // process to the next step now (Backup need to be asked quickly)
+        task.idleSteps = 0;
+        task.nextStepTimeMs = 0;
+        return;
+    }
+
+    // Nothing happens, waiting longer every time
+    int64_t period = SWAP_STEP_MIN_PERIOD_MS << std::min(task.idleSteps, 8);
+    period = std::min(period, SWAP_STEP_MAX_PERIOD_MS);
+    task.idleSteps++;
+
+    // Close to the deadline, the trade must be checked more often
+    if (task.deadline>0 && task.deadline - curMsec/1000 < SWAP_DEADLINE_URGENT_SEC)
+        period = std::min(period, SWAP_STEP_URGENT_PERIOD_MS);
+
+    task.nextStepTimeMs = curMsec + period;
+}
+
+// static
+void Swap::updateDeadline(AutoswapTask & task) {
+    const int64_t curTime = QDateTime::currentSecsSinceEpoch();
+    task.deadline = 0;
+    for (int64_t time : {task.mwcLockTime, task.secondaryLockTime, task.expirationTime, task.planStepEndTime}) {
+        // Times in the past are not a deadline any more
+        if (time > curTime && (task.deadline == 0 || time < task.deadline))
+            task.deadline = time;
+    }
+}
+
+int64_t Swap::getTradeStepLatencyMs(const QString & swapId) const {
+    auto i = runningSwaps.find(swapId);
+    return i==runningSwaps.end() ? -1 : i->lastStepLatencyMs;
+}
+
+int64_t Swap::getTradeAvgStepLatencyMs(const QString & swapId) const {
+    auto i = runningSwaps.find(swapId);
+    return i==runningSwaps.end() ? -1 : i->avgStepLatencyMs;
 }
 
 void Swap::onBackupSwapTradeData(QString swapId, QString exportedFileName, QString errorMessage) {
     // accepting in any case
-    if (runningSwaps.contains(swapId))
-        runningSwaps[swapId].lastUpdatedTime = 0; // to trigger processing and update
+    if (runningSwaps.contains(swapId)) {
+        // to trigger processing and update
+        runningSwaps[swapId].lastUpdatedTime = 0;
+        runningSwaps[swapId].nextStepTimeMs = 0;
+    }
 
     if (!errorMessage.isEmpty()) {
         pageTradeList(false, false, true);
@@ -254,7 +349,7 @@ void Swap::onBackupSwapTradeData(QString swapId, QString exportedFileName, QStri
     }
     else {
         // Updating backup id that is done.
-        int taskBkId = bridge::getSwapBackup( runningSwaps[swapId].stateCmd );
+        int taskBkId = bridge::getSwapBackup( runningSwaps.value(swapId).stateCmd );
         context->appContext->setSwapBackStatus(swapId, taskBkId);
     }
 }
@@ -280,23 +375,46 @@ void Swap::onPerformAutoSwapStep(QString swapId, QString stateCmd, QString curre
         }
     }
 
-    if (swapId != runningTask)
+    if (!runningSteps.remove(swapId))
         return;
 
-    runningTask = "";
+    auto task = runningSwaps.find(swapId);
+    if (task != runningSwaps.end() && task->isStepRunning()) {
+        task->lastStepLatencyMs = QDateTime::currentMSecsSinceEpoch() - task->stepStartedMs;
+        task->avgStepLatencyMs = task->avgStepLatencyMs < 0 ? task->lastStepLatencyMs :
+                                 (task->avgStepLatencyMs*3 + task->lastStepLatencyMs) / 4;
+        task->stepStartedMs = 0;
+        logger::logInfo( "SWAP", "Swap step for " + swapId + " is finished in " + QString::number(task->lastStepLatencyMs) + " ms" );
+    }
 
     // Running task is executed, let's update it
     if (!error.isEmpty()) {
         //core::getWndManager()->messageTextDlg("Swap Processing Error", "Autoswap step is failed for swap " + swapId + "\n\n" + error );
+        if (task != runningSwaps.end())
+            scheduleNextStep(task.value(), false);
         emit onSwapTradeStatusUpdated( swapId, stateCmd, currentAction, currentState, error, executionPlan, tradeJournal);
         return;
     }
 
-    if (runningSwaps.contains(swapId)) {
-        if (runningSwaps[swapId].stateCmd != stateCmd) {
-            runningSwaps[swapId].stateCmd = stateCmd;
-            runningSwaps[swapId].lastUpdatedTime = 0; // process to the next step now (Backup need to be asked quickly)
+    if (task != runningSwaps.end()) {
+        bool progressed = task->stateCmd != stateCmd;
+        if (progressed) {
+            task->stateCmd = stateCmd;
+            task->lastUpdatedTime = 0;
+        }
+
+        // Next step of the execution plan is the deadline for the trade, lock times are kept
+        task->planStepEndTime = 0;
+        const int64_t curTime = QDateTime::currentSecsSinceEpoch();
+        for (const auto & planRecord : executionPlan) {
+            if (planRecord.end_time > curTime) {
+                task->planStepEndTime = planRecord.end_time;
+                break;
+            }
         }
+        updateDeadline(task.value());
+
+        scheduleNextStep(task.value(), progressed);
     }
 
     if ( bridge::isSwapDone(stateCmd)) {
@@ -319,8 +437,13 @@ void Swap::onNewSwapTrade(QString currency, QString swapId) {
 
 void Swap::onNewSwapMessage(QString swapId) {
     // Let's try to process now
-    if (runningSwaps.contains(swapId))
-        runningSwaps[swapId].lastUpdatedTime = 0; // next tick will be ours to move forward
+    if (runningSwaps.contains(swapId)) {
+        // next tick will be ours to move forward
+        AutoswapTask & task = runningSwaps[swapId];
+        task.lastUpdatedTime = 0;
+        task.nextStepTimeMs = 0;
+        task.idleSteps = 0;
+    }
 }
 
 // Response from requestTradeDetails
@@ -334,6 +457,14 @@ void Swap::onRequestTradeDetails( wallet::SwapTradeInfo swap,
     Q_UNUSED(currentAction)
     Q_UNUSED(tradeJournal)
 
+    // Any details request bring the lock times, they are the trade deadlines
+    if (error.isEmpty() && runningSwaps.contains(swap.swapId)) {
+        AutoswapTask & task = runningSwaps[swap.swapId];
+        task.mwcLockTime = swap.mwcLockTime;
+        task.secondaryLockTime = swap.secondaryLockTime;
+        updateDeadline(task);
+    }
+
     if (cookie != "NewSwapTrade" )
         return;
 
@@ -801,6 +932,8 @@ void Swap::onCreateNewSwapTrade(QString tag, bool dryRun, QVector<QString> param
 void Swap::onCancelSwapTrade(QString swapId, QString error) {
     if (error.isEmpty()) {
        runningSwaps.remove(swapId);
+       // Respond for its step might never come, the slot must be released
+       runningSteps.remove(swapId);
     }
 }
 
@@ -810,6 +943,7 @@ void Swap::onRestoreSwapTradeData(QString swapId, QString importedFilename, QStr
         AutoswapTask task;
         task.setData(swapId, "", true, "", 0);
         runningSwaps.insert(swapId, task);
+        core::getScheduler()->setJobActive(swapJobId, true);
     }
 }
 
@@ -977,6 +1111,7 @@ void Swap::onLogout() {
     if (!runningSwaps.isEmpty()) {
         int sz = runningSwaps.size();
         runningSwaps.clear();
+        runningSteps.clear();
         core::getWndManager()->messageTextDlg("WARNING",
                       QString::number(sz) + " swap trade(s) were cancelled because of a logout during the swap. Please log into your wallet as quickly as possible. "
                       "If this wallet is not active when the swap trade finishes the cancellation process, you may lose all coins involved in this transaction.");
@@ -991,8 +1126,12 @@ void Swap::runSwapIfNeed(const wallet::SwapInfo & sw) {
     if (bridge::isSwapWatingToAccept(sw.stateCmd))
         need2accept = !context->appContext->isTradeAccepted(sw.swapId);
 
-    if (!bridge::isSwapDone(sw.stateCmd) && !need2accept)
+    if (!bridge::isSwapDone(sw.stateCmd) && !need2accept) {
         runTrade(sw.swapId, sw.tag, sw.isSeller, sw.stateCmd);
+        AutoswapTask & task = runningSwaps[sw.swapId];
+        task.expirationTime = sw.expiration;
+        updateDeadline(task);
+    }
 }
 
 // Response from requestSwapTrades
@@ -1025,6 +1164,8 @@ void Swap::onRequestSwapTrades(QString cookie, QVector<wallet::SwapInfo> swapTra
         for (const wallet::SwapInfo & sw : swapTrades) {
             if (bridge::isSwapDone(sw.stateCmd)) {
                 runningSwaps.remove(sw.swapId);
+                // Respond for its step might never come, the slot must be released
+                runningSteps.remove(sw.swapId);
             }
             else {
                 runSwapIfNeed(sw);
@@ -1041,6 +1182,7 @@ void Swap::onRequestSwapTrades(QString cookie, QVector<wallet::SwapInfo> swapTra
 
     // Now starting the swaps
     runningSwaps.clear();
+    runningSteps.clear();
 
     for (const wallet::SwapInfo & sw : swapTrades) {
         runSwapIfNeed(sw);
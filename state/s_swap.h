@@ -19,14 +19,11 @@
 #include "../wallet/wallet.h"
 #include <QMap>
 #include <QHash>
+#include <QSet>
 #include "../util/httpclient.h"
 #include <QThread>
 #include "s_mktswap.h"
 
-namespace core {
-class TimerThread;
-}
-
 namespace state {
 
 struct AutoswapTask {
@@ -36,7 +33,21 @@ struct AutoswapTask {
     QString stateCmd;
     int64_t lastUpdatedTime = 0;
 
+    // Scheduling data
+    int64_t nextStepTimeMs = 0; // Time when the next step can run. 0 - as soon as possible
+    int64_t deadline = 0;       // Nearest deadline of the trade (lock time or execution plan step end), seconds. 0 - unknown
+    int64_t mwcLockTime = 0;    // Lock times from the trade details, seconds. 0 - unknown
+    int64_t secondaryLockTime = 0;
+    int64_t expirationTime = 0; // Trade expiration from the trades list, seconds. 0 - unknown
+    int64_t planStepEndTime = 0; // End of the current execution plan step, seconds. 0 - unknown
+    int     idleSteps = 0;      // Number of the steps in a row that didn't change the trade state. Used for backoff
+    int64_t stepStartedMs = 0;  // Running step start time. 0 - step is not running
+    int64_t lastStepLatencyMs = -1; // Duration of the last step
+    int64_t avgStepLatencyMs = -1;  // Moving average of the step duration
+
     void setData(QString _swapId, QString _tag, bool _isSeller, QString _stateCmd, int64_t _lastUpdatedTime) { swapId=_swapId; tag=_tag; isSeller=_isSeller; stateCmd=_stateCmd; lastUpdatedTime=_lastUpdatedTime; }
+
+    bool isStepRunning() const {return stepStartedMs>0;}
 };
 
 enum class SwapWnd {None, PageSwapList, PageSwapEdit, PageSwapTradeDetails, PageSwapNew1, PageSwapNew2, PageSwapNew3 };
@@ -61,6 +72,11 @@ public:
     QVector<QString> getRunningTrades() const;
     QVector<QString> getRunningCriticalTrades() const;
 
+    // Duration of the last auto swap step for the trade, ms. -1 if no steps was done yet.
+    int64_t getTradeStepLatencyMs(const QString & swapId) const;
+    // Moving average of the auto swap step duration for the trade, ms. -1 if no steps was done yet.
+    int64_t getTradeAvgStepLatencyMs(const QString & swapId) const;
+
     // Reset the new trade data and switch to the first page.
     void initiateNewTrade();
     // Show the trade page 1
@@ -203,6 +219,13 @@ private:
 
     void runSwapIfNeed(const wallet::SwapInfo & sw);
 
+    // Start auto swap step for the trade. Return false if backup was requested instead.
+    bool startSwapStep(AutoswapTask & task);
+    // Plan the next step for the trade that just finished the step. progressed - trade state was changed
+    void scheduleNextStep(AutoswapTask & task, bool progressed);
+    // Update trade deadline with the nearest lock or plan step time in the future
+    static void updateDeadline(AutoswapTask & task);
+
 private
 slots:
     // Login/logot from the wallet. Need to start/stop swaps
@@ -245,11 +268,11 @@ slots:
 
     void onSendMarketplaceMessage(QString error, QString response, QString offerId, QString walletAddress, QString cookie);
 private:
-    core::TimerThread * timer = nullptr;
-
     // Key: swapId,  Value: running Task
     QMap<QString, AutoswapTask> runningSwaps;
-    QString  runningTask;
+    int swapJobId = 0; // Scheduler job that runs the trades, active while runningSwaps is not empty
+    // Trades with auto swap steps in progress
+    QSet<QString> runningSteps;
 
     // key: message.  value: time
     QHash<QString, int64_t> shownMessages;
@@ -38,6 +38,7 @@
 #include "../bridge/BridgeManager.h"
 #include "../bridge/corewindow_b.h"
 #include "../core/WndManager.h"
+#include "../core/Scheduler.h"
 #include "x_migration.h"
 #include "z_wallethome.h"
 #include "z_walletsettings.h"
@@ -109,7 +110,7 @@ StateMachine::StateMachine()
     states[ STATE::SWAP ] = new Swap(context);
     states[ STATE::SWAP_MKT ] = new SwapMarketplace(context);
 
-    startTimer(1000);
+    core::getScheduler()->addPeriodicJob("Logout", 1000, this, [this]() {checkLogoutTime();});
 }
 
 StateMachine::~StateMachine() {
@@ -314,9 +315,7 @@ bool StateMachine::processState(State* st) {
     return false;
 }
 
-void StateMachine::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event)
-
+void StateMachine::checkLogoutTime() {
     // No locking make sense for the node.
     if (config::isOnlineNode())
         return;
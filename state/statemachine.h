@@ -77,7 +77,7 @@ private:
     // routine to process state into the loop
     bool processState(State* st);
 
-    virtual void timerEvent(QTimerEvent *event) override;
+    void checkLogoutTime();
 
     bool isLogoutOff( STATE state ) const { return state < STATE::ACCOUNTS || state==STATE::RESYNC; }
 
@@ -20,6 +20,7 @@
 #include "../util/Log.h"
 #include "../core/global.h"
 #include "../core/Notification.h"
+#include "../core/Scheduler.h"
 #include "../node/MwcNode.h"
 #include "../node/MwcNodeConfig.h"
 #include "../util/FolderCompressor.h"
@@ -28,6 +29,7 @@
 #include "../bridge/BridgeManager.h"
 #include "../bridge/wnd/u_nodeInfo_b.h"
 #include <QDir>
+#include <memory>
 
 namespace state {
 
@@ -54,6 +56,8 @@ NodeInfo::NodeInfo(StateContext * _context) :
                      this, &NodeInfo::onNodeStatus, Qt::QueuedConnection);
     QObject::connect(context->wallet, &wallet::Wallet::onLoginResult,
                      this, &NodeInfo::onLoginResult, Qt::QueuedConnection);
+    QObject::connect(context->wallet, &wallet::Wallet::onLogout,
+                     this, &NodeInfo::onLogout, Qt::QueuedConnection);
 
     QObject::connect(context->mwcNode, &node::MwcNode::onMwcStatusUpdate,
                      this, &NodeInfo::onMwcStatusUpdate, Qt::QueuedConnection);
@@ -61,8 +65,8 @@ NodeInfo::NodeInfo(StateContext * _context) :
     QObject::connect(context->wallet, &wallet::Wallet::onSubmitFile,
                      this, &NodeInfo::onSubmitFile, Qt::QueuedConnection);
 
-    // Checking/update node status every 20 seconds...
-    startTimer(3000); // Let's update node info every 60 seconds. By some reasons it is slow operation...
+    // Base period is 3 seconds, the real update rate depends on the node state. Suspended until login.
+    nodeInfoJobId = core::getScheduler()->addPeriodicJob("NodeInfo", 3000, this, [this]() {onNodeInfoTimer();}, false);
 }
 
 NodeInfo::~NodeInfo() {
@@ -97,13 +101,16 @@ void NodeInfo::onLoginResult(bool ok) {
         lastLocalNodeStatus = "Waiting";
         requestNodeInfo();
         justLogin = true;
+        core::getScheduler()->setJobActive(nodeInfoJobId, true);
     }
 }
 
+void NodeInfo::onLogout() {
+    core::getScheduler()->setJobActive(nodeInfoJobId, false);
+}
 
-void NodeInfo::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event)
 
+void NodeInfo::onNodeInfoTimer() {
     timerCounter++;
 
     // Don't request for init or lock states.
@@ -220,6 +227,19 @@ void NodeInfo::onMwcStatusUpdate( QString status ) {
         b->updateEmbeddedMwcNodeStatus(getMwcNodeStatus());
 }
 
+// Node is stopped during the export/import, so progress is shown as the embedded node status
+static compress::ProgressCallback nodeDataProgress(const QString & operation) {
+    std::shared_ptr<int> lastPercent = std::make_shared<int>(-1);
+    return [operation, lastPercent](qint64 processed, qint64 total) {
+        int percent = total > 0 ? int(processed * 100 / total) : 100;
+        if (percent == *lastPercent)
+            return;
+        *lastPercent = percent;
+        for (auto b : bridge::getBridgeManager()->getNodeInfo())
+            b->updateEmbeddedMwcNodeStatus(operation + ", " + QString::number(percent) + "%");
+    };
+}
+
 void NodeInfo::exportBlockchainData(QString fileName) {
     // 1. stop the mwc node
     // 2. Export node data
@@ -242,7 +262,8 @@ void NodeInfo::exportBlockchainData(QString fileName) {
 
     QCoreApplication::processEvents();
 
-    QPair<bool, QString> res = compress::compressFolder( nodePath.second + "chain_data/", fileName, network );
+    QPair<bool, QString> res = compress::compressFolder( nodePath.second + "chain_data/", fileName, network,
+            true, nodeDataProgress("Exporting blockchain data") );
 
     QCoreApplication::processEvents();
 
@@ -286,7 +307,8 @@ void NodeInfo::importBlockchainData(QString fileName) {
 
     QCoreApplication::processEvents();
 
-    QPair<bool, QString> res = compress::decompressFolder( fileName,  nodePath.second + "chain_data/", network );
+    QPair<bool, QString> res = compress::decompressFolder( fileName,  nodePath.second + "chain_data/", network,
+            true, nodeDataProgress("Importing blockchain data") );
 
     QCoreApplication::processEvents();
 
@@ -69,6 +69,7 @@ protected:
 
 private slots:
     void onLoginResult(bool ok);
+    void onLogout();
 
     void onNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, int64_t totalDifficulty, int connections );
 
@@ -77,12 +78,13 @@ private slots:
     void onSubmitFile(bool success, QString message, QString fileName);
 
 private:
-    virtual void timerEvent(QTimerEvent *event) override;
+    void onNodeInfoTimer();
 private:
     bool  justLogin = false;
     NodeStatus lastNodeStatus; // Satus as mwc713 see the node
     QString lastLocalNodeStatus = "Waiting"; // Status from the embedded node
     int timerCounter = 0; // update is different in different modes.
+    int nodeInfoJobId = 0;
     wallet::MwcNodeConnection currentNodeConnection;
 };
 
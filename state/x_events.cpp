@@ -41,19 +41,19 @@ NextStateRespond Events::execute() {
     for (auto b : bridge::getBridgeManager()->getEvents())
         b->updateNonShownWarnings(false);
 
-    messageWaterMark = QDateTime::currentMSecsSinceEpoch();
+    messageWaterMark = notify::getLastNotificationSeq();
 
     return NextStateRespond( NextStateRespond::RESULT::WAIT_FOR_ACTION );
 }
 
 void Events::eventsWndIsDeleted()
 {
-    messageWaterMark = QDateTime::currentMSecsSinceEpoch();
+    messageWaterMark = notify::getLastNotificationSeq();
 }
 
 // Historical design. UI can call this method now, but not in the past
-QVector<notify::NotificationMessage> Events::getWalletNotificationMessages() {
-    return notify::getNotificationMessages();
+QVector<notify::NotificationMessage> Events::getWalletNotificationMessages(int64_t sinceSeq) {
+    return notify::getNotificationMessages(sinceSeq);
 }
 
 void Events::onNewNotificationMessage(bridge::MESSAGE_LEVEL  level, QString message) {
@@ -72,17 +72,7 @@ void Events::onNewNotificationMessage(bridge::MESSAGE_LEVEL  level, QString mess
 
 // Check if some error/warnings need to be shown
 bool Events::hasNonShownWarnings() const {
-    QVector<notify::NotificationMessage> msgs = notify::getNotificationMessages();
-
-    for ( int i = msgs.size()-1; i>=0; i-- ) {
-        if (msgs[i].time.toMSecsSinceEpoch() <= messageWaterMark )
-            return false;
-
-        if ( msgs[i].isCritical() )
-            return true;
-    }
-
-    return false;
+    return notify::getLastNotificationSeq(bridge::MESSAGE_LEVEL::WARNING) > messageWaterMark;
 }
 
 
@@ -31,7 +31,8 @@ public:
 
     void eventsWndIsDeleted();
 
-    QVector<notify::NotificationMessage> getWalletNotificationMessages();
+    // Messages with sequence number larger than sinceSeq. sinceSeq=0 - all stored messages.
+    QVector<notify::NotificationMessage> getWalletNotificationMessages(int64_t sinceSeq = 0);
 
     // Check if some error/warnings need to be shown
     bool hasNonShownWarnings() const;
@@ -45,7 +46,7 @@ protected:
     virtual bool mobileBack() override {return false;}
     virtual QString getHelpDocName() override {return "event_log.html";}
 private:
-    int64_t         messageWaterMark = 0;
+    int64_t         messageWaterMark = 0; // Sequence number of the last message that user has seen
 };
 
 }
@@ -0,0 +1,179 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testFolderCompressor.h"
+#include "../util/FolderCompressor.h"
+#include <QDir>
+#include <QFile>
+#include <QDirIterator>
+#include <QDataStream>
+#include <QMap>
+
+namespace test {
+
+const static QString ARCHIVE_TAG("Mainnet");
+
+static QString testRoot() {
+    return QDir::tempPath() + "/mwc_test_compressor";
+}
+
+static void writeFile(const QString & fileName, const QByteArray & data) {
+    bool ok = QDir().mkpath(QFileInfo(fileName).absolutePath());
+    Q_ASSERT(ok);
+    QFile f(fileName);
+    ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    Q_ASSERT(ok);
+    const qint64 written = f.write(data);
+    Q_ASSERT(written == data.size());
+}
+
+static QByteArray readFile(const QString & fileName) {
+    QFile f(fileName);
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
+// Relative path -> content. Folders have the empty content and the trailing '/'
+static QMap<QString, QByteArray> readFolder(const QString & folder) {
+    QMap<QString, QByteArray> res;
+    QDir dir(folder);
+    QDirIterator it(folder, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QString name = dir.relativeFilePath(it.filePath());
+        if (it.fileInfo().isDir())
+            res.insert(name + "/", QByteArray());
+        else
+            res.insert(name, readFile(it.filePath()));
+    }
+    return res;
+}
+
+// Data that doesn't compress, so the archive has the same size and every chunk is large
+static QByteArray randomData(int size, quint32 seed) {
+    QByteArray res(size, '\0');
+    for (int i = 0; i < size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        res[i] = char(seed >> 16);
+    }
+    return res;
+}
+
+void testFolderCompressor() {
+    const QString srcDir = testRoot() + "/src";
+    const QString dstDir = testRoot() + "/dst";
+    const QString archive = testRoot() + "/data.mwcdata";
+    QDir(testRoot()).removeRecursively();
+
+    // Larger than two chunks, so there are several chunks in flight
+    writeFile(srcDir + "/chain/large.bin", randomData(9*1024*1024 + 123, 42));
+    writeFile(srcDir + "/chain/empty.bin", QByteArray());
+    writeFile(srcDir + "/chain/nested/deep/small.txt", "small file");
+    writeFile(srcDir + "/root.txt", QByteArray(100000, 'a'));
+    bool ok = QDir().mkpath(srcDir + "/emptyDir");
+    Q_ASSERT(ok);
+    const QMap<QString, QByteArray> srcContent = readFolder(srcDir);
+
+    // Round trip
+    {
+        qint64 lastProcessed = 0, lastTotal = 0;
+        auto res = compress::compressFolder(srcDir, archive, ARCHIVE_TAG, false,
+                [&](qint64 processed, qint64 total) {
+                    Q_ASSERT(processed >= lastProcessed && processed <= total);
+                    lastProcessed = processed;
+                    lastTotal = total;
+                });
+        Q_ASSERT(res.first);
+        Q_ASSERT(lastProcessed == lastTotal && lastTotal == 9*1024*1024 + 123 + 10 + 100000);
+
+        res = compress::decompressFolder(archive, dstDir, ARCHIVE_TAG, false);
+        Q_ASSERT(res.first);
+        Q_ASSERT(readFolder(dstDir) == srcContent);
+    }
+
+    // Resume after the interrupted import: truncated file, leftover part file and a file that is not in the archive
+    {
+        QFile large(dstDir + "/chain/large.bin");
+        ok = large.resize(5*1024*1024);
+        Q_ASSERT(ok);
+        writeFile(dstDir + "/chain/small.txt.mwcpart", "partial");
+        writeFile(dstDir + "/chain/nested/extra.txt", "not in the archive");
+        QFile::remove(dstDir + "/root.txt");
+
+        auto res = compress::decompressFolder(archive, dstDir, ARCHIVE_TAG, false);
+        Q_ASSERT(res.first);
+        Q_ASSERT(readFolder(dstDir) == srcContent);
+    }
+
+    // Wrong tag
+    {
+        auto res = compress::decompressFolder(archive, dstDir, "Floonet", false);
+        Q_ASSERT(!res.first);
+        Q_ASSERT(res.second.contains("Floonet"));
+        Q_ASSERT(readFolder(dstDir) == srcContent);
+    }
+
+    // Corrupted chunk. Most of the archive is the data of the large file.
+    {
+        QByteArray data = readFile(archive);
+        data[data.size() / 2] = char(data[data.size() / 2] ^ 0x5A);
+        const QString brokenArchive = testRoot() + "/broken.mwcdata";
+        writeFile(brokenArchive, data);
+
+        const QString brokenDir = testRoot() + "/broken";
+        auto res = compress::decompressFolder(brokenArchive, brokenDir, ARCHIVE_TAG, false);
+        Q_ASSERT(!res.first);
+        Q_ASSERT(res.second.contains("corrupted"));
+        // Broken file is never completed
+        Q_ASSERT(!QFile::exists(brokenDir + "/chain/large.bin"));
+    }
+
+    // Archive from the previous wallet versions, every file is a single compressed block
+    {
+        const int ARCH_VERSION = 0x9265DB;
+        const int ARCH_DIR_VER = 0x587634;
+        const int ARCH_FILE_VER = 0x823AD1;
+        const int ARCH_END = 0x000100;
+
+        const QString legacyArchive = testRoot() + "/legacy.mwcdata";
+        {
+            QFile file(legacyArchive);
+            ok = file.open(QIODevice::WriteOnly);
+            Q_ASSERT(ok);
+            QDataStream out(&file);
+            out << ARCH_VERSION << ARCHIVE_TAG;
+            out << ARCH_DIR_VER << QString("");
+            out << ARCH_DIR_VER << QString("/chain");
+            out << ARCH_FILE_VER << QString("/chain/block.bin") << qCompress(randomData(300000, 7));
+            out << ARCH_FILE_VER << QString("/chain/empty.bin") << qCompress(QByteArray());
+            out << ARCH_FILE_VER << QString("/root.txt") << qCompress(QByteArray("legacy"));
+            out << ARCH_END;
+        }
+
+        const QString legacyDir = testRoot() + "/legacy";
+        writeFile(legacyDir + "/stale.txt", "removed by the extraction");
+        auto res = compress::decompressFolder(legacyArchive, legacyDir, ARCHIVE_TAG, false);
+        Q_ASSERT(res.first);
+
+        QMap<QString, QByteArray> expected;
+        expected.insert("chain/", QByteArray());
+        expected.insert("chain/block.bin", randomData(300000, 7));
+        expected.insert("chain/empty.bin", QByteArray());
+        expected.insert("root.txt", "legacy");
+        Q_ASSERT(readFolder(legacyDir) == expected);
+    }
+
+    QDir(testRoot()).removeRecursively();
+}
+
+}
@@ -12,32 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifndef MWC_QT_WALLET_TESTFOLDERCOMPRESSOR_H
+#define MWC_QT_WALLET_TESTFOLDERCOMPRESSOR_H
 
-#include "TimerThread.h"
+namespace test {
 
-//////////////////////////////////////////////////////////////
-// Timer thread.
+// Export/import of the node data: round trip, legacy archives, resumed import and corrupted archives.
+void testFolderCompressor();
 
-namespace core {
-
-TimerThread::TimerThread(QObject *parent, long _interval) : QThread(parent), interval(_interval) { alive = true; }
-
-TimerThread::~TimerThread() {}
-
-void TimerThread::stop() {
-    alive = false;
-}
-
-void TimerThread::run() {
-    int k = 0;
-    while (alive) {
-        QThread::msleep(interval / 10);
-        if (k > 10) {
-            emit onTimerEvent();
-            k = 0;
-        }
-        k++;
-    }
 }
 
-}
\ No newline at end of file
+#endif //MWC_QT_WALLET_TESTFOLDERCOMPRESSOR_H
@@ -0,0 +1,153 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testHttpClient.h"
+#include "../util/httpclient.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QEventLoop>
+#include <QTimer>
+#include <QMap>
+#include <QHash>
+#include <QDebug>
+
+namespace test {
+
+class StubHttpClient : public util::HttpClient {
+public:
+    void get(const QString & url, const QString & tag) {
+        sendRequest(HTTP_CALL::GET, url, tag, {"key", "value"}, "", tag + "_p1");
+    }
+    void post(const QString & url, const QString & tag) {
+        sendRequest(HTTP_CALL::POST, url, tag, {"key", "value"}, "{}", tag + "_p1");
+    }
+    void setTtl(const QString & url, int ttlMs) {setResponseTtl(url, ttlMs);}
+    void invalidate(const QString & url) {invalidateResponseCache(url);}
+
+    // Wait until responds for all tags are received
+    void waitFor(int respondsNum) {
+        if (responds.size() >= respondsNum)
+            return;
+        QEventLoop loop;
+        expectedResponds = respondsNum;
+        waitLoop = &loop;
+        QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+        loop.exec();
+        waitLoop = nullptr;
+    }
+
+    QMap<QString, int> responds; // tag -> server hit counter from the respond
+protected:
+    virtual void onProcessHttpResponse(bool requestOk, const QString & tag, QJsonObject & jsonRespond,
+                                       const QString & param1, const QString & param2,
+                                       const QString & param3, const QString & param4) override {
+        Q_UNUSED(param2)
+        Q_UNUSED(param3)
+        Q_UNUSED(param4)
+        Q_ASSERT(requestOk);
+        Q_ASSERT(param1 == tag + "_p1");
+        responds.insert(tag, jsonRespond["hits"].toInt());
+        if (waitLoop != nullptr && responds.size() >= expectedResponds)
+            waitLoop->quit();
+    }
+private:
+    QEventLoop * waitLoop = nullptr;
+    int expectedResponds = 0;
+};
+
+void testHttpClient() {
+    // Stub http server: respond with the number of requests it served so far
+    QTcpServer server;
+    bool listening = server.listen(QHostAddress::LocalHost, 0);
+    Q_ASSERT(listening);
+    if (!listening)
+        return;
+
+    int hits = 0;
+    QHash<QTcpSocket*, QByteArray> buffers;
+    QObject::connect(&server, &QTcpServer::newConnection, [&]() {
+        QTcpSocket * conn = server.nextPendingConnection();
+        QObject::connect(conn, &QTcpSocket::disconnected, [&, conn]() {
+            buffers.remove(conn);
+            conn->deleteLater();
+        });
+        QObject::connect(conn, &QTcpSocket::readyRead, [&, conn]() {
+            QByteArray & buffer = buffers[conn];
+            buffer.append(conn->readAll());
+            if (!buffer.contains("\r\n\r\n"))
+                return;
+            buffer.clear();
+
+            hits++;
+            const QByteArray body = "{\"hits\":" + QByteArray::number(hits) + "}";
+            conn->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " +
+                        QByteArray::number(body.size()) + "\r\n\r\n" + body);
+            conn->disconnectFromHost();
+        });
+    });
+
+    const QString baseUrl = "http://127.0.0.1:" + QString::number(server.serverPort());
+    const QString noCacheUrl = baseUrl + "/v1/nocache";
+    const QString cacheUrl = baseUrl + "/v1/cache";
+
+    StubHttpClient client;
+    client.setTtl(cacheUrl, 60*1000);
+
+    // Identical requests in flight are sent once
+    client.get(noCacheUrl, "a");
+    client.get(noCacheUrl, "b");
+    client.waitFor(2);
+    Q_ASSERT(hits == 1);
+    Q_ASSERT(client.responds["a"] == 1 && client.responds["b"] == 1);
+
+    // Not cached
+    client.get(noCacheUrl, "c");
+    client.waitFor(3);
+    Q_ASSERT(hits == 2);
+    Q_ASSERT(client.responds["c"] == 2);
+
+    // Cached respond is reused
+    client.get(cacheUrl, "d");
+    client.waitFor(4);
+    client.get(cacheUrl, "e");
+    client.waitFor(5);
+    Q_ASSERT(hits == 3);
+    Q_ASSERT(client.responds["d"] == 3 && client.responds["e"] == 3);
+
+    // Invalidated respond is requested again
+    client.invalidate(cacheUrl);
+    client.get(cacheUrl, "f");
+    client.waitFor(6);
+    Q_ASSERT(hits == 4);
+    Q_ASSERT(client.responds["f"] == 4);
+
+    // POST is never joined or cached
+    client.post(cacheUrl, "g");
+    client.post(cacheUrl, "h");
+    client.waitFor(8);
+    client.post(cacheUrl, "i");
+    client.waitFor(9);
+    Q_ASSERT(hits == 7);
+    Q_ASSERT(client.responds["g"] != client.responds["h"] && client.responds["i"] == 7);
+
+    const util::HttpEndpointStats noCacheStats = client.getEndpointStats().value(noCacheUrl);
+    Q_ASSERT(noCacheStats.requests == 2 && noCacheStats.coalesced == 1 && noCacheStats.cacheHits == 0);
+    const util::HttpEndpointStats cacheStats = client.getEndpointStats().value(cacheUrl);
+    Q_ASSERT(cacheStats.requests == 5 && cacheStats.coalesced == 0 && cacheStats.cacheHits == 1 && cacheStats.failures == 0);
+
+    qDebug() << "testHttpClient passed";
+}
+
+}
@@ -12,34 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef MWC_QT_WALLET_TIMERTHREAD_H
-#define MWC_QT_WALLET_TIMERTHREAD_H
 
-#include <QThread>
+#ifndef MWC_QT_WALLET_TESTHTTPCLIENT_H
+#define MWC_QT_WALLET_TESTHTTPCLIENT_H
 
-namespace core {
+namespace test {
 
-class TimerThread : public QThread {
-    Q_OBJECT
-public:
-    TimerThread(QObject *parent, long _interval);
-
-    virtual ~TimerThread();
-
-    void stop();
-
-protected:
-    void run();
-
-private:
-signals:
-    void onTimerEvent();
-
-private:
-    long interval = 1000;
-    bool alive = true;
-};
+// Requests coalescing, respond cache and its invalidation against a local stub http server
+void testHttpClient();
 
 }
 
-#endif //MWC_QT_WALLET_TIMERTHREAD_H
+#endif //MWC_QT_WALLET_TESTHTTPCLIENT_H
@@ -0,0 +1,152 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testJournalStore.h"
+#include "../util/journalstore.h"
+#include <QDir>
+#include <QFile>
+
+namespace test {
+
+static QString testStorePath() {
+    return QDir::tempPath() + "/mwc_test_journal.jdb";
+}
+
+static void cleanTestStore() {
+    QFile::remove(testStorePath());
+    QFile::remove(testStorePath() + ".journal");
+}
+
+void testJournalStore() {
+    cleanTestStore();
+    QString err;
+    bool ok = false;
+
+    {
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(ok);
+        Q_ASSERT(store.isEmpty());
+
+        // Enough records to trigger the compaction several times
+        for (int i = 0; i < 5000; i++) {
+            store.put("k" + QString::number(i % 1500), QByteArray::number(i));
+            ok = store.commit(err);
+            Q_ASSERT(ok);
+        }
+        store.remove("k7");
+        store.put("k8", "updated");
+        ok = store.commit(err);
+        Q_ASSERT(ok);
+    }
+
+    {
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(ok);
+        Q_ASSERT(store.size() == 1499);
+        Q_ASSERT(!store.contains("k7"));
+        Q_ASSERT(store.value("k8") == "updated");
+        Q_ASSERT(store.value("k1499") == "4499");
+        Q_ASSERT(store.keys("k14").size() == 111);
+
+        store.put("last", "value");
+        ok = store.commit(err);
+        Q_ASSERT(ok);
+    }
+
+    // Crash in the middle of the append: garbage at the journal tail
+    {
+        QFile journal(testStorePath() + ".journal");
+        ok = journal.open(QIODevice::WriteOnly | QIODevice::Append);
+        Q_ASSERT(ok);
+        journal.write(QByteArray("\x00\x00\x00\x40\x12", 5));
+        journal.close();
+    }
+
+    {
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(ok);
+        Q_ASSERT(store.size() == 1500);
+        Q_ASSERT(store.value("last") == "value");
+
+        // Journal is repaired, new records are readable
+        store.put("afterCrash", "ok");
+        ok = store.commit(err);
+        Q_ASSERT(ok);
+    }
+
+    {
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(ok);
+        Q_ASSERT(store.value("afterCrash") == "ok");
+        Q_ASSERT(store.value("last") == "value");
+    }
+
+    // Corrupted snapshot: store stays closed and the files are not touched
+    {
+        QFile snapshot(testStorePath());
+        ok = snapshot.open(QIODevice::ReadWrite);
+        Q_ASSERT(ok);
+        ok = snapshot.resize(snapshot.size() / 2);
+        Q_ASSERT(ok);
+        snapshot.close();
+    }
+
+    {
+        auto readFile = [](const QString & path) {
+            QFile file(path);
+            return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+        };
+        const QByteArray snapshotBytes = readFile(testStorePath());
+        const QByteArray journalBytes = readFile(testStorePath() + ".journal");
+        Q_ASSERT(!snapshotBytes.isEmpty() && !journalBytes.isEmpty());
+
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(!ok);
+        Q_ASSERT(!store.isOpen());
+        Q_ASSERT(store.isEmpty());
+
+        store.put("partial", "data");
+        ok = store.commit(err);
+        Q_ASSERT(!ok);
+        ok = store.compact(err);
+        Q_ASSERT(!ok);
+
+        Q_ASSERT(readFile(testStorePath()) == snapshotBytes);
+        Q_ASSERT(readFile(testStorePath() + ".journal") == journalBytes);
+
+        // Explicit reset overwrites the broken store
+        ok = store.create(testStorePath(), err);
+        Q_ASSERT(ok);
+        store.put("fresh", "value");
+        ok = store.commit(err);
+        Q_ASSERT(ok);
+    }
+
+    {
+        util::JournalStore store;
+        ok = store.open(testStorePath(), err);
+        Q_ASSERT(ok);
+        Q_ASSERT(store.size() == 1);
+        Q_ASSERT(store.value("fresh") == "value");
+    }
+
+    cleanTestStore();
+}
+
+}
@@ -0,0 +1,61 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testLinesRingBuffer.h"
+#include "../util/linesringbuffer.h"
+
+namespace test {
+
+void testLinesRingBuffer() {
+    util::LinesRingBuffer indexed(100, true);
+    util::LinesRingBuffer plain(100, false);
+
+    Q_ASSERT(indexed.snapshot().isEmpty());
+    Q_ASSERT(indexed.search("abc", 10).isEmpty());
+
+    for (int i = 0; i < 1050; i++) {
+        QString ln = "Line " + QString::number(i) + ((i % 7 == 0) ? " Received Block Header" : " peer connected");
+        indexed.append(ln);
+        plain.append(ln);
+    }
+
+    Q_ASSERT(indexed.size() == 100);
+    Q_ASSERT(indexed.firstSeq() == 950 && indexed.nextSeq() == 1050);
+
+    QStringList snapshot = indexed.snapshot();
+    Q_ASSERT(snapshot.size() == 100);
+    Q_ASSERT(snapshot.first().startsWith("Line 1049 "));
+    Q_ASSERT(snapshot.last().startsWith("Line 950 "));
+    Q_ASSERT(indexed.snapshot(3).size() == 3);
+
+    QStringList since = indexed.linesSince(1048);
+    Q_ASSERT(since.size() == 2 && since[0].startsWith("Line 1048 "));
+    Q_ASSERT(indexed.linesSince(0).size() == 100);
+
+    // Index must give the same results as the scan, evicted lines must not be found
+    for (const QString & text : {"block header", "BLOCK", "Line 95", "Line 12 ", "peer", "xyz", "e 1"}) {
+        Q_ASSERT(indexed.search(text, 1000) == plain.search(text, 1000));
+    }
+    Q_ASSERT(indexed.search("Line 12 ", 10).isEmpty());
+    Q_ASSERT(indexed.search("block header", 1000).size() == 14);
+    Q_ASSERT(indexed.search("peer", 5).size() == 5);
+    Q_ASSERT(indexed.line(indexed.search("block header", 1).first()).startsWith("Line 1043 "));
+
+    indexed.clear();
+    Q_ASSERT(indexed.size() == 0 && indexed.search("peer", 5).isEmpty());
+    indexed.append("after clear");
+    Q_ASSERT(indexed.snapshot() == QStringList{"after clear"});
+}
+
+}
@@ -46,6 +46,9 @@ void testLogsRotation() {
     for (int t=0; t<5000000; t++) {
         logger::logInfo("testLogsRotation", "Long line " + QString::number(t) + " for testing dlksfjl kdskdsfhjflks dhfkldshf kljsdhdflkjsdhffslakjhfsdjfhdlks jfkjds fklshdfksdjhf lsdfjkdsafhsdkhfkshfkshf sjdh klsjdfhdskjhfskdjfhskjhdfskdjfhkfdsjh");
     }
+
+    // Writing the queue. Note, writer is async, so with such a rate some records will be dropped.
+    logger::enableLogs(false);
 }
 
 
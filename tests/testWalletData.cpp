@@ -0,0 +1,63 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testWalletData.h"
+#include "../wallet/wallet.h"
+
+namespace test {
+
+void testWalletDataJson() {
+    using namespace wallet;
+
+    WalletOutput out = WalletOutput::create("08a3c5", "1234", "56789", "57000", "Unspent", true, "12", 2500000000L, 7L);
+    Q_ASSERT(out.isValid() && out.isUnspent());
+    Q_ASSERT(out.MMRIndex == 1234 && out.blockHeight == 56789 && out.lockedUntil == 57000 && out.numOfConfirms == 12);
+    Q_ASSERT(out.getBlockHeightStr() == "56789" && out.getStatusStr() == "Unspent");
+
+    WalletOutput out2 = WalletOutput::fromJson(out.toJson());
+    Q_ASSERT(out2.toJson() == out.toJson());
+    Q_ASSERT(out2.outputCommitment == out.outputCommitment && out2.status == out.status && out2.coinbase &&
+             out2.blockHeight == out.blockHeight && out2.lockedUntil == out.lockedUntil &&
+             out2.numOfConfirms == out.numOfConfirms && out2.valueNano == out.valueNano && out2.txIdx == out.txIdx);
+
+    // Unconfirmed output doesn't have the height, it must stay empty
+    WalletOutput unconf = WalletOutput::create("08b4d6", "", "", "", "Unconfirmed", false, "", 1000L, 8L);
+    Q_ASSERT(unconf.isValid() && unconf.status == WalletOutput::STATUS::UNCONFIRMED);
+    Q_ASSERT(unconf.blockHeight < 0 && unconf.getBlockHeightStr().isEmpty() && unconf.getNumOfConfirmsStr().isEmpty());
+    WalletOutput unconf2 = WalletOutput::fromJson(unconf.toJson());
+    Q_ASSERT(unconf2.blockHeight < 0 && unconf2.MMRIndex < 0 && unconf2.numOfConfirms < 0);
+
+    Q_ASSERT(WalletOutput::create("08c5e7", "", "", "", "", false, "", 1L, 1L).isValid() == false);
+    Q_ASSERT(WalletOutput::str2status("Reverted") == WalletOutput::STATUS::REVERTED);
+
+    // Status from the newer mwc713 is shown as it is
+    WalletOutput newStatus = WalletOutput::create("08d6f8", "", "", "", "Frozen", false, "", 1L, 1L);
+    Q_ASSERT(newStatus.status == WalletOutput::STATUS::UNKNOWN && newStatus.getStatusStr() == "Frozen");
+    Q_ASSERT(WalletOutput::fromJson(newStatus.toJson()).getStatusStr() == "Frozen");
+
+    // mwc713 prints UTC time
+    WalletTransaction tx;
+    tx.setData(3, WalletTransaction::TRANSACTION_TYPE::RECEIVE, "4f9f0a6b-a4e1-4c5c-9bd8-57d0b6d9c3f1", "mwcmqs://someone",
+               "2020-10-13 04:36:54", true, -1, 56789, "None", 1, 2, 2500000000L, 0, 8000000, 2492000000L, false, "09ab");
+    Q_ASSERT(tx.creationTime == 1602563814);
+    Q_ASSERT(tx.confirmationTime == 0 && tx.getConfirmationTimeStr().isEmpty());
+    Q_ASSERT(tx.calculateTransactionAge(QDateTime::fromSecsSinceEpoch(1602563814 + 60)) == 60);
+
+    WalletTransaction tx2 = WalletTransaction::fromJson(tx.toJson());
+    Q_ASSERT(tx2.toJson() == tx.toJson());
+    Q_ASSERT(tx2.creationTime == tx.creationTime && tx2.confirmationTime == 0 && tx2.txid == tx.txid &&
+             tx2.height == tx.height && tx2.coinNano == tx.coinNano);
+}
+
+}
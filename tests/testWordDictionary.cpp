@@ -13,33 +13,43 @@
 // limitations under the License.
 
 #include "testWordDictionary.h"
-#include "../util/WordDictionary.h"
+#include "../util/WordTrie.h"
 
 namespace test {
 
 void testWordDictionary() {
-    dict::WordDictionary dict2(":/resource/passwords-1k.dat");
-    dict::WordDictionary dict(":/resource/passwords-10k.dat");
+    // Dictionaries: 0 - 1k, 1 - 10k, see misk::compileDictionaries
+    dict::WordTrie dict(":/resource/passwords.trie");
+    Q_ASSERT(!dict.isEmpty());
 
     // Last item 'zzzzzzzz'
-    Q_ASSERT(dict.findLongestWord("zzzzzzzzzzz") == "zzzzzzzz");
-    Q_ASSERT(dict.findLongestWord("{zzzzzzz") == "");
+    Q_ASSERT(dict.findLongestWord("zzzzzzzzzzz", 1) == "zzzzzzzz");
+    Q_ASSERT(dict.findLongestWord("{zzzzzzz", 1) == "");
 
     // First item: '*****'
-    Q_ASSERT(dict.findLongestWord("*****") == "*****");
-    Q_ASSERT(dict.findLongestWord("*****234") == "*****");
-    Q_ASSERT(dict.findLongestWord("****") == "");
-    Q_ASSERT(dict.findLongestWord("(****") == ""); // '(' comes before'*'
-
-    Q_ASSERT(dict2.findLongestWord("victor58476") == "victor");
-    Q_ASSERT(dict2.findLongestWord("victor") == "victor");
-    Q_ASSERT(dict2.findLongestWord("blue") == "blue");
-    Q_ASSERT(dict2.findLongestWord("blue8785") == "blue"); // note we have a keyword blue123 that goes after 'blue'
-
-    Q_ASSERT(dict2.findLongestWord("avictor") == "");
-    Q_ASSERT(dict2.findLongestWord("ablue") == "");
-
+    Q_ASSERT(dict.findLongestWord("*****", 1) == "*****");
+    Q_ASSERT(dict.findLongestWord("*****234", 1) == "*****");
+    Q_ASSERT(dict.findLongestWord("****", 1) == "");
+    Q_ASSERT(dict.findLongestWord("(****", 1) == ""); // '(' comes before'*'
+
+    Q_ASSERT(dict.findLongestWord("victor58476", 0) == "victor");
+    Q_ASSERT(dict.findLongestWord("victor", 0) == "victor");
+    Q_ASSERT(dict.findLongestWord("blue", 0) == "blue");
+    Q_ASSERT(dict.findLongestWord("blue8785", 0) == "blue"); // note we have a keyword blue123 that goes after 'blue'
+
+    Q_ASSERT(dict.findLongestWord("avictor", 0) == "");
+    Q_ASSERT(dict.findLongestWord("ablue", 0) == "");
+
+    // Word belongs to a single dictionary
+    Q_ASSERT(dict.findLongestWord("victor", 1) == "");
+
+    // Single pass finds the words of all dictionaries, at any position. Case is preserved at the result
+    QVector<double> weights(12, 10.0);
+    QStringList words = dict.detectDictionaryWords("12VICTORblue", weights, {1.0, 2.0, 3.0, 4.0});
+    Q_ASSERT(words.contains("VICTOR"));
+    Q_ASSERT(words.contains("blue"));
+    Q_ASSERT(weights[0] == 10.0);
+    Q_ASSERT(weights[2] < 1.0 && weights[11] < 1.0);
 }
 
-
 }
@@ -159,6 +159,7 @@ NodeOutputParser::NodeOutputParser() {
                                                          new TriePhraseSection("Address already in use")
                                                  }));
 
+    parser.compile();
 
 }
 
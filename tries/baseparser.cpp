@@ -93,7 +93,16 @@ void TrieLineContext::reset() {
 // Process char against whole context
 void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
     // Process what we already have
+    processActiveChar(ch);
 
+    // Every iteration try to start a new parser
+    if (isSingleActiveContext && !contexts.isEmpty())
+        return;
+
+    startNewSectionAndProcess( headSection, LineResult(), ch );
+}
+
+void TrieLineContext::processActiveChar( QChar ch ) {
     int sz = contexts.size();
     for ( int i=sz-1; i>=0; i-- ) {
         TrieSectionContext* cont = contexts[i];
@@ -113,12 +122,20 @@ void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
         delete cont;
         contexts.remove(i);
     }
+}
 
-    // Every iteration try to start a new parser
-    if (isSingleActiveContext && !contexts.isEmpty())
+// Head section is done with the current char. Same as processContext for done without startNext
+void TrieLineContext::startAfterHead( BaseTrieSection * headSection, LineResult && headResult ) {
+    const QVector<BaseTrieSection*> & next = headSection->getNextParser();
+
+    if (next.empty()) {
+        readyResult.push_back( headResult );
         return;
+    }
 
-    startNewSectionAndProcess( headSection, LineResult(), ch );
+    for (auto ns : next) {
+        contexts.push_back( new TrieSectionContext(ns, headResult) );
+    }
 }
 
 void TrieLineContext::processContext(TrieSectionContext* context, bool done, bool startNext, QChar ch) {
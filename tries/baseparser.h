@@ -122,6 +122,15 @@ public:
     // Process char against whole context
     void processChar( BaseTrieSection * headSection, QChar ch );
 
+    // Process char with running sections only. Head section is not started.
+    // Used by compiled InputParser, heads are matched there by the automaton.
+    void processActiveChar( QChar ch );
+    // Head section was matched outside of this context. Spawn the next sections from it.
+    void startAfterHead( BaseTrieSection * headSection, LineResult && headResult );
+
+    bool hasActiveContexts() const {return !contexts.isEmpty();}
+    bool hasSingleActiveContext() const {return isSingleActiveContext;}
+
     void reset(); // Reset whole context
 
     bool hasResults() const {return !readyResult.empty();}
@@ -151,6 +160,7 @@ public:
     TrieLineParser & operator=(const TrieLineParser & other) = delete;
 
     int getParserId() const {return parserId;}
+    BaseTrieSection * getHeadSection() const {return sections.isEmpty() ? nullptr : sections.front();}
 
     // Adding section/line for parsing and pair them in chain
     TrieLineParser & addSection( BaseTrieSection* s );
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "tries/inputparser.h"
+#include "tries/simpletriesection.h"
+#include <algorithm>
 
 namespace tries {
 
@@ -43,10 +45,12 @@ InputParser::~InputParser() {
 // append a new line parser.
 // parser must be on the heap and pnership will be transferred to this
 void InputParser::appendLineParser( TrieLineParser* parser, bool hasSingleActiveContext ) {
+    resetCompiled();
     lines.push_back( LineInfo( parser, new TrieLineContext(hasSingleActiveContext) ) );
 }
 
 bool InputParser::deleteLineParser(int parserId) {
+    resetCompiled();
     int sz = lines.size();
     for (int t=sz-1; t>=0; t--) {
         if (lines[t].parser->getParserId() == parserId) {
@@ -58,7 +62,61 @@ bool InputParser::deleteLineParser(int parserId) {
     return lines.size() < sz;
 }
 
+void InputParser::resetCompiled() {
+    compiled = false;
+    headAutomaton.clear();
+    lineIsCompiled.clear();
+    activeLines.clear();
+}
+
+void InputParser::compile() {
+    resetCompiled();
+
+    lineIsCompiled.fill(false, lines.size());
+
+    for (int i=0; i<lines.size(); i++) {
+        const LineInfo & li = lines[i];
+        // Running contexts was started without automaton. Restarting from the clean state
+        li.context->reset();
+
+        BaseTrieSection * head = li.parser->getHeadSection();
+        if (head==nullptr)
+            continue;
+
+        if (TriePhraseSection * phrase = dynamic_cast<TriePhraseSection*>(head)) {
+            // Single context line can't start while another context is running. For the long phrase that is
+            // checked at the first char, automaton knows about the match only at the last one.
+            if (li.context->hasSingleActiveContext() && phrase->getPhrase().length()>1)
+                continue;
+            headAutomaton.addPhrase( phrase->getPhrase(), phrase->isIgnoreCase(), i );
+            lineIsCompiled[i] = true;
+        }
+        else if (dynamic_cast<TrieNewLineSection*>(head) != nullptr) {
+            headAutomaton.addPhrase( QString(QChar(QChar::LineSeparator)), false, i );
+            headAutomaton.addPhrase( QString(QChar(QChar::LineFeed)), false, i );
+            headAutomaton.addPhrase( QString(QChar(QChar::CarriageReturn)), false, i );
+            lineIsCompiled[i] = true;
+        }
+    }
+
+    headAutomaton.build();
+
+    for (int i=0; i<lines.size(); i++) {
+        if (!lineIsCompiled[i])
+            activeLines.push_back(i);
+    }
+
+    compiled = true;
+}
+
 QVector<ParsingResult> InputParser::processInput(QString input) {
+    if (compiled)
+        return processInputCompiled(input);
+    else
+        return processInputByLines(input);
+}
+
+QVector<ParsingResult> InputParser::processInputByLines(const QString & input) {
     // processing input symbol by symbol
     int len = input.length();
 
@@ -84,5 +142,66 @@ QVector<ParsingResult> InputParser::processInput(QString input) {
     return result;
 }
 
+// Same results as processInputByLines, but heads are matched by the automaton and only the lines
+// with running contexts are touched. Lines are processed in the registration order, so the results order is the same.
+QVector<ParsingResult> InputParser::processInputCompiled(const QString & input) {
+    int len = input.length();
+
+    QVector<ParsingResult> result;
+
+    for ( int l=0; l<len; l++ ) {
+        QChar ch = input[l];
+
+        // Copy to own buffer, it keeps capacity, so no allocations here
+        matchedLines.resize(0);
+        for (int idx : headAutomaton.processChar(ch))
+            matchedLines.push_back(idx);
+        std::sort(matchedLines.begin(), matchedLines.end());
+
+        // touchLines = activeLines + matchedLines, both are sorted
+        touchLines.resize(0);
+        std::set_union( activeLines.begin(), activeLines.end(), matchedLines.begin(), matchedLines.end(),
+                        std::back_inserter(touchLines) );
+
+        activeLines.resize(0);
+
+        for (int idx : touchLines) {
+            LineInfo & p = lines[idx];
+
+            if (lineIsCompiled[idx]) {
+                p.context->processActiveChar(ch);
+
+                if ( std::binary_search(matchedLines.begin(), matchedLines.end(), idx) &&
+                        !(p.context->hasSingleActiveContext() && p.context->hasActiveContexts()) ) {
+                    BaseTrieSection * head = p.parser->getHeadSection();
+                    LineResult headResult;
+                    if (head->getAccumulateId()>=0) {
+                        // Accumulated data excludes the last symbol, see TrieSectionContext::calcResult
+                        int headLen = static_cast<TriePhraseSection*>(head)->getPhrase().length();
+                        headResult.AddResult( SectionResult( headAutomaton.getLastChars(headLen).left(headLen-1), head->getAccumulateId() ) );
+                    }
+                    p.context->startAfterHead( head, std::move(headResult) );
+                }
+
+                if (p.context->hasActiveContexts())
+                    activeLines.push_back(idx);
+            }
+            else {
+                p.parser->process(ch, p.context);
+                activeLines.push_back(idx);
+            }
+
+            if (p.context->hasResults()) {
+                const QVector<LineResult> & res = p.context->getReadyResult();
+                for ( auto & r : res ) {
+                    result.push_back( ParsingResult(p.parser->getParserId(), r ) );
+                }
+                p.context->resetResults();
+            }
+        }
+    }
+    return result;
+}
+
 
 }
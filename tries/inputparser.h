@@ -17,6 +17,7 @@
 
 #include <QVector>
 #include "baseparser.h"
+#include "phraseautomaton.h"
 #include <QDebug>
 
 namespace tries {
@@ -64,10 +65,29 @@ public:
     // return true if anything was deleted
     bool deleteLineParser(int parserId);
 
+    // Merge head phrases of all lines into a single automaton. Call it once all line parsers are added.
+    // Lines with phrase or new line head sections are started by the automaton, the rest are processed char by char.
+    // Append/delete of the line parser drops the compiled data, parser will work without automaton until the next compile.
+    void compile();
+
     QVector<ParsingResult> processInput(QString input);
 
+private:
+    QVector<ParsingResult> processInputByLines(const QString & input);
+    QVector<ParsingResult> processInputCompiled(const QString & input);
+
+    void resetCompiled();
+
 protected:
     QVector< LineInfo > lines;
+
+    // Compiled data, see compile()
+    bool            compiled = false;
+    PhraseAutomaton headAutomaton; // Head sections of the compiled lines. Phrase Id is line index
+    QVector<bool>   lineIsCompiled;
+    QVector<int>    activeLines;   // Sorted indexes of lines that need the char: running contexts or not compiled
+    QVector<int>    matchedLines;  // Buffers for processInputCompiled
+    QVector<int>    touchLines;
 };
 
 }
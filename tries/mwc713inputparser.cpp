@@ -40,6 +40,9 @@ Mwc713InputParser::Mwc713InputParser() :
     initRecovery();
     initSyncProgress();
     initSwaps();
+
+    // All lines are registered, building a single automaton for them
+    parser.compile();
 }
 
 Mwc713InputParser::~Mwc713InputParser() {}
@@ -0,0 +1,185 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tries/mwc713linesplitter.h"
+#include <cstring>
+#include <cctype>
+
+namespace tries {
+
+static const char * const PROMPT_PREFIX = "wallet713>";
+static const int PROMPT_PREFIX_LEN = 10;
+// Tables borders and separators, see parseTransactions/parseOutputs
+static const int TABLE_BORDER_LEN = 14;     // '=============='
+static const int TABLE_SEPARATOR_LEN = 20;  // '--------------------'
+
+inline bool isNewLine(char ch) {
+    return ch=='\n' || ch=='\r';
+}
+
+static bool hasRepeatedPrefix(const char * line, int len, char ch, int prefixLen) {
+    if (len < prefixLen)
+        return false;
+    for (int i=0; i<prefixLen; i++) {
+        if (line[i]!=ch)
+            return false;
+    }
+    return true;
+}
+
+Mwc713LineSplitter::Mwc713LineSplitter() {}
+
+void Mwc713LineSplitter::reset() {
+    inTable = false;
+    pending.clear();
+    tableRows.clear();
+    lastData.clear();
+}
+
+// Single prefix lookup for the line
+// static
+Mwc713LineSplitter::LINE_TYPE Mwc713LineSplitter::classifyLine(const char * line, int len) {
+    Q_ASSERT(len>0);
+    switch (line[0]) {
+        case ' ':
+            // Table rows and multiline cells continuation have a padding
+            return LINE_TYPE::TABLE_ROW;
+        case '=':
+            return hasRepeatedPrefix(line, len, '=', TABLE_BORDER_LEN) ? LINE_TYPE::TABLE_BORDER : LINE_TYPE::TEXT;
+        case '-':
+            return hasRepeatedPrefix(line, len, '-', TABLE_SEPARATOR_LEN) ? LINE_TYPE::TABLE_SEPARATOR : LINE_TYPE::TEXT;
+        case 'w':
+            return (len>=PROMPT_PREFIX_LEN && memcmp(line, PROMPT_PREFIX, PROMPT_PREFIX_LEN)==0) ? LINE_TYPE::PROMPT : LINE_TYPE::TEXT;
+        default:
+            return LINE_TYPE::TEXT;
+    }
+}
+
+QString Mwc713LineSplitter::processData(const QByteArray & data, bool tableRowsAccepted) {
+    QByteArray buf = data;
+    if (!pending.isEmpty()) {
+        buf.prepend(pending);
+        pending.clear();
+    }
+    lastData = buf;
+
+    if (!tableRowsAccepted)
+        inTable = false;
+
+    const char * d = buf.constData();
+    const int sz = buf.size();
+
+    // Text for trie is build the same way as before: non empty lines joined with '\n',
+    // with leading and trailing new lines if data has them.
+    QByteArray trieText;
+    trieText.reserve(sz+2);
+
+    bool heldTail = false;
+    int pos = 0;
+    while (pos<sz) {
+        int end = pos;
+        while (end<sz && !isNewLine(d[end]))
+            end++;
+
+        const char * line = d + pos;
+        int len = end - pos;
+        pos = end + 1;
+
+        if (len==0)
+            continue;
+
+        LINE_TYPE type = classifyLine(line, len);
+
+        if (inTable) {
+            if (end>=sz && (type==LINE_TYPE::TABLE_ROW || type==LINE_TYPE::TABLE_SEPARATOR || line[0]=='=')) {
+                // Incomplete row, waiting for the rest of it
+                pending = QByteArray(line, len);
+                heldTail = true;
+                break;
+            }
+
+            if (type==LINE_TYPE::TABLE_ROW) {
+                tableRows.append(line, len);
+                tableRows.append('\n');
+                continue;
+            }
+            if (type==LINE_TYPE::TABLE_SEPARATOR)
+                continue; // Separators are skipped by the parser anyway
+        }
+
+        if (type==LINE_TYPE::PROMPT) {
+            line += PROMPT_PREFIX_LEN;
+            len -= PROMPT_PREFIX_LEN;
+            // trimmed
+            while (len>0 && isspace((unsigned char)line[0])) {
+                line++;
+                len--;
+            }
+            while (len>0 && isspace((unsigned char)line[len-1]))
+                len--;
+            inTable = false;
+        }
+        else if (type==LINE_TYPE::TABLE_BORDER) {
+            // Header border opens the table body, next border closes it
+            inTable = !inTable && tableRowsAccepted;
+        }
+
+        if (!trieText.isEmpty())
+            trieText.append('\n');
+        trieText.append(line, len);
+    }
+
+    if (sz>0 && isNewLine(d[0]))
+        trieText.prepend('\n');
+
+    if ( heldTail || (sz>0 && isNewLine(d[sz-1])) )
+        trieText.append('\n');
+
+    return QString::fromUtf8(trieText);
+}
+
+QString Mwc713LineSplitter::takeTableRows() {
+    QString res = QString::fromUtf8(tableRows);
+    tableRows.clear();
+    return res;
+}
+
+void Mwc713LineSplitter::appendLastLines(QList<QString> & lines, int bufferSize) const {
+    const char * d = lastData.constData();
+    int end = lastData.size();
+
+    QList<QString> last;
+    while (end>0 && last.size()<bufferSize) {
+        int start = end;
+        while (start>0 && !isNewLine(d[start-1]))
+            start--;
+
+        if (start<end) {
+            QString ln = QString::fromUtf8(d+start, end-start);
+            if (ln.startsWith(PROMPT_PREFIX))
+                ln = ln.mid(PROMPT_PREFIX_LEN).trimmed();
+            if (!ln.isEmpty())
+                last.push_front(ln);
+        }
+        end = start-1;
+    }
+
+    for (const QString & ln : last) {
+        while (lines.size() > bufferSize)
+            lines.pop_front();
+        lines.push_back(ln);
+    }
+}
+
+}
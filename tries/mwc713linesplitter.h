@@ -0,0 +1,63 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_MWC713LINESPLITTER_H
+#define MWC_QT_WALLET_MWC713LINESPLITTER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QList>
+
+namespace tries {
+
+// Streaming line splitter for mwc713 stdout. Works on the raw bytes.
+// Every line is classified by its prefix. Prompt is stripped, the rest of the lines go to the trie parser.
+// Exception is the table body (rows after '=====' border of txs/outputs tables). If active task accept it,
+// rows are collected separately and bypass the trie, see Mwc713Task::acceptTableRows()
+class Mwc713LineSplitter {
+public:
+    Mwc713LineSplitter();
+
+    Mwc713LineSplitter(const Mwc713LineSplitter & other) = delete;
+    Mwc713LineSplitter & operator=(const Mwc713LineSplitter & other) = delete;
+
+    // Process next chunk of the mwc713 output. Escape symbols are expected to be filtered out.
+    // tableRowsAccepted - active task can take the table rows.
+    // Return: text for the trie parser.
+    QString processData(const QByteArray & data, bool tableRowsAccepted);
+
+    bool hasTableRows() const {return !tableRows.isEmpty();}
+    // Table rows that was collected so far, separated by '\n'. Rows are cleaned after the call.
+    QString takeTableRows();
+
+    // Append last non empty lines of the processed data. Used for the crash report.
+    void appendLastLines(QList<QString> & lines, int bufferSize) const;
+
+    // Reset to initial state
+    void reset();
+
+private:
+    enum class LINE_TYPE { TEXT, PROMPT, TABLE_BORDER, TABLE_SEPARATOR, TABLE_ROW };
+    static LINE_TYPE classifyLine(const char * line, int len);
+
+private:
+    bool       inTable = false; // Processing table body
+    QByteArray pending;         // Incomplete row from the previous chunk
+    QByteArray tableRows;       // Collected rows
+    QByteArray lastData;        // Last processed data, needed for appendLastLines
+};
+
+}
+
+#endif //MWC_QT_WALLET_MWC713LINESPLITTER_H
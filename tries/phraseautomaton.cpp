@@ -0,0 +1,188 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tries/phraseautomaton.h"
+#include <algorithm>
+
+namespace tries {
+
+PhraseAutomaton::PhraseAutomaton() {
+    clear();
+}
+
+void PhraseAutomaton::clear() {
+    phrases.clear();
+    alphabetSize = 1;
+    for (int i=0; i<128; i++)
+        asciiClass[i] = 0;
+    unicodeClass.clear();
+    transitions.clear();
+    outputStart.clear();
+    outputs.clear();
+    history.clear();
+    historyMask = 0;
+    reset();
+}
+
+void PhraseAutomaton::addPhrase(const QString & phrase, bool ignoreCase, int phraseId) {
+    Q_ASSERT(!phrase.isEmpty());
+    Phrase p;
+    p.phrase = phrase;
+    p.ignoreCase = ignoreCase;
+    p.phraseId = phraseId;
+    phrases.push_back(p);
+}
+
+void PhraseAutomaton::build() {
+    // Char classes for all folded chars from the phrases
+    alphabetSize = 1;
+    for (int i=0; i<128; i++)
+        asciiClass[i] = 0;
+    unicodeClass.clear();
+
+    int maxLen = 1;
+    for (const Phrase & p : phrases) {
+        maxLen = std::max(maxLen, p.phrase.length());
+        for (QChar ch : p.phrase) {
+            ushort c = foldChar(ch).unicode();
+            if (c < 128) {
+                if (asciiClass[c] == 0)
+                    asciiClass[c] = alphabetSize++;
+            }
+            else if (!unicodeClass.contains(c)) {
+                unicodeClass.insert(c, alphabetSize++);
+            }
+        }
+    }
+
+    // Trie. -1 is 'no transition'
+    transitions.fill(-1, alphabetSize);
+    QVector<QVector<int>> stateOutputs(1);
+
+    for (int pIdx=0; pIdx<phrases.size(); pIdx++) {
+        int s = 0;
+        for (QChar ch : phrases[pIdx].phrase) {
+            int & next = transitions[s*alphabetSize + getCharClass(foldChar(ch))];
+            if (next < 0) {
+                next = stateOutputs.size();
+                stateOutputs.push_back(QVector<int>());
+                transitions.resize(transitions.size() + alphabetSize);
+                for (int k=transitions.size()-alphabetSize; k<transitions.size(); k++)
+                    transitions[k] = -1;
+            }
+            s = transitions[s*alphabetSize + getCharClass(foldChar(ch))];
+        }
+        stateOutputs[s].push_back(pIdx);
+    }
+
+    // Fail links with BFS. Missing transitions are replaced with the fail link transitions, so we get a DFA.
+    const int stateNum = stateOutputs.size();
+    QVector<int> fail(stateNum, 0);
+    QVector<int> queue;
+    queue.reserve(stateNum);
+
+    for (int c=0; c<alphabetSize; c++) {
+        int & next = transitions[c];
+        if (next < 0) {
+            next = 0;
+        }
+        else {
+            fail[next] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    for (int qIdx=0; qIdx<queue.size(); qIdx++) {
+        int r = queue[qIdx];
+        // fail link state is processed already, so it outputs are complete
+        stateOutputs[r].append( stateOutputs[fail[r]] );
+
+        for (int c=0; c<alphabetSize; c++) {
+            int s = transitions[r*alphabetSize + c];
+            int failNext = transitions[fail[r]*alphabetSize + c];
+            if (s < 0) {
+                transitions[r*alphabetSize + c] = failNext;
+            }
+            else {
+                fail[s] = failNext;
+                queue.push_back(s);
+            }
+        }
+    }
+
+    // Flat outputs
+    outputStart.resize(stateNum+1);
+    outputs.clear();
+    for (int s=0; s<stateNum; s++) {
+        outputStart[s] = outputs.size();
+        outputs.append(stateOutputs[s]);
+    }
+    outputStart[stateNum] = outputs.size();
+
+    int histSz = 1;
+    while (histSz < maxLen)
+        histSz *= 2;
+    history.fill(QChar(), histSz);
+    historyMask = histSz-1;
+
+    reset();
+}
+
+void PhraseAutomaton::reset() {
+    state = 0;
+    historyPos = 0;
+    matched.resize(0);
+}
+
+const QVector<int> & PhraseAutomaton::processChar(QChar ch) {
+    matched.resize(0);
+    if (transitions.isEmpty())
+        return matched;
+
+    history[historyPos & historyMask] = ch;
+    historyPos++;
+    // Keeping position bounded. Shift by the buffer size doesn't change the index, and all history is still available
+    if (historyPos >= history.size()*2)
+        historyPos -= history.size();
+
+    state = transitions[state*alphabetSize + getCharClass(foldChar(ch))];
+
+    for (int i=outputStart[state]; i<outputStart[state+1]; i++) {
+        const Phrase & p = phrases[outputs[i]];
+        if (p.ignoreCase || verifyPhrase(p))
+            matched.push_back(p.phraseId);
+    }
+    return matched;
+}
+
+bool PhraseAutomaton::verifyPhrase(const Phrase & p) const {
+    const int len = p.phrase.length();
+    for (int k=0; k<len; k++) {
+        if ( history[(historyPos-1-k) & historyMask] != p.phrase[len-1-k] )
+            return false;
+    }
+    return true;
+}
+
+QString PhraseAutomaton::getLastChars(int len) const {
+    Q_ASSERT(len <= history.size());
+    len = std::min( len, std::min(historyPos, history.size()) );
+    QString res;
+    res.reserve(len);
+    for (int k=len; k>0; k--)
+        res += history[(historyPos-k) & historyMask];
+    return res;
+}
+
+}
@@ -0,0 +1,106 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_PHRASEAUTOMATON_H
+#define MWC_QT_WALLET_PHRASEAUTOMATON_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+namespace tries {
+
+// Aho-Corasick automaton for a set of fixed phrases.
+// All phrases are matched in a single pass, the cost of a char doesn't depend on the number of phrases.
+// Automaton works on lower case chars. Case sensitive phrases are verified against the input history on match.
+class PhraseAutomaton {
+public:
+    PhraseAutomaton();
+
+    PhraseAutomaton(const PhraseAutomaton & other) = delete;
+    PhraseAutomaton & operator=(const PhraseAutomaton & other) = delete;
+
+    // Drop all phrases and the automaton
+    void clear();
+
+    // Add a phrase. phraseId will be reported on match. Several phrases can share the same id.
+    // build() must be called after all phrases are added.
+    void addPhrase(const QString & phrase, bool ignoreCase, int phraseId);
+
+    // Build the automaton for the added phrases
+    void build();
+
+    bool isEmpty() const {return phrases.isEmpty();}
+
+    // Reset the current state, input history is discarded
+    void reset();
+
+    // Process next char. Return ids of the phrases that end with this char.
+    // Returned data is valid until next call.
+    const QVector<int> & processChar(QChar ch);
+
+    // Last 'len' processed chars. len must not exceed the longest phrase
+    QString getLastChars(int len) const;
+
+private:
+    struct Phrase {
+        QString phrase;
+        bool ignoreCase = false;
+        int phraseId = -1;
+    };
+
+    static QChar foldChar(QChar ch) {
+        ushort c = ch.unicode();
+        if (c < 128)
+            return (c>='A' && c<='Z') ? QChar(c + ('a'-'A')) : ch;
+        return ch.toLower();
+    }
+
+    int getCharClass(QChar foldedCh) const {
+        ushort c = foldedCh.unicode();
+        if (c < 128)
+            return asciiClass[c];
+        return unicodeClass.value(c, 0);
+    }
+
+    // Case sensitive check of the phrase against the history
+    bool verifyPhrase(const Phrase & p) const;
+
+private:
+    QVector<Phrase> phrases;
+
+    // Char classes. Class 0 is for chars that are not used by any phrase
+    int               alphabetSize = 1;
+    int               asciiClass[128];
+    QHash<ushort,int> unicodeClass;
+
+    // DFA: transitions[state*alphabetSize + charClass] => next state. State 0 is the root.
+    QVector<int> transitions;
+    // Matched phrases for the state, include the phrases from the fail links: outputs[outputStart[s] .. outputStart[s+1]-1]
+    QVector<int> outputStart;
+    QVector<int> outputs;
+
+    int state = 0;
+
+    // Ring buffer of last processed chars, size is power of 2
+    QVector<QChar> history;
+    int historyMask = 0;
+    int historyPos = 0;
+
+    QVector<int> matched; // result buffer for processChar
+};
+
+}
+
+#endif //MWC_QT_WALLET_PHRASEAUTOMATON_H
@@ -26,6 +26,9 @@ public:
     TriePhraseSection(QString phrase, bool ignoreCase, int accumulateId=-1);
 
     virtual uint32_t processChar(TrieContext & context, QChar ch) override;
+
+    const QString & getPhrase() const {return phrase;}
+    bool isIgnoreCase() const {return ignoreCase;}
 protected:
     QString phrase;
     bool ignoreCase = false;
@@ -14,133 +14,310 @@
 
 #include "FolderCompressor.h"
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
 #include <QDataStream>
 #include <QCoreApplication>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QHash>
+#include <QSet>
+#include <QDirIterator>
+#include <QtEndian>
+#include <algorithm>
+#include <deque>
+#include <memory>
 
 namespace compress {
 
-const int ARCH_VERSION = 0x9265DB;
+const int ARCH_VERSION = 0x9265DB;  // Legacy, every file is a single compressed block
+const int ARCH_VERSION_CHUNKED = 0x9265DC;
 const int ARCH_DIR_VER      = 0x587634;
 const int ARCH_FILE_VER     = 0x823AD1;
+const int ARCH_FILE_CHUNKED = 0x823AD2;
+const int ARCH_INDEX        = 0x4C8E10;
 const int ARCH_END          = 0x000100; // end of archive.
 
-// return: <success, Error Message>
-static QPair<bool, QString> compress(QDataStream & dataStream, // target
-                QString sourceFolder, QString prefix, bool callProcessEvents) {
-    QDir dir(sourceFolder);
-    if (!dir.exists())
-        return QPair<bool, QString>(false, "Unable to compress directory " + sourceFolder);
+// Uncompressed chunk size
+const int CHUNK_SIZE = 4*1024*1024;
+// Import is writing into the temp file first, so interrupted file will not be taken as completed
+const QString PART_SUFFIX(".mwcpart");
+// How often processEvents is called while we are waiting for the workers
+const int WAIT_EVENTS_MS = 50;
+
+////////////////////////////////////////////////////////////////////////////////////
+// CRC32 (the same as zlib)
+
+static quint32 crcTable[256];
+static bool crcTableInit = false;
+
+static void initCrcTable() {
+    if (crcTableInit)
+        return;
+    for (quint32 i = 0; i < 256; i++) {
+        quint32 c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        crcTable[i] = c;
+    }
+    crcTableInit = true;
+}
 
-    // Forders can be empty, we want to store them as well
-    dataStream << int(ARCH_DIR_VER);
-    dataStream << QString(prefix);
+static quint32 crc32(quint32 crc, const uchar * data, int len) {
+    quint32 c = crc ^ 0xFFFFFFFFu;
+    for (int i = 0; i < len; i++)
+        c = crcTable[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
 
-               //1 - list all folders inside the current folder
-    dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
-    QFileInfoList foldersList = dir.entryInfoList();
+static quint32 crc32(const QByteArray & data) {
+    return crc32(0, reinterpret_cast<const uchar *>(data.constData()), data.size());
+}
 
-    if (callProcessEvents)
-        QCoreApplication::processEvents();
+// File digest is a checksum of the chunk checksums, so chunks can be verified in parallel.
+static quint32 updateDigest(quint32 digest, quint32 chunkCrc) {
+    uchar buf[sizeof(chunkCrc)];
+    qToBigEndian(chunkCrc, buf);
+    return crc32(digest, buf, int(sizeof(buf)));
+}
 
-    //2 - For each folder in list: call the same function with folders' paths
-    for (int i = 0; i < foldersList.length(); i++) {
-        QString folderName = foldersList.at(i).fileName();
-        QString folderPath = dir.absolutePath() + "/" + folderName;
-        QString newPrefex = prefix + "/" + folderName;
+////////////////////////////////////////////////////////////////////////////////////
+// Chunks processing with the thread pool
+
+enum class CHUNK_OP { COMPRESS, DECOMPRESS, CHECKSUM };
+
+struct ChunkJob {
+    CHUNK_OP op;
+    QByteArray input;
+    QByteArray output;
+    quint32 rawSize = 0;
+    quint32 crc = 0;   // chunk checksum, calculated for COMPRESS and CHECKSUM, verified for DECOMPRESS
+    bool ok = true;
+    QSemaphore done;
+
+    ChunkJob(CHUNK_OP _op, const QByteArray & _input, quint32 _rawSize, quint32 _crc) :
+            op(_op), input(_input), rawSize(_rawSize), crc(_crc) {}
+
+    void process() {
+        switch (op) {
+            case CHUNK_OP::COMPRESS:
+                crc = crc32(input);
+                output = qCompress(input);
+                break;
+            case CHUNK_OP::DECOMPRESS:
+                output = qUncompress(input);
+                ok = quint32(output.size()) == rawSize && crc32(output) == crc;
+                break;
+            case CHUNK_OP::CHECKSUM:
+                crc = crc32(input);
+                break;
+        }
+        input.clear();
+    }
+};
+
+// Pool task. Job is shared, the pipeline can drop it while the pool is finishing with the task.
+class ChunkTask : public QRunnable {
+public:
+    ChunkTask(std::shared_ptr<ChunkJob> _job) : job(_job) {}
+    virtual void run() override {
+        job->process();
+        job->done.release();
+    }
+private:
+    std::shared_ptr<ChunkJob> job;
+};
+
+// Chunks are processed in parallel, results are taken in the order they were submitted.
+// Number of chunks in flight is limited, so memory usage is bounded.
+class ChunkPipeline {
+public:
+    ChunkPipeline(bool _callProcessEvents) : callProcessEvents(_callProcessEvents) {
+        initCrcTable();
+        pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+        maxInFlight = pool.maxThreadCount() * 2;
+    }
 
-        compress(dataStream, folderPath, newPrefex, callProcessEvents);
+    ~ChunkPipeline() {
+        // Workers are using the jobs, waiting for all of them
+        pool.waitForDone();
     }
 
-    //3 - List all files inside the current folder
-    dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
-    QFileInfoList filesList = dir.entryInfoList();
+    bool isFull() const {return int(jobs.size()) >= maxInFlight;}
+    bool isEmpty() const {return jobs.empty();}
 
-    //4- For each file in list: add file path and compressed binary data
-    for (int i = 0; i < filesList.length(); i++)
-    {
-        if (callProcessEvents)
-            QCoreApplication::processEvents();
+    void submit(CHUNK_OP op, const QByteArray & data, quint32 rawSize = 0, quint32 crc = 0) {
+        std::shared_ptr<ChunkJob> job = std::make_shared<ChunkJob>(op, data, rawSize, crc);
+        pool.start(new ChunkTask(job));
+        jobs.push_back(job);
+    }
 
-        QFile file(dir.absolutePath() + "/" + filesList.at(i).fileName());
-        if (!file.open(QIODevice::ReadOnly))//couldn't open file
-        {
-            return QPair<bool, QString>(false, "Unable to open file " + QFileInfo(file).absoluteFilePath() );
+    // Wait for the oldest job and return it
+    std::shared_ptr<ChunkJob> takeResult() {
+        Q_ASSERT(!jobs.empty());
+        std::shared_ptr<ChunkJob> job = jobs.front();
+        jobs.pop_front();
+        while (!job->done.tryAcquire(1, WAIT_EVENTS_MS)) {
+            if (callProcessEvents)
+                QCoreApplication::processEvents();
         }
+        return job;
+    }
+
+private:
+    bool callProcessEvents;
+    QThreadPool pool;
+    int maxInFlight = 2;
+    std::deque<std::shared_ptr<ChunkJob>> jobs;
+};
+
+////////////////////////////////////////////////////////////////////////////////////
+// Export
+
+struct ArchEntry {
+    bool isDir = false;
+    QString name; // relative to the archive root
+    qint64 size = 0;
+};
+
+struct IndexRecord {
+    QString name;
+    qint64 size = 0;
+    quint32 digest = 0;
+    qint64 offset = 0; // ARCH_FILE_CHUNKED record position
+};
+
+// Same order as legacy archive: folder, its subfolders, its files.
+static bool listFolder(const QString & folder, const QString & prefix, QVector<ArchEntry> & entries, QString & error) {
+    QDir dir(folder);
+    if (!dir.exists()) {
+        error = "Unable to compress directory " + folder;
+        return false;
+    }
 
-        dataStream << int(ARCH_FILE_VER);
-        dataStream << QString(prefix + "/" + filesList.at(i).fileName());
-        dataStream << qCompress(file.readAll());
+    ArchEntry dirEntry;
+    dirEntry.isDir = true;
+    dirEntry.name = prefix;
+    entries.push_back(dirEntry);
 
-        file.close();
+    dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
+    for (const QFileInfo & fi : dir.entryInfoList()) {
+        if (!listFolder(dir.absolutePath() + "/" + fi.fileName(), prefix + "/" + fi.fileName(), entries, error))
+            return false;
     }
 
-    return QPair<bool, QString>( true, "" );
+    dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
+    for (const QFileInfo & fi : dir.entryInfoList()) {
+        ArchEntry fileEntry;
+        fileEntry.name = prefix + "/" + fi.fileName();
+        fileEntry.size = fi.size();
+        entries.push_back(fileEntry);
+    }
+    return true;
 }
 
+static void writeChunk(QDataStream & out, const ChunkJob & job) {
+    out << job.rawSize << job.crc << job.output;
+}
 
-//A recursive function that scans all files inside the source folder
-//and serializes all files in a row of file names and compressed
-//binary data in a single file
-// return: <success, Error Message>
-QPair<bool, QString> compressFolder(QString sourceFolder, QString destinationFile, const QString & archiveTag, bool callProcessEvents) {
+QPair<bool, QString> compressFolder(QString sourceFolder, QString destinationFile, const QString & archiveTag,
+                                    bool callProcessEvents, ProgressCallback progress) {
     QDir src(sourceFolder);
     if(!src.exists())
         return QPair<bool, QString>(false, "Not found source folder " + sourceFolder);
 
-    QFile file;
-    file.setFileName(destinationFile);
+    QVector<ArchEntry> entries;
+    QString error;
+    if (!listFolder(sourceFolder, "", entries, error))
+        return QPair<bool, QString>(false, error);
+
+    qint64 total = 0;
+    for (const auto & e : entries)
+        total += e.size;
+    qint64 processed = 0;
+
+    // Archive appear only when it is complete
+    QSaveFile file(destinationFile);
     if(!file.open(QIODevice::WriteOnly))
         return QPair<bool, QString>(false, "Unable to create archive file " + destinationFile);
 
-    QDataStream dataStream;
-    dataStream.setDevice(&file);
+    QDataStream dataStream(&file);
 
     // File version
-    dataStream << int(ARCH_VERSION);
+    dataStream << int(ARCH_VERSION_CHUNKED);
     dataStream << archiveTag;
 
-    QPair<bool, QString> compResult = compress(dataStream, sourceFolder, "", callProcessEvents);
+    ChunkPipeline pipeline(callProcessEvents);
+    QVector<IndexRecord> index;
 
-    dataStream << int(ARCH_END);
+    for (const ArchEntry & e : entries) {
+        if (e.isDir) {
+            dataStream << int(ARCH_DIR_VER);
+            dataStream << e.name;
+            continue;
+        }
 
-    file.close();
+        QFile srcFile(sourceFolder + "/" + e.name);
+        if (!srcFile.open(QIODevice::ReadOnly))
+            return QPair<bool, QString>(false, "Unable to open file " + QFileInfo(srcFile).absoluteFilePath() );
+
+        IndexRecord rec;
+        rec.name = e.name;
+        rec.size = srcFile.size(); // Might be different from the scan time, we are archiving what we read.
+        rec.offset = file.pos();
+
+        dataStream << int(ARCH_FILE_CHUNKED);
+        dataStream << e.name;
+        dataStream << rec.size;
+
+        qint64 remaining = rec.size;
+        while (remaining > 0 || !pipeline.isEmpty()) {
+            if (remaining > 0 && !pipeline.isFull()) {
+                QByteArray data = srcFile.read(std::min(qint64(CHUNK_SIZE), remaining));
+                if (data.isEmpty())
+                    return QPair<bool, QString>(false, "Unable to read file " + QFileInfo(srcFile).absoluteFilePath() );
+                remaining -= data.size();
+                pipeline.submit(CHUNK_OP::COMPRESS, data, quint32(data.size()));
+                continue;
+            }
 
-    return compResult;
-}
+            std::shared_ptr<ChunkJob> job = pipeline.takeResult();
+            writeChunk(dataStream, *job);
+            rec.digest = updateDigest(rec.digest, job->crc);
 
-//A function that deserializes data from the compressed file and
-//creates any needed subfolders before saving the file
-// return: <success, Error Message>
-QPair<bool, QString> decompressFolder(QString sourceFile, QString destinationFolder, const QString & archiveTag, bool callProcessEvents) {
+            processed += job->rawSize;
+            if (progress)
+                progress(processed, total);
+        }
 
-    //validation
-    QFile src(sourceFile);
-    if (!src.exists()) {//file not found, to handle later
-        return QPair<bool, QString>( false, "Not found file to extract the data from: " + sourceFile );
-    }
+        if (dataStream.status() != QDataStream::Ok)
+            return QPair<bool, QString>(false, "Unable to write into archive file " + destinationFile + ", " + file.errorString());
 
-    QFile file;
-    file.setFileName(sourceFile);
-    if (!file.open(QIODevice::ReadOnly))
-        return QPair<bool, QString>( false, "Unable to open file to extract the data from: " + sourceFile );
+        index.push_back(rec);
+    }
 
-    QDataStream dataStream;
-    dataStream.setDevice(&file);
+    // Index at the end, so import can check what is already done
+    const qint64 indexOffset = file.pos();
+    dataStream << int(ARCH_INDEX);
+    dataStream << qint32(index.size());
+    for (const auto & rec : index)
+        dataStream << rec.name << rec.size << rec.digest << rec.offset;
 
-    int version;
-    dataStream >> version;
+    dataStream << int(ARCH_END);
+    dataStream << indexOffset;
 
-    if (version!=ARCH_VERSION)
-        return QPair<bool, QString>( false, "File " + sourceFile + " has wrong format. Unable to process this data." );
+    if (dataStream.status() != QDataStream::Ok || !file.commit())
+        return QPair<bool, QString>(false, "Unable to write into archive file " + destinationFile + ", " + file.errorString());
 
-    QString archTag;
-    dataStream >> archTag;
+    return QPair<bool, QString>( true, "" );
+}
 
-    if (archTag != archiveTag) {
-        return QPair<bool, QString>( false, "File " + sourceFile + " has was expected for '" + archTag + "', but expected '" + archTag + "'" );
-    }
+////////////////////////////////////////////////////////////////////////////////////
+// Import
 
+static QPair<bool, QString> decompressLegacy(QDataStream & dataStream, QFile & file, QString sourceFile, QString destinationFolder, bool callProcessEvents) {
     // Cleaning up destination dir first
 
     QDir dir(destinationFolder);
@@ -200,4 +377,249 @@ QPair<bool, QString> decompressFolder(QString sourceFile, QString destinationFol
     return QPair<bool, QString>( true,"");
 }
 
-}
\ No newline at end of file
+// Index is located with the trailer: ARCH_END and index offset
+static bool readIndex(QFile & file, QDataStream & dataStream, QHash<QString, IndexRecord> & index) {
+    const qint64 trailerSize = sizeof(qint32) + sizeof(qint64);
+    if (file.size() < trailerSize || !file.seek(file.size() - trailerSize))
+        return false;
+
+    int endId = 0;
+    qint64 indexOffset = -1;
+    dataStream >> endId >> indexOffset;
+    if (endId != ARCH_END || indexOffset <= 0 || indexOffset >= file.size() || !file.seek(indexOffset))
+        return false;
+
+    int indexId = 0;
+    qint32 sz = 0;
+    dataStream >> indexId >> sz;
+    if (indexId != ARCH_INDEX || sz < 0)
+        return false;
+
+    for (qint32 i = 0; i < sz && dataStream.status() == QDataStream::Ok; i++) {
+        IndexRecord rec;
+        dataStream >> rec.name >> rec.size >> rec.digest >> rec.offset;
+        index.insert(rec.name, rec);
+    }
+    return dataStream.status() == QDataStream::Ok;
+}
+
+// Calculate digest of the existing file. Return false if it doesn't match the index.
+static bool isFileExtracted(const QString & fileName, const IndexRecord & rec, ChunkPipeline & pipeline) {
+    QFile f(fileName);
+    if (f.size() != rec.size || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    quint32 digest = 0;
+    qint64 remaining = rec.size;
+    while (remaining > 0 || !pipeline.isEmpty()) {
+        if (remaining > 0 && !pipeline.isFull()) {
+            QByteArray data = f.read(std::min(qint64(CHUNK_SIZE), remaining));
+            if (data.isEmpty())
+                break;
+            remaining -= data.size();
+            pipeline.submit(CHUNK_OP::CHECKSUM, data);
+            continue;
+        }
+        digest = updateDigest(digest, pipeline.takeResult()->crc);
+    }
+    while (!pipeline.isEmpty())
+        pipeline.takeResult();
+
+    return remaining == 0 && digest == rec.digest;
+}
+
+// Removing everything that is not a part of the archive, including incomplete files from the previous run
+static bool cleanDestination(const QString & destinationFolder, const QHash<QString, IndexRecord> & index, const QSet<QString> & dirs) {
+    QDir destDir(destinationFolder);
+    QDirIterator it(destinationFolder, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories);
+    QStringList files2del;
+    QStringList dirs2del;
+    while (it.hasNext()) {
+        it.next();
+        const QString name = "/" + destDir.relativeFilePath(it.filePath());
+        if (it.fileInfo().isDir()) {
+            if (!dirs.contains(name))
+                dirs2del.push_back(it.filePath());
+        }
+        else if (!index.contains(name)) {
+            files2del.push_back(it.filePath());
+        }
+    }
+
+    for (const auto & fn : files2del) {
+        if (QFile::exists(fn) && !QFile::remove(fn))
+            return false;
+    }
+    for (const auto & dn : dirs2del) {
+        QDir d(dn);
+        if (d.exists() && !d.removeRecursively())
+            return false;
+    }
+    return true;
+}
+
+static QPair<bool, QString> decompressChunked(QDataStream & dataStream, QFile & file, QString sourceFile, QString destinationFolder,
+                                              bool callProcessEvents, ProgressCallback progress) {
+    const qint64 dataStart = file.pos();
+
+    QHash<QString, IndexRecord> index;
+    if (!readIndex(file, dataStream, index))
+        return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted or incomplete, archive index is not found. Unable to extract the data." );
+
+    qint64 total = 0;
+    for (const auto & rec : index)
+        total += rec.size;
+    qint64 processed = 0;
+
+    QDir dir(destinationFolder);
+    if (!dir.mkpath(destinationFolder))
+        return QPair<bool, QString>( false, "Unable to create destination directory " + destinationFolder );
+
+    // Folders with the archive files. Empty folders will be created from the archive records.
+    QSet<QString> dirs;
+    for (const auto & rec : index) {
+        QString d = rec.name.left(rec.name.lastIndexOf('/'));
+        while (!d.isEmpty() && !dirs.contains(d)) {
+            dirs.insert(d);
+            d = d.left(d.lastIndexOf('/'));
+        }
+    }
+    if (!cleanDestination(destinationFolder, index, dirs))
+        return QPair<bool, QString>( false, "Unable to clean up destination directory " + destinationFolder );
+
+    if (!file.seek(dataStart))
+        return QPair<bool, QString>( false, "Unable to read " + sourceFile );
+
+    ChunkPipeline pipeline(callProcessEvents);
+
+    while (true) {
+        if (dataStream.status() != QDataStream::Ok || dataStream.atEnd())
+            return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted. Unable to finish extraction." );
+
+        if (callProcessEvents)
+            QCoreApplication::processEvents();
+
+        int dataId = 0;
+        dataStream >> dataId;
+
+        if (dataId == ARCH_DIR_VER) {
+            QString dirName;
+            dataStream >> dirName;
+            if (!dirName.isEmpty()) {
+                if (!dir.mkpath(destinationFolder + "/" + dirName) )
+                    return QPair<bool, QString>( false, "Unable to create directory " + destinationFolder );
+            }
+        }
+        else if ( dataId == ARCH_FILE_CHUNKED ) {
+            QString fileName;
+            qint64 fileSize = 0;
+            dataStream >> fileName >> fileSize;
+            if (!index.contains(fileName) || index[fileName].size != fileSize)
+                return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted, index doesn't match the data." );
+
+            const IndexRecord rec = index[fileName];
+            const QString destFileName = destinationFolder + "/" + fileName;
+
+            if (isFileExtracted(destFileName, rec, pipeline)) {
+                // Extracted by the previous run, skipping the chunks
+                for (qint64 remaining = fileSize; remaining > 0; ) {
+                    quint32 rawSize = 0, crc = 0, compressedSize = 0;
+                    dataStream >> rawSize >> crc >> compressedSize;
+                    if (dataStream.status() != QDataStream::Ok || rawSize == 0 || qint64(rawSize) > remaining ||
+                            dataStream.skipRawData(int(compressedSize)) != int(compressedSize))
+                        return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted. Unable to finish extraction." );
+                    remaining -= rawSize;
+                }
+                processed += fileSize;
+                if (progress)
+                    progress(processed, total);
+                continue;
+            }
+
+            QFile outFile(destFileName + PART_SUFFIX);
+            if (!outFile.open(QIODevice::WriteOnly))
+                return QPair<bool, QString>( false, "Unable to create resulting file " + QFileInfo(outFile).absoluteFilePath() );
+
+            quint32 digest = 0;
+            qint64 remaining = fileSize;
+            while (remaining > 0 || !pipeline.isEmpty()) {
+                if (remaining > 0 && !pipeline.isFull()) {
+                    quint32 rawSize = 0, crc = 0;
+                    QByteArray compressed;
+                    dataStream >> rawSize >> crc >> compressed;
+                    if (dataStream.status() != QDataStream::Ok || rawSize == 0 || rawSize > quint32(CHUNK_SIZE) || qint64(rawSize) > remaining)
+                        return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted. Unable to finish extraction." );
+                    remaining -= rawSize;
+                    pipeline.submit(CHUNK_OP::DECOMPRESS, compressed, rawSize, crc);
+                    continue;
+                }
+
+                std::shared_ptr<ChunkJob> job = pipeline.takeResult();
+                if (!job->ok)
+                    return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted, checksum doesn't match for " + fileName + ". Unable to finish extraction." );
+                if (outFile.write(job->output) != job->output.size())
+                    return QPair<bool, QString>( false, "Unable to write into " + QFileInfo(outFile).absoluteFilePath() + ", " + outFile.errorString() );
+                digest = updateDigest(digest, job->crc);
+
+                processed += job->rawSize;
+                if (progress)
+                    progress(processed, total);
+            }
+            outFile.close();
+
+            if (digest != rec.digest)
+                return QPair<bool, QString>( false, "File " + sourceFile + " is corrupted, checksum doesn't match for " + fileName + ". Unable to finish extraction." );
+
+            // File is complete
+            QFile::remove(destFileName);
+            if (!QFile::rename(destFileName + PART_SUFFIX, destFileName))
+                return QPair<bool, QString>( false, "Unable to create resulting file " + destFileName );
+        }
+        else if ( dataId == ARCH_INDEX ) {
+            break; // all data is processed
+        }
+        else {
+            return QPair<bool, QString>( false, "File " + sourceFile + " corrupted or has wrong format. Unable to finish extraction." );
+        }
+    }
+
+    return QPair<bool, QString>( true,"");
+}
+
+QPair<bool, QString> decompressFolder(QString sourceFile, QString destinationFolder, const QString & archiveTag,
+                                      bool callProcessEvents, ProgressCallback progress) {
+
+    //validation
+    QFile src(sourceFile);
+    if (!src.exists()) {//file not found, to handle later
+        return QPair<bool, QString>( false, "Not found file to extract the data from: " + sourceFile );
+    }
+
+    QFile file;
+    file.setFileName(sourceFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return QPair<bool, QString>( false, "Unable to open file to extract the data from: " + sourceFile );
+
+    QDataStream dataStream;
+    dataStream.setDevice(&file);
+
+    int version;
+    dataStream >> version;
+
+    if (version!=ARCH_VERSION && version!=ARCH_VERSION_CHUNKED)
+        return QPair<bool, QString>( false, "File " + sourceFile + " has wrong format. Unable to process this data." );
+
+    QString archTag;
+    dataStream >> archTag;
+
+    if (archTag != archiveTag) {
+        return QPair<bool, QString>( false, "File " + sourceFile + " was created for '" + archTag + "', but expected '" + archiveTag + "'" );
+    }
+
+    if (version == ARCH_VERSION)
+        return decompressLegacy(dataStream, file, sourceFile, destinationFolder, callProcessEvents);
+
+    return decompressChunked(dataStream, file, sourceFile, destinationFolder, callProcessEvents, progress);
+}
+
+}
@@ -12,27 +12,37 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-
 #ifndef MWC_QT_WALLET_FOLDERCOMPRESSOR_H
 #define MWC_QT_WALLET_FOLDERCOMPRESSOR_H
 
 #include <QPair>
+#include <QString>
+#include <functional>
 
 namespace compress {
 
-//A recursive function that scans all files inside the source folder
-//and serializes all files in a row of file names and compressed
-//binary data in a single file
+// Progress of the compression/decompression: processed and total bytes of the uncompressed data
+typedef std::function<void(qint64 processed, qint64 total)> ProgressCallback;
+
+// Scans all files inside the source folder and writes them into a single archive file.
+// Files are split into chunks, chunks are compressed by the thread pool, every chunk has a checksum.
+// Memory usage is bounded by the number of chunks in flight. The archive ends with the files index.
 // archiveTag - will be written into archive
+// callProcessEvents - if true - will periodically call QCoreApplication::processEvents();
 // return: <success, Error Message>
-QPair<bool, QString> compressFolder(QString sourceFolder, QString destinationFile, const QString & archiveTag, bool callProcessEvents = true);
-
-//A function that deserializes data from the compressed file and
-//creates any needed subfolders before saving the file
+QPair<bool, QString> compressFolder(QString sourceFolder, QString destinationFile, const QString & archiveTag,
+                                    bool callProcessEvents = true, ProgressCallback progress = nullptr);
+
+// Extracts the archive into the destination folder. Both the chunked and the legacy single block per file
+// archives are supported.
+// For chunked archives the import can be resumed: files that are already extracted and match the index
+// are kept, files that are not in the archive are removed. Every chunk is verified with its checksum.
+// Legacy archives are extracted into the clean destination folder.
 // archiveTag - expected archive tag. Example: network. This tag will be checked.
 // callProcessEvents - if true - will periodically call QCoreApplication::processEvents();
 // return: <success, Error Message>
-QPair<bool, QString> decompressFolder(QString sourceFile, QString destinationFolder, const QString & archiveTag, bool callProcessEvents = true);
+QPair<bool, QString> decompressFolder(QString sourceFile, QString destinationFolder, const QString & archiveTag,
+                                      bool callProcessEvents = true, ProgressCallback progress = nullptr);
 
 
 }
@@ -14,12 +14,16 @@
 
 #include "Log.h"
 #include "ioutils.h"
+#include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QApplication>
 #include <QDateTime>
 #include "../wallet/mwc713task.h"
 #include <QProcess>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <algorithm>
 #include "../core/Config.h"
 #include "../core/WndManager.h"
 
@@ -28,6 +32,12 @@
 #define LOG_SIZE_LIMIT  10000000
 // Number of files for rotation
 #define LOG_FILES_POOL_SIZE 50
+// Number of records that can wait for the writer. Node sync can produce thousands lines per minute.
+#define LOG_QUEUE_SIZE 16384
+// Writer flushes the data when batch reach that size...
+#define LOG_BATCH_SIZE 65536
+// ...or by time
+#define LOG_FLUSH_PERIOD_MS 200
 
 
 namespace logger {
@@ -38,6 +48,9 @@ static LogReceiver * logServer = nullptr;
 static bool logMwc713outBlocked = false;
 
 const QString LOG_FILE_NAME = "mwcwallet.log";
+// Log file is renamed with this prefix, then compressor will archive it
+const QString ROTATED_LOG_PREFIX = "rotated_";
+const QString ARCHIVE_TIME_FORMAT = "yyyy_MM_dd_hh_mm_ss_zzz";
 
 void initLogger( bool logsEnabled) {
     logClient = new LogSender(true);
@@ -58,6 +71,10 @@ void cleanUpLogs() {
 
     QFile::remove(logPath.second + "/" + LOG_FILE_NAME);
     QFile::remove(logPath.second + "/prev_" + LOG_FILE_NAME);
+
+    QStringList rotated = QDir(logPath.second).entryList( {ROTATED_LOG_PREFIX + "*"}, QDir::Files );
+    for (const auto & fn : rotated)
+        QFile::remove(logPath.second + "/" + fn);
 }
 
 // enable/disable logs
@@ -101,23 +118,249 @@ LogReceiver::LogReceiver(const QString & filename) :
 
     logPath = path.second;
 
-    rotateLogFileIfNeeded();
-    openLogFile();
+    {
+        // Checking here, writer thread can't report to the user
+        QFile testFile(logPath + "/" + logFileName);
+        if (!testFile.open(QFile::WriteOnly | QFile::Append)) {
+            core::getWndManager()->messageTextDlg("Critical Error", "Unable to open the logger file: " + logPath);
+            QApplication::quit();
+            return;
+        }
+    }
+
+    compressor = new LogCompressor(logPath, logFileName);
+    connect(compressor, &LogCompressor::onRotationFailed, this, &LogReceiver::onRotationFailed, Qt::QueuedConnection);
+
+    // Files that was rotated but not compressed because wallet was closed
+    QStringList rotated = QDir(logPath).entryList( {ROTATED_LOG_PREFIX + "*"}, QDir::Files, QDir::Name );
+    for (const auto & fn : rotated)
+        compressor->compress(fn);
+
+    if ( QFileInfo(logPath + "/" + logFileName).size() >= LOG_SIZE_LIMIT )
+        LogWriter::rotateLogFile(logPath, logFileName, compressor);
+
+    compressor->start(QThread::LowPriority);
+
+    writer = new LogWriter(logPath, logFileName, compressor);
+    writer->start();
 }
 
 LogReceiver::~LogReceiver() {
+    // Writer first, it might rotate the file at the end
+    if (writer) {
+        writer->stop();
+        delete writer;
+    }
+    if (compressor) {
+        compressor->stop();
+        delete compressor;
+    }
+}
+
+void LogReceiver::onAppend2logs(bool addDate, QString prefix, QString line ) {
+    if (writer == nullptr)
+        return;
+
+    QString logLine;
+    if (addDate)
+        logLine += QDateTime::currentDateTime().toString("dd.MM.yyyy hh:mm:ss.zzz") + " ";
+
+    logLine += prefix + " " + line + "\n";
+
+    // If queue is full, record is dropped and writer will report the number of lost records
+    writer->append( logLine.toUtf8() );
+}
+
+void LogReceiver::onRotationFailed(QString path) {
+    core::getWndManager()->messageTextDlg("Log files rotation", "Unable to rotate log file at "+ path +"\nYour previous file will be swapped with a new log data.");
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+// LogWriter
+
+LogWriter::LogWriter(const QString & _logPath, const QString & _logFileName, LogCompressor * _compressor) :
+        logPath(_logPath),
+        logFileName(_logFileName),
+        compressor(_compressor),
+        records(LOG_QUEUE_SIZE),
+        droppedRecords(0),
+        alive(1),
+        writerIdle(0)
+{
+}
+
+LogWriter::~LogWriter() {
+    Q_ASSERT(isFinished() || !isRunning());
     delete logFile;
 }
 
-void LogReceiver::rotateLogFileIfNeeded() {
-    QString logPathName = logPath + "/" + logFileName;
-    QFileInfo fi(logPathName);
+bool LogWriter::append(QByteArray record) {
+    // Logging must never block the caller. The writer reports the dropped records into the log.
+    const bool pushed = records.push(std::move(record));
+    if (!pushed)
+        droppedRecords.fetchAndAddRelaxed(1);
+
+    wakeWriter();
+    return pushed;
+}
+
+void LogWriter::wakeWriter() {
+    // Only the first record after the writer fall asleep need to wake it up.
+    // Ordered exchange pairs with the one at the writer, so either the writer see the record or we see the flag.
+    if (writerIdle.fetchAndStoreOrdered(0) == 1) {
+        QMutexLocker l(&wakeLock);
+        wakeCondition.wakeOne();
+    }
+}
 
-    if (fi.size() < LOG_SIZE_LIMIT)
+void LogWriter::stop() {
+    alive.storeRelease(0);
+    {
+        QMutexLocker l(&wakeLock);
+        wakeCondition.wakeOne();
+    }
+    wait();
+}
+
+void LogWriter::rotateLogFile(const QString & logPath, const QString & logFileName, LogCompressor * compressor) {
+    QString rotatedFileName = ROTATED_LOG_PREFIX + QDateTime::currentDateTime().toString(ARCHIVE_TIME_FORMAT) + "_" + logFileName;
+
+    qDebug() << "Rotating logs file: " << logPath + "/" + logFileName << " to " << rotatedFileName;
+
+    if (!QDir(logPath).rename(logFileName, rotatedFileName)) {
+        qDebug() << "Unable to rename the log file " << logFileName;
         return;
+    }
+    compressor->compress(rotatedFileName);
+}
 
-    qDebug() << "Rotating logs file: " << logPathName;
+bool LogWriter::openLogFile() {
+    Q_ASSERT(logFile == nullptr);
+    logFile = new QFile(logPath + "/" + logFileName);
+    if (!logFile->open(QFile::WriteOnly | QFile::Append)) {
+        qDebug() << "Unable to open the logger file: " << logFile->fileName();
+        delete logFile;
+        logFile = nullptr;
+        return false;
+    }
+    logFileSize = logFile->size();
+    return true;
+}
+
+void LogWriter::writeBatch(QByteArray & batch) {
+    if (logFile == nullptr && !openLogFile()) {
+        batch.resize(0);
+        return;
+    }
+
+    logFile->write(batch);
+    logFile->flush();
+    logFileSize += batch.size();
+    batch.resize(0); // keeping the buffer
+
+    if (logFileSize >= LOG_SIZE_LIMIT) {
+        delete logFile;
+        logFile = nullptr;
+        rotateLogFile(logPath, logFileName, compressor);
+        openLogFile();
+    }
+}
 
+void LogWriter::run() {
+    openLogFile();
+
+    QByteArray batch;
+    batch.reserve(LOG_BATCH_SIZE + 4096);
+    QElapsedTimer flushTimer;
+    flushTimer.start();
+
+    while (true) {
+        // Reading the flag before the queue, so records that was added before stop will be written
+        const bool stopping = alive.loadAcquire() == 0;
+
+        QByteArray record;
+        while (batch.size() < LOG_BATCH_SIZE && records.pop(record))
+            batch.append(record);
+        const bool full = batch.size() >= LOG_BATCH_SIZE;
+
+        const int dropped = droppedRecords.fetchAndStoreRelaxed(0);
+        if (dropped > 0) {
+            batch.append( (QDateTime::currentDateTime().toString("dd.MM.yyyy hh:mm:ss.zzz") +
+                           " logger Log queue is full, lost records: " + QString::number(dropped) + "\n").toUtf8() );
+        }
+
+        if ( full || stopping || (!batch.isEmpty() && flushTimer.elapsed() >= LOG_FLUSH_PERIOD_MS) ) {
+            if (!batch.isEmpty())
+                writeBatch(batch);
+            flushTimer.restart();
+
+            if (full)
+                continue;
+            if (stopping)
+                break;
+        }
+
+        // Sleeping until the flush time if there is something to write, otherwise until the next record
+        QMutexLocker l(&wakeLock);
+        writerIdle.fetchAndStoreOrdered(1);
+        if (records.isEmpty() && alive.loadAcquire() != 0) {
+            if (batch.isEmpty())
+                wakeCondition.wait(&wakeLock);
+            else
+                wakeCondition.wait(&wakeLock, ulong(std::max(qint64(1), LOG_FLUSH_PERIOD_MS - flushTimer.elapsed())));
+        }
+        writerIdle.storeRelease(0);
+    }
+
+    delete logFile;
+    logFile = nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+// LogCompressor
+
+LogCompressor::LogCompressor(const QString & _logPath, const QString & _logFileName) :
+        logPath(_logPath),
+        logFileName(_logFileName)
+{
+}
+
+LogCompressor::~LogCompressor() {
+    Q_ASSERT(isFinished() || !isRunning());
+}
+
+void LogCompressor::compress(const QString & rotatedFileName) {
+    QMutexLocker l(&queueLock);
+    queue.push_back(rotatedFileName);
+    queueCondition.wakeOne();
+}
+
+void LogCompressor::stop() {
+    {
+        QMutexLocker l(&queueLock);
+        alive = false;
+        queueCondition.wakeOne();
+    }
+    wait();
+}
+
+void LogCompressor::run() {
+    while (true) {
+        QString rotatedFileName;
+        {
+            QMutexLocker l(&queueLock);
+            while (alive && queue.isEmpty())
+                queueCondition.wait(&queueLock);
+            // Finishing the queue before exit
+            if (queue.isEmpty())
+                break;
+            rotatedFileName = queue.takeFirst();
+        }
+        compressFile(rotatedFileName);
+    }
+}
+
+void LogCompressor::compressFile(const QString & rotatedFileName) {
     // First check if need to clean up
     QStringList archives = QDir(logPath).entryList( {"*.zip"} );
     if (archives.size()>LOG_FILES_POOL_SIZE) {
@@ -130,21 +373,12 @@ void LogReceiver::rotateLogFileIfNeeded() {
         }
     }
 
-    bool logFileOpen = (logFile != nullptr);
-    if (logFile) {
-        delete logFile;
-        logFile = nullptr;
-    }
-
-    // Generate the file name
-    QDateTime  now = QDateTime::currentDateTime();
-    QString archiveFileName = now.toString("yyyy_MM_dd_hh_mm_ss_zzz")+".zip";
+    // Archive name is the rotation time
+    QString archiveFileName = rotatedFileName.mid(ROTATED_LOG_PREFIX.length(), ARCHIVE_TIME_FORMAT.length()) + ".zip";
 
-    QString srcFileName = logPath + "/" + logFileName;
+    QString srcFileName = logPath + "/" + rotatedFileName;
     QString resultFileName = logPath + "/" + archiveFileName;
 
-    // Find the mwczip location. It is expected ta the same directory where mwc713 located
-
     qDebug() << "Creating zip archive: " << resultFileName;
 
     // 3 is OK for the
@@ -154,47 +388,16 @@ void LogReceiver::rotateLogFileIfNeeded() {
     QDir logDir( logPath );
 
     if (exitCode!=3) {
-        core::getWndManager()->messageTextDlg("Log files rotation", "Unable to rotate log file at "+ logPath +"\nYour previous file will be swapped with a new log data.");
         const QString prevLogFn = "prev_"+logFileName;
         logDir.remove(prevLogFn);
-        logDir.rename(logFileName, prevLogFn);
+        logDir.rename(rotatedFileName, prevLogFn);
+        emit onRotationFailed(logPath);
     }
     else {
-        logDir.remove(logFileName);
-    }
-
-    if (logFileOpen)
-        openLogFile();
-}
-
-void LogReceiver::openLogFile() {
-    QString logFn = logPath + "/" + logFileName;
-    logFile = new QFile(logFn);
-    if (!logFile->open(QFile::WriteOnly | QFile::Append)) {
-        core::getWndManager()->messageTextDlg("Critical Error", "Unable to open the logger file: " + logPath);
-        QApplication::quit();
-        return;
+        logDir.remove(rotatedFileName);
     }
 }
 
-
-void LogReceiver::onAppend2logs(bool addDate, QString prefix, QString line ) {
-    counter++;
-    if (counter>10000) {
-        rotateLogFileIfNeeded();
-    }
-
-
-    QString logLine;
-    if (addDate)
-        logLine += QDateTime::currentDateTime().toString("dd.MM.yyyy hh:mm:ss.zzz") + " ";
-
-    logLine += prefix + " " + line + "\n";
-
-    logFile->write( logLine.toUtf8() );
-    logFile->flush();
-}
-
 // Global methods that do logging
 
 void blockLogMwc713out(bool blockOutput) {
@@ -16,6 +16,12 @@
 #define GUI_WALLET_LOG_H
 
 #include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QStringList>
+#include <QAtomicInteger>
+#include "ringbuffer.h"
 #include "../wallet/mwc713events.h"
 #include "../tries/NodeOutputParser.h"
 
@@ -44,6 +50,9 @@ namespace logger {
         bool asyncLogging; // Use QT messaging or write directly. Direct writing might cause concurrency issues
     };
 
+    class LogWriter;
+    class LogCompressor;
+
     class LogReceiver : public QObject {
         Q_OBJECT
     public:
@@ -51,15 +60,94 @@ namespace logger {
         virtual ~LogReceiver() override;
 
     public slots:
+        // Can be called from any thread. Line is formatted and queued for the writer thread.
         void onAppend2logs(bool addDate, QString prefix, QString line );
-    private:
-        void rotateLogFileIfNeeded();
-        void openLogFile();
+
+    private slots:
+        void onRotationFailed(QString logPath);
     private:
         QString logPath;
         const QString logFileName;
+        LogCompressor * compressor = nullptr;
+        LogWriter * writer = nullptr;
+    };
+
+    // Background thread that writes the queued records into the log file. Records are written by batches,
+    // file is flushed when the batch is big enough or by time. Full file is renamed and passed to the compressor.
+    class LogWriter : public QThread {
+        Q_OBJECT
+    public:
+        LogWriter(const QString & logPath, const QString & logFileName, LogCompressor * compressor);
+        virtual ~LogWriter() override;
+
+        // Any thread, never blocks. Writer is waken up only if it is sleeping.
+        // Return false if the queue is full and the record is dropped.
+        bool append(QByteArray record);
+
+        // Write everything that is queued and exit the thread.
+        void stop();
+
+        // Rename the log file and pass it to the compressor. Need to be called when the file is closed.
+        static void rotateLogFile(const QString & logPath, const QString & logFileName, LogCompressor * compressor);
+
+    protected:
+        void run() override;
+
+    private:
+        bool openLogFile();
+        void writeBatch(QByteArray & batch);
+        void wakeWriter();
+
+    private:
+        const QString logPath;
+        const QString logFileName;
+        LogCompressor * compressor;
+
+        util::MpscRingBuffer<QByteArray> records;
+        QAtomicInteger<int> droppedRecords;
+        QAtomicInteger<int> alive;
+
+        // Writer sleeps on the condition while there is nothing to do
+        QMutex wakeLock;
+        QWaitCondition wakeCondition;
+        QAtomicInteger<int> writerIdle;
+
+        // Writer thread only
         QFile * logFile = nullptr;
-        int counter = 0;
+        qint64 logFileSize = 0;
+    };
+
+    // Background thread that zips the rotated log files, so nobody waits for mwczip
+    class LogCompressor : public QThread {
+        Q_OBJECT
+    public:
+        LogCompressor(const QString & logPath, const QString & logFileName);
+        virtual ~LogCompressor() override;
+
+        // Any thread. rotatedFileName - file at logPath to archive and delete
+        void compress(const QString & rotatedFileName);
+
+        // Finish compression of the queued files and exit the thread.
+        void stop();
+
+    signals:
+        // mwczip failed, the rotated file is kept as the previous log file
+        void onRotationFailed(QString logPath);
+
+    protected:
+        void run() override;
+
+    private:
+        void compressFile(const QString & rotatedFileName);
+
+    private:
+        const QString logPath;
+        const QString logFileName;
+
+        QMutex queueLock;
+        QWaitCondition queueCondition;
+        QStringList queue;
+        bool alive = true;
     };
 
     // Must be call before first log usage
@@ -81,7 +169,7 @@ namespace logger {
     void logEmit(QString who, QString event, QString params);
     void logInfo(QString who, QString message);
 
-    // enable/disable logs
+    // enable/disable logs. Disabling writes all queued records.
     void enableLogs( bool enableLogs );
     // clean all logs
     void cleanUpLogs();
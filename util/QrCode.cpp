@@ -35,10 +35,32 @@ using std::int8_t;
 using std::uint8_t;
 using std::size_t;
 using std::vector;
+using std::uint64_t;
 
 
 namespace qrcodegen {
 
+// Bit helpers for the bit packed module grids
+static inline int popCount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// x must be non zero
+static inline int countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    return popCount((x & (0 - x)) - 1);
+#endif
+}
+
 QrSegment::Mode::Mode(int mode, int cc0, int cc1, int cc2) :
         modeBits(mode) {
     numBitsCharCount[0] = cc0;
@@ -326,9 +348,10 @@ QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk)
     if (msk < -1 || msk > 7)
         throw std::domain_error("Mask value out of range");
     size = ver * 4 + 17;
-    size_t sz = static_cast<size_t>(size);
-    modules    = vector<vector<bool> >(sz, vector<bool>(sz));  // Initially all white
-    isFunction = vector<vector<bool> >(sz, vector<bool>(sz));
+    rowWords = (size + 63) / 64;
+    size_t sz = static_cast<size_t>(size * rowWords);
+    modules    = vector<uint64_t>(sz);  // Initially all white
+    isFunction = vector<uint64_t>(sz);
 
     // Compute ECC, draw modules
     drawFunctionPatterns();
@@ -514,15 +537,27 @@ void QrCode::drawAlignmentPattern(int x, int y) {
 
 
 void QrCode::setFunctionModule(int x, int y, bool isBlack) {
-    size_t ux = static_cast<size_t>(x);
-    size_t uy = static_cast<size_t>(y);
-    modules   .at(uy).at(ux) = isBlack;
-    isFunction.at(uy).at(ux) = true;
+    setModule(x, y, isBlack);
+    isFunction.at(static_cast<size_t>(y * rowWords + (x >> 6))) |= uint64_t(1) << (x & 63);
 }
 
 
 bool QrCode::module(int x, int y) const {
-    return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+    return ((modules.at(static_cast<size_t>(y * rowWords + (x >> 6))) >> (x & 63)) & 1) != 0;
+}
+
+
+void QrCode::setModule(int x, int y, bool isBlack) {
+    if (x < 0 || x >= size || y < 0 || y >= size)
+        throw std::out_of_range("Module out of range");
+    uint64_t &word = modules.at(static_cast<size_t>(y * rowWords + (x >> 6)));
+    uint64_t bit = uint64_t(1) << (x & 63);
+    word = isBlack ? (word | bit) : (word & ~bit);
+}
+
+
+bool QrCode::functionModule(int x, int y) const {
+    return ((isFunction.at(static_cast<size_t>(y * rowWords + (x >> 6))) >> (x & 63)) & 1) != 0;
 }
 
 
@@ -576,11 +611,11 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
             right = 5;
         for (int vert = 0; vert < size; vert++) {  // Vertical counter
             for (int j = 0; j < 2; j++) {
-                size_t x = static_cast<size_t>(right - j);  // Actual x coordinate
+                int x = right - j;  // Actual x coordinate
                 bool upward = ((right + 1) & 2) == 0;
-                size_t y = static_cast<size_t>(upward ? size - 1 - vert : vert);  // Actual y coordinate
-                if (!isFunction.at(y).at(x) && i < data.size() * 8) {
-                    modules.at(y).at(x) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7));
+                int y = upward ? size - 1 - vert : vert;  // Actual y coordinate
+                if (!functionModule(x, y) && i < data.size() * 8) {
+                    setModule(x, y, getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7)));
                     i++;
                 }
                 // If this QR Code has any remainder bits (0 to 7), they were assigned as
@@ -596,9 +631,13 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 void QrCode::applyMask(int msk) {
     if (msk < 0 || msk > 7)
         throw std::domain_error("Mask value out of range");
-    size_t sz = static_cast<size_t>(size);
-    for (size_t y = 0; y < sz; y++) {
-        for (size_t x = 0; x < sz; x++) {
+
+    // All mask patterns are repeating every 12 rows, so they are built once per mask as bit packed rows
+    const int PERIOD = 12;
+    vector<uint64_t> pattern(static_cast<size_t>(PERIOD * rowWords));
+    for (int py = 0; py < PERIOD && py < size; py++) {
+        for (int x = 0; x < size; x++) {
+            int y = py;
             bool invert;
             switch (msk) {
                 case 0:  invert = (x + y) % 2 == 0;                    break;
@@ -611,7 +650,16 @@ void QrCode::applyMask(int msk) {
                 case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
                 default:  throw std::logic_error("Assertion error");
             }
-            modules.at(y).at(x) = modules.at(y).at(x) ^ (invert & !isFunction.at(y).at(x));
+            if (invert)
+                pattern[static_cast<size_t>(py * rowWords + (x >> 6))] |= uint64_t(1) << (x & 63);
+        }
+    }
+
+    for (int y = 0; y < size; y++) {
+        const uint64_t *pat = &pattern[static_cast<size_t>((y % PERIOD) * rowWords)];
+        for (int w = 0; w < rowWords; w++) {
+            size_t i = static_cast<size_t>(y * rowWords + w);
+            modules[i] ^= pat[w] & ~isFunction[i];
         }
     }
 }
@@ -621,69 +669,42 @@ long QrCode::getPenaltyScore() const {
     long result = 0;
 
     // Adjacent modules in row having same color, and finder-like patterns
+    for (int y = 0; y < size; y++)
+        result += getLinePenaltyScore(&modules[static_cast<size_t>(y * rowWords)]);
+
+    // Adjacent modules in column having same color, and finder-like patterns. Columns are rows of the transposed grid.
+    vector<uint64_t> columns(modules.size());
     for (int y = 0; y < size; y++) {
-        bool runColor = false;
-        int runX = 0;
-        std::array<int,7> runHistory = {};
-        for (int x = 0; x < size; x++) {
-            if (module(x, y) == runColor) {
-                runX++;
-                if (runX == 5)
-                    result += PENALTY_N1;
-                else if (runX > 5)
-                    result++;
-            } else {
-                finderPenaltyAddHistory(runX, runHistory);
-                if (!runColor)
-                    result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-                runColor = module(x, y);
-                runX = 1;
+        for (int w = 0; w < rowWords; w++) {
+            for (uint64_t bits = modules[static_cast<size_t>(y * rowWords + w)]; bits != 0; bits &= bits - 1) {
+                int x = w * 64 + countTrailingZeros(bits);
+                columns[static_cast<size_t>(x * rowWords + (y >> 6))] |= uint64_t(1) << (y & 63);
             }
         }
-        result += finderPenaltyTerminateAndCount(runColor, runX, runHistory) * PENALTY_N3;
-    }
-    // Adjacent modules in column having same color, and finder-like patterns
-    for (int x = 0; x < size; x++) {
-        bool runColor = false;
-        int runY = 0;
-        std::array<int,7> runHistory = {};
-        for (int y = 0; y < size; y++) {
-            if (module(x, y) == runColor) {
-                runY++;
-                if (runY == 5)
-                    result += PENALTY_N1;
-                else if (runY > 5)
-                    result++;
-            } else {
-                finderPenaltyAddHistory(runY, runHistory);
-                if (!runColor)
-                    result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-                runColor = module(x, y);
-                runY = 1;
-            }
-        }
-        result += finderPenaltyTerminateAndCount(runColor, runY, runHistory) * PENALTY_N3;
     }
+    for (int x = 0; x < size; x++)
+        result += getLinePenaltyScore(&columns[static_cast<size_t>(x * rowWords)]);
 
-    // 2*2 blocks of modules having same color
+    // 2*2 blocks of modules having same color. Bit x is set if block with top left module at x is of the same color.
     for (int y = 0; y < size - 1; y++) {
-        for (int x = 0; x < size - 1; x++) {
-            bool  color = module(x, y);
-            if (  color == module(x + 1, y) &&
-                  color == module(x, y + 1) &&
-                  color == module(x + 1, y + 1))
-                result += PENALTY_N2;
+        const uint64_t *row0 = &modules[static_cast<size_t>(y * rowWords)];
+        const uint64_t *row1 = row0 + rowWords;
+        for (int w = 0; w < rowWords; w++) {
+            uint64_t next0 = (row0[w] >> 1) | (w + 1 < rowWords ? row0[w + 1] << 63 : 0);
+            uint64_t next1 = (row1[w] >> 1) | (w + 1 < rowWords ? row1[w + 1] << 63 : 0);
+            uint64_t same = ~(row0[w] ^ row1[w]) & ~(row0[w] ^ next0) & ~(row1[w] ^ next1);
+            // Only blocks with x < size - 1
+            int validBits = std::min(64, size - 1 - w * 64);
+            if (validBits < 64)
+                same &= (uint64_t(1) << validBits) - 1;
+            result += popCount(same) * PENALTY_N2;
         }
     }
 
     // Balance of black and white modules
     int black = 0;
-    for (const vector<bool> &row : modules) {
-        for (bool color : row) {
-            if (color)
-                black++;
-        }
-    }
+    for (uint64_t word : modules)
+        black += popCount(word);
     int total = size * size;  // Note that size is odd, so black/total != 1/2
     // Compute the smallest integer k >= 0 such that (45-5k)% <= black/total <= (55+5k)%
     int k = static_cast<int>((std::abs(black * 20L - total * 10L) + total - 1) / total) - 1;
@@ -692,6 +713,48 @@ long QrCode::getPenaltyScore() const {
 }
 
 
+long QrCode::getLinePenaltyScore(const uint64_t *line) const {
+    long result = 0;
+    std::array<int,7> runHistory = {};
+
+    // Line is starting with the white run. It is empty if the first module is black.
+    bool runColor = false;
+    int runStart = 0;
+    int pos = 0;
+    while (true) {
+        // Find the end of the current run: the first module of another color
+        int runEnd = size;
+        for (int w = pos >> 6; w < rowWords; w++) {
+            uint64_t diff = runColor ? ~line[w] : line[w];
+            if (w == (pos >> 6))
+                diff &= ~uint64_t(0) << (pos & 63);
+            if (diff != 0) {
+                runEnd = std::min(size, w * 64 + countTrailingZeros(diff));
+                break;
+            }
+        }
+
+        int runLength = runEnd - runStart;
+        if (runLength >= 5)
+            result += PENALTY_N1 + runLength - 5;
+
+        if (runEnd >= size) {
+            result += finderPenaltyTerminateAndCount(runColor, runLength, runHistory) * PENALTY_N3;
+            break;
+        }
+
+        finderPenaltyAddHistory(runLength, runHistory);
+        if (!runColor)
+            result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
+
+        runColor = !runColor;
+        runStart = runEnd;
+        pos = runEnd;
+    }
+    return result;
+}
+
+
 vector<int> QrCode::getAlignmentPatternPositions() const {
     if (version == 1)
         return vector<int>();
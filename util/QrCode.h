@@ -312,14 +312,18 @@ private: Ecc errorCorrectionLevel;
      * the resulting object still has a mask value between 0 and 7. */
 private: int mask;
 
-    // Private grids of modules/pixels, with dimensions of size*size:
+    // Private grids of modules/pixels, with dimensions of size*size. Bit packed: every row takes
+    // rowWords 64 bit words, module x is bit (x % 64) of the word (x / 64). Bits after size are zeros.
 
-    // The modules of this QR Code (false = white, true = black).
+    // Number of words per row.
+private: int rowWords;
+
+    // The modules of this QR Code (0 = white, 1 = black).
     // Immutable after constructor finishes. Accessed through getModule().
-private: std::vector<std::vector<bool> > modules;
+private: std::vector<std::uint64_t> modules;
 
     // Indicates function modules that are not subjected to masking. Discarded when constructor finishes.
-private: std::vector<std::vector<bool> > isFunction;
+private: std::vector<std::uint64_t> isFunction;
 
 
 
@@ -412,6 +416,14 @@ private: void setFunctionModule(int x, int y, bool isBlack);
 private: bool module(int x, int y) const;
 
 
+    // Sets the color of a module. Coordinates must be in bounds.
+private: void setModule(int x, int y, bool isBlack);
+
+
+    // Returns true if the module at the given coordinates, which must be in range, is a function module.
+private: bool functionModule(int x, int y) const;
+
+
     /*---- Private helper methods for constructor: Codewords and masking ----*/
 
     // Returns a new byte string representing the given data with the appropriate error correction
@@ -434,9 +446,15 @@ private: void applyMask(int msk);
 
     // Calculates and returns the penalty score based on state of this QR Code's current modules.
     // This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
+    // Rows are processed a word at a time, columns are processed as rows of the transposed grid.
 private: long getPenaltyScore() const;
 
 
+    // Penalty for the same color runs and finder-like patterns of a single bit packed line of modules.
+    // Line is processed run by run, not module by module. A helper function for getPenaltyScore().
+private: long getLinePenaltyScore(const std::uint64_t *line) const;
+
+
 
     /*---- Private helper functions ----*/
 
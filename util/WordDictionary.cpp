@@ -316,6 +316,19 @@ QStringList  decompressWords(QString decompressedFn ) {
     return stackedWords;
 }
 
+// Restore the words from the stacked format
+QStringList unstackWords( const QStringList & stackedWords ) {
+    QStringList words;
+    QString stack;
+    for (const auto & wrd : stackedWords) {
+        int firstChIdx = 0;
+        int stackPop = 0;
+        int stackPush = 0;
+        words.push_back( applyStackOp( stack, firstChIdx, stackPop, stackPush, wrd) );
+    }
+    return words;
+}
+
 // return: <stack for, <index at stackedWords, stack prev > >
 QMap<QString, QPair<int, QString> > buildStackIndex( const QStringList & stackedWords ) {
     QString stack;
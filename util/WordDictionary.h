@@ -64,6 +64,9 @@ namespace dict {
     // Read the stream, uncompress it and build the index of the prefixes with the stacked list
     QStringList decompressWords(QString decompressedFn );
 
+    // Restore the words from the stacked format
+    QStringList unstackWords( const QStringList & stackedWords );
+
     // return: <stack for, <index at stackedWords, stack prev > >
     QMap<QString, QPair<int, QString> > buildStackIndex( const QStringList & stackedWords );
 
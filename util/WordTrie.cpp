@@ -0,0 +1,290 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "WordTrie.h"
+#include <QResource>
+#include <QFile>
+#include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QDataStream>
+#include <QtEndian>
+#include <QDebug>
+#include <vector>
+#include <algorithm>
+
+namespace dict {
+
+const static quint32 TRIE_MAGIC = 0x4D574454;
+const static quint32 TRIE_VERSION = 1;
+const static int TRIE_HEADER_SIZE = 4*4;
+
+const static quint32 INDEX_MASK = 0xFFFFFF;
+const static int VALUE_SHIFT = 24;
+const static int TARGET_SHIFT = 8;
+const static quint32 SYMBOL_MASK = 0xFF;
+
+WordTrie::WordTrie(const QString & fileName) {
+    QResource res(fileName);
+    if (res.isValid() && !res.isCompressed() && res.data() != nullptr) {
+        // Resource is a part of the binary, using it in place
+        data = QByteArray::fromRawData( (const char *) res.data(), int(res.size()) );
+    }
+    else {
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly))
+            data = file.readAll();
+    }
+
+    const uchar * buf = (const uchar *) data.constData();
+    if (data.size() < TRIE_HEADER_SIZE || qFromLittleEndian<quint32>(buf) != TRIE_MAGIC ||
+            qFromLittleEndian<quint32>(buf + 4) != TRIE_VERSION) {
+        qDebug() << "Unable to load the dictionary from " << fileName;
+        Q_ASSERT(false); // not expected to have empty dictionary.
+        data.clear();
+        return;
+    }
+
+    const qint64 nodesN = qFromLittleEndian<quint32>(buf + 8);
+    const qint64 edgesN = qFromLittleEndian<quint32>(buf + 12);
+    if ( TRIE_HEADER_SIZE + (nodesN + 1 + edgesN) * 4 != data.size() || nodesN == 0 ) {
+        qDebug() << "Dictionary " << fileName << " is corrupted";
+        Q_ASSERT(false);
+        data.clear();
+        return;
+    }
+
+    nodesNum = int(nodesN);
+    edgesNum = int(edgesN);
+    nodes = buf + TRIE_HEADER_SIZE;
+    edges = nodes + (nodesNum + 1) * 4;
+}
+
+quint32 WordTrie::getNode(int idx) const {
+    return qFromLittleEndian<quint32>(nodes + idx*4);
+}
+
+quint32 WordTrie::getEdge(int idx) const {
+    return qFromLittleEndian<quint32>(edges + idx*4);
+}
+
+int WordTrie::findChild(int node, ushort symbol) const {
+    if (symbol > SYMBOL_MASK)
+        return -1;
+
+    int lo = int(getNode(node) & INDEX_MASK);
+    int hi = int(getNode(node+1) & INDEX_MASK);
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        quint32 edge = getEdge(mid);
+        ushort s = ushort(edge & SYMBOL_MASK);
+        if (s == symbol)
+            return int(edge >> TARGET_SHIFT);
+        if (s < symbol)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return -1;
+}
+
+// Expected lo case inputs
+QString WordTrie::findLongestWord(const QString & str, int dictionary) const {
+    if (isEmpty())
+        return "";
+
+    int longest = 0;
+    int node = 0;
+    for (int k = 0; k < str.size(); k++) {
+        node = findChild(node, str[k].unicode());
+        if (node < 0)
+            break;
+        if (int(getNode(node) >> VALUE_SHIFT) == dictionary + 1)
+            longest = k + 1;
+    }
+    return str.left(longest);
+}
+
+QStringList WordTrie::detectDictionaryWords( const QString & str, QVector<double> & weights,
+                                             const QVector<double> & dictWeightSums ) const {
+    if (isEmpty())
+        return QStringList();
+
+    const QString str2check = str.toLower();
+    const int dictNum = dictWeightSums.size();
+    QVector<int> longest(dictNum); // per dictionary, for the current position
+    QSet<QString> foundWords;
+
+    // Words are at least 2 symbols long
+    for (int idx0 = 0; idx0 + 2 <= str2check.size(); idx0++) {
+        longest.fill(0);
+
+        int node = 0;
+        for (int k = idx0; k < str2check.size(); k++) {
+            node = findChild(node, str2check[k].unicode());
+            if (node < 0)
+                break;
+            int dict = int(getNode(node) >> VALUE_SHIFT) - 1;
+            if (dict >= 0 && dict < dictNum)
+                longest[dict] = k - idx0 + 1;
+        }
+
+        for (int d = 0; d < dictNum; d++) {
+            const int len = longest[d];
+            if (len == 0)
+                continue;
+
+            foundWords += str.mid(idx0, len);
+            double w = dictWeightSums[d] / len;
+            for (int t = idx0; t < idx0 + len; t++)
+                weights[t] = std::min( weights[t], w );
+        }
+    }
+
+    return QStringList( foundWords.values() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Trie compilation. Incremental construction of the minimal automaton from the sorted words
+// (Daciuk, Mihov, Watson, Watson). Nodes of the last added word are minimized when the next word is added.
+
+namespace {
+
+struct BuildNode {
+    int value = 0;
+    QVector< QPair<ushort, int> > edges; // symbol, node
+    bool registered = false;
+};
+
+class TrieBuilder {
+public:
+    TrieBuilder() : nodes(1) {}
+
+    // Words must be added in sorted order
+    void addWord(const QString & word, int value) {
+        int node = 0;
+        int common = 0;
+        while (common < word.size() && common < prevWord.size() && word[common] == prevWord[common]) {
+            node = nodes[node].edges.last().second;
+            common++;
+        }
+
+        if (!nodes[node].edges.isEmpty())
+            minimize(node);
+
+        for (int i = common; i < word.size(); i++) {
+            Q_ASSERT(word[i].unicode() <= SYMBOL_MASK);
+            nodes.push_back(BuildNode());
+            int next = int(nodes.size()) - 1;
+            nodes[node].edges.push_back( QPair<ushort, int>(word[i].unicode(), next) );
+            node = next;
+        }
+        nodes[node].value = value;
+        prevWord = word;
+    }
+
+    QByteArray build() {
+        if (!nodes[0].edges.isEmpty())
+            minimize(0);
+
+        // Numbering nodes in BFS order from the root, so the result doesn't depend on the construction
+        QVector<int> order;
+        QHash<int, int> number;
+        order.push_back(0);
+        number.insert(0, 0);
+        for (int q = 0; q < order.size(); q++) {
+            for (const auto & e : nodes[order[q]].edges) {
+                if (!number.contains(e.second)) {
+                    number.insert(e.second, order.size());
+                    order.push_back(e.second);
+                }
+            }
+        }
+
+        QVector<quint32> nodesData;
+        QVector<quint32> edgesData;
+        for (int n : order) {
+            nodesData.push_back( quint32(edgesData.size()) | (quint32(nodes[n].value) << VALUE_SHIFT) );
+            for (const auto & e : nodes[n].edges)
+                edgesData.push_back( quint32(e.first) | (quint32(number.value(e.second)) << TARGET_SHIFT) );
+        }
+        nodesData.push_back( quint32(edgesData.size()) );
+        Q_ASSERT( quint32(order.size()) <= INDEX_MASK && quint32(edgesData.size()) <= INDEX_MASK );
+
+        QByteArray res;
+        QDataStream out(&res, QIODevice::WriteOnly);
+        out.setByteOrder(QDataStream::LittleEndian);
+        out << TRIE_MAGIC << TRIE_VERSION << quint32(order.size()) << quint32(edgesData.size());
+        for (quint32 n : nodesData)
+            out << n;
+        for (quint32 e : edgesData)
+            out << e;
+        return res;
+    }
+
+private:
+    // Replace the last child chain with the equal registered nodes
+    void minimize(int node) {
+        int child = nodes[node].edges.last().second;
+        if (nodes[child].registered)
+            return;
+        if (!nodes[child].edges.isEmpty())
+            minimize(child);
+
+        QByteArray key = nodeKey(child);
+        auto it = registry.find(key);
+        if (it != registry.end()) {
+            nodes[node].edges.last().second = it.value();
+        }
+        else {
+            registry.insert(key, child);
+            nodes[child].registered = true;
+        }
+    }
+
+    QByteArray nodeKey(int node) const {
+        QByteArray key;
+        QDataStream out(&key, QIODevice::WriteOnly);
+        out << qint32(nodes[node].value);
+        for (const auto & e : nodes[node].edges)
+            out << e.first << qint32(e.second);
+        return key;
+    }
+
+private:
+    std::vector<BuildNode> nodes;
+    QHash<QByteArray, int> registry;
+    QString prevWord;
+};
+
+}
+
+QByteArray buildWordTrie( const QVector<QStringList> & dictionaries ) {
+    // QMap gives the sorted order
+    QMap<QString, int> words;
+    for (int d = 0; d < dictionaries.size(); d++) {
+        for (const QString & w : dictionaries[d]) {
+            if (!words.contains(w))
+                words.insert(w, d + 1);
+        }
+    }
+
+    TrieBuilder builder;
+    for (auto w = words.constBegin(); w != words.constEnd(); w++)
+        builder.addWord(w.key(), w.value());
+
+    return builder.build();
+}
+
+}
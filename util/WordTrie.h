@@ -0,0 +1,73 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_WORDTRIE_H
+#define MWC_QT_WALLET_WORDTRIE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+
+namespace dict {
+
+// Compiled dictionaries for the password analyser. All dictionaries are merged into a single DAWG
+// (trie with shared suffixes), every word knows its dictionary.
+// The trie is compiled offline (see misk::compileDictionaries) and stored in the resources uncompressed,
+// so it is used in place from the binary: no parsing or allocations at load.
+//
+// Format, all numbers are little endian quint32:
+//   magic, version, nodesNum, edgesNum
+//   nodes[nodesNum+1]: bits 0..23 - index of the first edge, bits 24..31 - dictionary of the word that ends here,
+//                      starting from 1. 0 - not a word. The last node marks the end of the edges.
+//   edges[edgesNum]:   bits 0..7 - symbol, bits 8..31 - target node. Edges of the node are sorted by symbol.
+// Root is the node 0.
+class WordTrie {
+public:
+    // Load compiled trie from the file or the resource.
+    WordTrie(const QString & fileName);
+
+    bool isEmpty() const {return nodesNum==0;}
+
+    // Longest word of the dictionary that the string starts with. Expected lo case inputs
+    QString findLongestWord(const QString & str, int dictionary) const;
+
+    // Scan the string for the words of all dictionaries in a single pass. For every position the longest word of
+    // every dictionary is taken, the weights of its symbols are adjusted.
+    // dictWeightSums - weight of the found word, per dictionary
+    QStringList detectDictionaryWords( const QString & str, QVector<double> & weights,
+                                       const QVector<double> & dictWeightSums ) const;
+
+private:
+    // return child node or -1
+    int findChild(int node, ushort symbol) const;
+    quint32 getNode(int idx) const;
+    quint32 getEdge(int idx) const;
+
+private:
+    QByteArray data; // Points to the resource if it is not compressed
+    const uchar * nodes = nullptr;
+    const uchar * edges = nullptr;
+    int nodesNum = 0;
+    int edgesNum = 0;
+};
+
+// Compile the trie from the dictionaries words. Index at dictionaries is a dictionary number.
+// Dictionaries are expected to have different words, the first dictionary win for duplicates.
+// This code is a utility that will never run in the production
+QByteArray buildWordTrie( const QVector<QStringList> & dictionaries );
+
+}
+
+#endif //MWC_QT_WALLET_WORDTRIE_H
@@ -20,11 +20,30 @@
 #include <QJsonObject>
 #include <QUrlQuery>
 #include <QDataStream>
+#include <QDateTime>
+#include <QTimer>
+#include <QCryptographicHash>
+#include <QSslConfiguration>
+#include <QSslSocket>
+#include <algorithm>
 #include "stringutils.h"
 #include "Log.h"
 
 namespace util {
 
+// Built once, defaultConfiguration() is expensive
+static const QSslConfiguration & getSslConfiguration() {
+    static const QSslConfiguration config = []() {
+        // sslLibraryVersionString neede as a workaroung for a deadlock at defaultConfiguration, qt v5.9
+        QSslSocket::sslLibraryVersionString();
+        QSslConfiguration cfg = QSslConfiguration::defaultConfiguration();
+        cfg.setProtocol(QSsl::TlsV1_2);
+        cfg.setPeerVerifyMode(QSslSocket::VerifyNone);
+        return cfg;
+    }();
+    return config;
+}
+
 HttpClient::HttpClient() {
     nwManager = new QNetworkAccessManager(this);
     connect(nwManager, &QNetworkAccessManager::finished, this, &HttpClient::replyFinished, Qt::QueuedConnection);
@@ -39,8 +58,6 @@ void HttpClient::sendRequest(HTTP_CALL call, const QString & url,
 
     qDebug() << "Sending request: " << url << ", params: " << params << "  tag:" << tag;
 
-    QUrl requestUrl(url);
-
     // enrich with params
     Q_ASSERT( params.size()%2==0 );
     QUrlQuery query;
@@ -49,19 +66,44 @@ void HttpClient::sendRequest(HTTP_CALL call, const QString & url,
     }
     // Note: QT encoding has issues, some symbols will be skipped.
     // No encoding needed because we encode params with out code.
-    requestUrl.setQuery(query.query(QUrl::PrettyDecoded), QUrl::StrictMode );
+    const QString queryStr = query.query(QUrl::PrettyDecoded);
+
+    const QString key = QString::number(int(call)) + " " + url + "?" + queryStr + " " +
+            QString::fromLatin1(QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex());
+    const RequestCallback callback{tag, param1, param2, param3, param4};
+    HttpEndpointStats & st = stats[url];
+    // POST might change the server state, every call must reach the server
+    const bool canReuse = call == GET;
+
+    auto cached = canReuse ? cache.find(key) : cache.end();
+    if (cached != cache.end()) {
+        if (cached->expirationTimeMs > QDateTime::currentMSecsSinceEpoch()) {
+            st.cacheHits++;
+            // Respond is expected to be async
+            const QJsonObject json = cached->json;
+            QTimer::singleShot(0, this, [this, callback, json]() {
+                deliverRespond({callback}, true, json);
+            });
+            return;
+        }
+        cache.erase(cached);
+    }
 
-    QNetworkRequest request;
+    QNetworkReply * sameRequest = canReuse ? inFlight.value(key, nullptr) : nullptr;
+    if (sameRequest != nullptr) {
+        st.coalesced++;
+        replies[sameRequest].callbacks.push_back(callback);
+        return;
+    }
+
+    QUrl requestUrl(url);
+    requestUrl.setQuery(queryStr, QUrl::StrictMode );
 
-    // sslLibraryVersionString neede as a workaroung for a deadlock at defaultConfiguration, qt v5.9
-    QSslSocket::sslLibraryVersionString();
-    QSslConfiguration config = QSslConfiguration::defaultConfiguration();
-    config.setProtocol(QSsl::TlsV1_2);
-    config.setPeerVerifyMode(QSslSocket::VerifyNone);
-    request.setSslConfiguration(config);
+    QNetworkRequest request;
+    request.setSslConfiguration(getSslConfiguration());
 
     qDebug() << "Processing: GET " << requestUrl.toString(QUrl::FullyEncoded);
-    logger::logInfo("Airdrop", "Requesting: " + url );
+    logger::logInfo("HttpClient", "Requesting: " + url );
     request.setUrl( requestUrl );
     request.setHeader(QNetworkRequest::ServerHeader, "application/json");
 
@@ -78,20 +120,57 @@ void HttpClient::sendRequest(HTTP_CALL call, const QString & url,
     }
     Q_ASSERT(reply);
 
-
     if (reply) {
-        reply->setProperty("tag", QVariant(tag));
-        reply->setProperty("param1", QVariant(param1));
-        reply->setProperty("param2", QVariant(param2));
-        reply->setProperty("param3", QVariant(param3));
-        reply->setProperty("param4", QVariant(param4));
+        st.requests++;
+        RequestInFlight & req = replies[reply];
+        req.key = key;
+        req.url = url;
+        req.startTimeMs = QDateTime::currentMSecsSinceEpoch();
+        req.callbacks.push_back(callback);
+        if (canReuse)
+            inFlight.insert(key, reply);
         // Respond will be send back async
     }
 }
 
+void HttpClient::setResponseTtl(const QString & url, int ttlMs) {
+    if (ttlMs > 0)
+        responseTtl.insert(url, ttlMs);
+    else
+        responseTtl.remove(url);
+    invalidateResponseCache(url);
+}
+
+void HttpClient::invalidateResponseCache(const QString & url) {
+    if (url.isEmpty()) {
+        cache.clear();
+        inFlight.clear();
+        return;
+    }
+
+    for (auto c = cache.begin(); c != cache.end(); ) {
+        if (c->url == url)
+            c = cache.erase(c);
+        else
+            c++;
+    }
+    for (auto r = inFlight.begin(); r != inFlight.end(); ) {
+        if (replies.value(r.value()).url == url)
+            r = inFlight.erase(r);
+        else
+            r++;
+    }
+}
+
 void HttpClient::replyFinished(QNetworkReply* reply) {
+    const RequestInFlight req = replies.take(reply);
+    // Invalidated request still delivers the respond, but it is not cached. POST is never in inFlight.
+    const bool canCache = inFlight.value(req.key, nullptr) == reply;
+    if (canCache)
+        inFlight.remove(req.key);
+
     QNetworkReply::NetworkError errCode = reply->error();
-    QString tag = reply->property("tag").toString();
+    const QString tag = req.callbacks.isEmpty() ? QString() : req.callbacks.first().tag;
 
     qDebug() << "Get back respond with tag: " << tag << "  Error code: " << errCode;
 
@@ -123,14 +202,33 @@ void HttpClient::replyFinished(QNetworkReply* reply) {
     }
     reply->deleteLater();
 
+    if (!req.url.isEmpty()) {
+        HttpEndpointStats & st = stats[req.url];
+        const int64_t latencyMs = QDateTime::currentMSecsSinceEpoch() - req.startTimeMs;
+        st.totalMs += latencyMs;
+        st.maxMs = std::max(st.maxMs, latencyMs);
+        if (!requestOk)
+            st.failures++;
+
+        const int ttlMs = responseTtl.value(req.url, 0);
+        if (requestOk && canCache && ttlMs > 0) {
+            CachedRespond & c = cache[req.key];
+            c.url = req.url;
+            c.expirationTimeMs = QDateTime::currentMSecsSinceEpoch() + ttlMs;
+            c.json = jsonRespond;
+        }
+    }
+
     // Done with reply. Now processing the results by tags
+    deliverRespond(req.callbacks, requestOk, jsonRespond);
+}
 
-    onProcessHttpResponse(requestOk, tag, jsonRespond,
-                reply->property("param1").toString(),
-                reply->property("param2").toString(),
-                reply->property("param3").toString(),
-                reply->property("param4").toString()
-            );
+void HttpClient::deliverRespond(const QVector<RequestCallback> & callbacks, bool requestOk, const QJsonObject & jsonRespond) {
+    for (const auto & cb : callbacks) {
+        // Every caller get its own copy, handler is allowed to modify it
+        QJsonObject json = jsonRespond;
+        onProcessHttpResponse(requestOk, cb.tag, json, cb.param1, cb.param2, cb.param3, cb.param4);
+    }
 }
 
 
@@ -18,15 +18,35 @@
 #include <QString>
 #include <QByteArray>
 #include <QObject>
+#include <QVector>
+#include <QMap>
+#include <QHash>
+#include <QJsonObject>
 
 class QNetworkAccessManager;
 class QNetworkReply;
 
 namespace util {
 
+struct HttpEndpointStats {
+    int64_t requests = 0;  // sent to the network
+    int64_t failures = 0;
+    int64_t coalesced = 0; // joined the identical request in flight
+    int64_t cacheHits = 0;
+    int64_t totalMs = 0;   // network latency
+    int64_t maxMs = 0;
+};
+
 // Http calls funtionality for the any class
+// Identical GET requests (url, params) that are in flight are sent once, every caller gets
+// the respond with its own tag and params. Successful GET responds can be cached per url for some time.
+// POST requests are always sent.
 class HttpClient : public QObject {
 Q_OBJECT
+public:
+    // Key: url without params
+    const QMap<QString, HttpEndpointStats> & getEndpointStats() const {return stats;}
+
 protected:
     enum HTTP_CALL {
         GET, POST
@@ -41,6 +61,11 @@ protected:
                      const QString &param1="", const QString &param2="",
                      const QString &param3="", const QString &param4="");
 
+    // Successful GET responds from the url are reused for ttlMs. 0 - no caching (default)
+    void setResponseTtl(const QString & url, int ttlMs);
+    // Drop cached responds for the url, empty url - for all. Requests in flight are not joined any more.
+    void invalidateResponseCache(const QString & url = "");
+
     virtual void onProcessHttpResponse(bool requestOk, const QString & tag, QJsonObject & jsonRespond,
                                        const QString & param1,
                                        const QString & param2,
@@ -50,8 +75,39 @@ protected:
 private slots:
     void replyFinished(QNetworkReply* reply);
 
+private:
+    struct RequestCallback {
+        QString tag;
+        QString param1;
+        QString param2;
+        QString param3;
+        QString param4;
+    };
+
+    struct RequestInFlight {
+        QString key;
+        QString url;
+        int64_t startTimeMs = 0;
+        QVector<RequestCallback> callbacks;
+    };
+
+    struct CachedRespond {
+        QString url;
+        int64_t expirationTimeMs = 0;
+        QJsonObject json;
+    };
+
+    void deliverRespond(const QVector<RequestCallback> & callbacks, bool requestOk, const QJsonObject & jsonRespond);
+
 protected:
     QNetworkAccessManager * nwManager = nullptr;
+
+private:
+    QHash<QNetworkReply*, RequestInFlight> replies;
+    QHash<QString, QNetworkReply*> inFlight; // Key: request key. Requests that new callers can join
+    QHash<QString, CachedRespond> cache; // Key: request key
+    QHash<QString, int> responseTtl; // Key: url
+    QMap<QString, HttpEndpointStats> stats;
 };
 
 }
@@ -0,0 +1,343 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "journalstore.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QtEndian>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace util {
+
+const static int SNAPSHOT_ID = 0x5901;
+const static int JOURNAL_ID = 0x5902;
+
+const static qint8 OP_PUT = 1;
+const static qint8 OP_REMOVE = 2;
+
+// Record header: payload size and checksum
+const static int RECORD_HEADER_SIZE = 4 + 2;
+// Journal header: id and generation
+const static int JOURNAL_HEADER_SIZE = 4 + 4;
+// Compaction is never triggered for the small stores
+const static int JOURNAL_COMPACT_MIN_RECORDS = 1000;
+
+// Flush Qt and OS buffers, so the data is really on the disk
+static bool syncFile(QFile & file) {
+    if (!file.flush())
+        return false;
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+JournalStore::~JournalStore() {
+    delete journal;
+}
+
+bool JournalStore::open(const QString & _filePath, QString & errorMessage) {
+    Q_ASSERT(!isOpen());
+    filePath = _filePath;
+    data.clear();
+
+    if (loadSnapshot(errorMessage) && replayJournal(errorMessage))
+        return true;
+
+    // Files are left as they are, so the partial data is never committed over them
+    close();
+    return false;
+}
+
+bool JournalStore::create(const QString & _filePath, QString & errorMessage) {
+    Q_ASSERT(!isOpen());
+    filePath = _filePath;
+    data.clear();
+    generation = 0;
+
+    // Journal from the previous store must never be replayed over the new snapshot
+    QFile::remove(getJournalPath());
+    if (compact(errorMessage))
+        return true;
+
+    close();
+    return false;
+}
+
+void JournalStore::close() {
+    delete journal;
+    journal = nullptr;
+    journalRecords = 0;
+    pending.clear();
+    pendingRecords = 0;
+    data.clear();
+    filePath.clear();
+}
+
+QStringList JournalStore::keys(const QString & prefix) const {
+    QStringList res;
+    for (auto i = data.constBegin(); i != data.constEnd(); i++) {
+        if (i.key().startsWith(prefix))
+            res.push_back(i.key());
+    }
+    return res;
+}
+
+void JournalStore::put(const QString & key, const QByteArray & value) {
+    auto i = data.find(key);
+    if (i != data.end() && i.value() == value)
+        return;
+
+    data.insert(key, value);
+    addPendingRecord(OP_PUT, key, value);
+}
+
+void JournalStore::remove(const QString & key) {
+    if (data.remove(key) > 0)
+        addPendingRecord(OP_REMOVE, key, QByteArray());
+}
+
+void JournalStore::addPendingRecord(qint8 op, const QString & key, const QByteArray & value) {
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_7);
+        out << op << key;
+        if (op == OP_PUT)
+            out << value;
+    }
+
+    QDataStream out(&pending, QIODevice::WriteOnly | QIODevice::Append);
+    out.setVersion(QDataStream::Qt_5_7);
+    out << quint32(payload.size()) << qChecksum(payload.constData(), uint(payload.size()));
+    out.writeRawData(payload.constData(), payload.size());
+    pendingRecords++;
+}
+
+bool JournalStore::commit(QString & errorMessage) {
+    if (!isOpen()) {
+        errorMessage = "Storage is not open";
+        return false;
+    }
+    if (pendingRecords == 0)
+        return true;
+
+    if (journal == nullptr && !openJournal(false, errorMessage))
+        return false;
+
+    if (journal->write(pending) != pending.size() || !syncFile(*journal)) {
+        // The journal tail might be torn now, records after it will be lost at replay.
+        // Snapshot has everything from the memory, including pending changes.
+        qDebug() << "JournalStore: unable to append to " << getJournalPath() << ", " << journal->errorString();
+        return compact(errorMessage);
+    }
+
+    journalRecords += pendingRecords;
+    pending.clear();
+    pendingRecords = 0;
+
+    if (journalRecords > std::max(JOURNAL_COMPACT_MIN_RECORDS, data.size()))
+        return compact(errorMessage);
+
+    return true;
+}
+
+bool JournalStore::compact(QString & errorMessage) {
+    if (!isOpen()) {
+        errorMessage = "Storage is not open";
+        return false;
+    }
+
+    // The new snapshot get next generation, so the previous journal is ignored if we crash
+    // before it is truncated.
+    generation++;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = "Unable to write " + filePath + "\nError: " + file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_7);
+    out << SNAPSHOT_ID;
+    out << generation;
+    out << qint32(data.size());
+    for (auto i = data.constBegin(); i != data.constEnd(); i++)
+        out << i.key() << i.value();
+
+    // QSaveFile::commit syncs the temp file and renames it over the previous snapshot
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        errorMessage = "Unable to write " + filePath + "\nError: " + file.errorString();
+        return false;
+    }
+
+    pending.clear();
+    pendingRecords = 0;
+
+    delete journal;
+    journal = nullptr;
+    return openJournal(true, errorMessage);
+}
+
+bool JournalStore::loadSnapshot(QString & errorMessage) {
+    generation = 0;
+
+    QFile file(filePath);
+    if (!file.exists())
+        return true;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Unable to read " + filePath + "\nError: " + file.errorString();
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_7);
+
+    int id = 0;
+    in >> id;
+    if (id != SNAPSHOT_ID) {
+        errorMessage = "Unknown format of " + filePath;
+        return false;
+    }
+
+    qint32 sz = 0;
+    in >> generation;
+    in >> sz;
+    data.reserve(sz);
+    for (qint32 r = 0; r < sz && in.status() == QDataStream::Ok; r++) {
+        QString key;
+        QByteArray value;
+        in >> key >> value;
+        data.insert(key, value);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        // Snapshot is replaced atomically, we can't get here because of the crash
+        errorMessage = "Data at " + filePath + " is corrupted";
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool JournalStore::replayJournal(QString & errorMessage) {
+    journalRecords = 0;
+
+    const QString journalPath = getJournalPath();
+    QFile file(journalPath);
+    if (!file.exists())
+        return true;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Unable to read " + journalPath + "\nError: " + file.errorString();
+        return false;
+    }
+    const QByteArray bytes = file.readAll();
+    file.close();
+
+    const uchar * buf = reinterpret_cast<const uchar *>(bytes.constData());
+    int pos = 0;
+    if (bytes.size() >= JOURNAL_HEADER_SIZE &&
+            qFromBigEndian<qint32>(buf) == JOURNAL_ID &&
+            qFromBigEndian<quint32>(buf + 4) == generation) {
+        pos = JOURNAL_HEADER_SIZE;
+
+        while (pos + RECORD_HEADER_SIZE <= bytes.size()) {
+            const int sz = int(qFromBigEndian<quint32>(buf + pos));
+            const quint16 crc = qFromBigEndian<quint16>(buf + pos + 4);
+            if (sz < 0 || sz > bytes.size() - pos - RECORD_HEADER_SIZE)
+                break;
+
+            const char * payload = bytes.constData() + pos + RECORD_HEADER_SIZE;
+            if (qChecksum(payload, uint(sz)) != crc)
+                break;
+
+            QDataStream in(QByteArray::fromRawData(payload, sz));
+            in.setVersion(QDataStream::Qt_5_7);
+            qint8 op = 0;
+            QString key;
+            in >> op >> key;
+            if (op == OP_PUT) {
+                QByteArray value;
+                in >> value;
+                if (in.status() != QDataStream::Ok)
+                    break;
+                data.insert(key, value);
+            }
+            else if (op == OP_REMOVE && in.status() == QDataStream::Ok) {
+                data.remove(key);
+            }
+            else {
+                break;
+            }
+
+            pos += RECORD_HEADER_SIZE + sz;
+            journalRecords++;
+        }
+    }
+
+    if (pos == 0) {
+        // Journal from another generation (crash during compaction) or broken header. Start the new one.
+        return openJournal(true, errorMessage);
+    }
+
+    if (pos < bytes.size()) {
+        qDebug() << "JournalStore: dropping " << (bytes.size() - pos) << " bytes of the torn journal tail at " << journalPath;
+        if (!QFile::resize(journalPath, pos)) {
+            errorMessage = "Unable to repair " + journalPath;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JournalStore::openJournal(bool truncate, QString & errorMessage) {
+    Q_ASSERT(journal == nullptr);
+
+    const QString journalPath = getJournalPath();
+    journal = new QFile(journalPath);
+    if (!journal->open(truncate ? (QIODevice::WriteOnly | QIODevice::Truncate) : (QIODevice::WriteOnly | QIODevice::Append))) {
+        errorMessage = "Unable to open " + journalPath + "\nError: " + journal->errorString();
+        delete journal;
+        journal = nullptr;
+        return false;
+    }
+
+    if (journal->size() == 0) {
+        journalRecords = 0;
+        QDataStream out(journal);
+        out.setVersion(QDataStream::Qt_5_7);
+        out << JOURNAL_ID << generation;
+        if (out.status() != QDataStream::Ok || !syncFile(*journal)) {
+            errorMessage = "Unable to write " + journalPath + "\nError: " + journal->errorString();
+            delete journal;
+            journal = nullptr;
+            return false;
+        }
+    }
+    return true;
+}
+
+}
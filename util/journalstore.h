@@ -0,0 +1,90 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_JOURNALSTORE_H
+#define MWC_QT_WALLET_JOURNALSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+
+class QFile;
+
+namespace util {
+
+// Persistent key/value storage that survives the crash in the middle of the write.
+// Data lives in two files: the snapshot and the journal. Every change is appended to the journal
+// as a single record with a checksum, then the journal is synced to the disk. A torn record at the
+// journal tail (crash during the append) is dropped at load.
+// The snapshot is written into the temp file, synced and renamed over the previous one. It is rewritten
+// only when the journal becomes longer than the data itself, so writing one key costs O(1) in average.
+class JournalStore {
+public:
+    JournalStore() {}
+    ~JournalStore();
+
+    JournalStore(const JournalStore &) = delete;
+    JournalStore & operator = (const JournalStore &) = delete;
+
+    // Load the snapshot and replay the journal. Missing files mean the empty store.
+    // Return false if the files exist but can't be read. In this case the store stays closed and
+    // the files are not touched.
+    bool open(const QString & filePath, QString & errorMessage);
+    // Start the empty store. Existing files are overwritten.
+    bool create(const QString & filePath, QString & errorMessage);
+    void close();
+    bool isOpen() const {return !filePath.isEmpty();}
+
+    bool isEmpty() const {return data.isEmpty();}
+    int size() const {return data.size();}
+    bool contains(const QString & key) const {return data.contains(key);}
+    QByteArray value(const QString & key) const {return data.value(key);}
+    // All keys that start from the prefix
+    QStringList keys(const QString & prefix) const;
+
+    // Changes are applied in memory and wait for the commit. Putting the same value is a no-op.
+    void put(const QString & key, const QByteArray & value);
+    void remove(const QString & key);
+    bool hasPendingChanges() const {return pendingRecords>0;}
+
+    // Append pending changes to the journal and sync it. Compact the store if the journal is too long.
+    // Return false if the store is not open.
+    bool commit(QString & errorMessage);
+
+    // Rewrite the snapshot with the current data and start the new journal.
+    bool compact(QString & errorMessage);
+
+private:
+    QString getJournalPath() const {return filePath + ".journal";}
+    bool loadSnapshot(QString & errorMessage);
+    bool replayJournal(QString & errorMessage);
+    bool openJournal(bool truncate, QString & errorMessage);
+    void addPendingRecord(qint8 op, const QString & key, const QByteArray & value);
+
+private:
+    QString filePath;
+    QHash<QString, QByteArray> data;
+    quint32 generation = 0; // Journal is valid only for the snapshot of the same generation
+
+    QByteArray pending; // Encoded journal records that are not written yet
+    int pendingRecords = 0;
+
+    QFile * journal = nullptr;
+    int journalRecords = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_JOURNALSTORE_H
@@ -0,0 +1,154 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "linesringbuffer.h"
+#include <algorithm>
+
+namespace util {
+
+static inline quint64 trigramKey(const QChar * s) {
+    return (quint64(s[0].unicode()) << 32) | (quint64(s[1].unicode()) << 16) | quint64(s[2].unicode());
+}
+
+// Unique trigrams of the lower case string
+static QVector<quint64> getTrigrams(const QString & lowerStr) {
+    QVector<quint64> res;
+    if (lowerStr.length() < 3)
+        return res;
+
+    res.reserve(lowerStr.length() - 2);
+    const QChar * s = lowerStr.constData();
+    for (int i = 0; i + 3 <= lowerStr.length(); i++)
+        res.push_back(trigramKey(s + i));
+
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+LinesRingBuffer::LinesRingBuffer(int capacity, bool withSearchIndex) :
+    lines(std::max(1, capacity)),
+    searchIndex(withSearchIndex)
+{
+    nextPurgeSeq = quint64(lines.size());
+}
+
+void LinesRingBuffer::append(const QString & line) {
+    const quint64 seq = seqNext++;
+    lines[int(seq % quint64(lines.size()))] = line;
+    if (count < lines.size())
+        count++;
+
+    if (searchIndex) {
+        indexLine(line, seq);
+        if (seqNext >= nextPurgeSeq)
+            purgeIndex();
+    }
+}
+
+void LinesRingBuffer::clear() {
+    for (auto & ln : lines)
+        ln.clear();
+    count = 0;
+    trigrams.clear();
+    // Sequence numbers are not reset, readers with linesSince() will not get confused
+    nextPurgeSeq = seqNext + quint64(lines.size());
+}
+
+const QString & LinesRingBuffer::line(quint64 seq) const {
+    Q_ASSERT(seq >= firstSeq() && seq < seqNext);
+    return lines[int(seq % quint64(lines.size()))];
+}
+
+QStringList LinesRingBuffer::snapshot(int maxLines) const {
+    QStringList res;
+    res.reserve(maxLines < 0 ? count : std::min(maxLines, count));
+    forEachNewestFirst([&res, maxLines](quint64, const QString & ln) {
+        if (maxLines >= 0 && res.size() >= maxLines)
+            return false;
+        res.push_back(ln);
+        return true;
+    });
+    return res;
+}
+
+QStringList LinesRingBuffer::linesSince(quint64 fromSeq) const {
+    QStringList res;
+    for (quint64 seq = std::max(fromSeq, firstSeq()); seq < seqNext; seq++)
+        res.push_back(line(seq));
+    return res;
+}
+
+QVector<quint64> LinesRingBuffer::search(const QString & text, int maxResults) const {
+    QVector<quint64> res;
+    if (text.isEmpty() || maxResults <= 0)
+        return res;
+
+    const QString lowerText = text.toLower();
+
+    if (!searchIndex || lowerText.length() < 3) {
+        // Nothing to use from the index, scanning
+        forEachNewestFirst([&](quint64 seq, const QString & ln) {
+            if (ln.contains(text, Qt::CaseInsensitive))
+                res.push_back(seq);
+            return res.size() < maxResults;
+        });
+        return res;
+    }
+
+    // Every matching line has all trigrams of the text, the shortest list is the best candidates set
+    const QVector<quint64> * candidates = nullptr;
+    for (quint64 tg : getTrigrams(lowerText)) {
+        auto it = trigrams.constFind(tg);
+        if (it == trigrams.constEnd())
+            return res;
+        if (candidates == nullptr || it.value().size() < candidates->size())
+            candidates = &it.value();
+    }
+    Q_ASSERT(candidates);
+
+    const quint64 first = firstSeq();
+    for (int i = candidates->size() - 1; i >= 0 && res.size() < maxResults; i--) {
+        const quint64 seq = candidates->at(i);
+        if (seq < first)
+            break; // the rest are evicted
+        if (line(seq).contains(text, Qt::CaseInsensitive))
+            res.push_back(seq);
+    }
+    return res;
+}
+
+void LinesRingBuffer::indexLine(const QString & line, quint64 seq) {
+    for (quint64 tg : getTrigrams(line.toLower()))
+        trigrams[tg].push_back(seq);
+}
+
+// Drop the evicted lines from the index. Called once per capacity appends, so the cost per append
+// is about the number of trigrams in a line.
+void LinesRingBuffer::purgeIndex() {
+    const quint64 first = firstSeq();
+    for (auto it = trigrams.begin(); it != trigrams.end(); ) {
+        QVector<quint64> & seqs = it.value();
+        auto alive = std::lower_bound(seqs.begin(), seqs.end(), first);
+        if (alive == seqs.end()) {
+            it = trigrams.erase(it);
+            continue;
+        }
+        seqs.erase(seqs.begin(), alive);
+        ++it;
+    }
+    nextPurgeSeq = seqNext + quint64(lines.size());
+}
+
+}
@@ -0,0 +1,79 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_LINESRINGBUFFER_H
+#define MWC_QT_WALLET_LINESRINGBUFFER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+namespace util {
+
+// Fixed capacity ring of text lines (process console output). Append is O(1), the oldest line is overwritten.
+// Every line gets a sequence number, line 'seq' is available while firstSeq() <= seq < nextSeq().
+// Optional substring index: trigrams (3 chars, case insensitive) of every line are indexed, so search
+// is checking only the lines that have the rarest trigram of the pattern.
+// Not thread safe, expected to be used from a single thread.
+class LinesRingBuffer {
+public:
+    explicit LinesRingBuffer(int capacity, bool withSearchIndex = false);
+
+    void append(const QString & line);
+    void clear();
+
+    int size() const {return count;}
+    int capacity() const {return lines.size();}
+    quint64 firstSeq() const {return seqNext - quint64(count);}
+    quint64 nextSeq() const {return seqNext;}
+
+    // Line by sequence number, must be available
+    const QString & line(quint64 seq) const;
+
+    // Call f(seq, line) from the newest to the oldest line. Stop when f returns false.
+    template <class F>
+    void forEachNewestFirst(F f) const {
+        for (quint64 seq = seqNext; seq > firstSeq(); seq--) {
+            if (!f(seq-1, line(seq-1)))
+                return;
+        }
+    }
+
+    // Copy of the last lines, the newest first. maxLines<0 - all lines
+    QStringList snapshot(int maxLines = -1) const;
+    // Lines from fromSeq, the oldest first. Use nextSeq() to continue from the last call.
+    QStringList linesSince(quint64 fromSeq) const;
+
+    // Sequence numbers of the lines that contain text (case insensitive), the newest first.
+    QVector<quint64> search(const QString & text, int maxResults) const;
+
+private:
+    void indexLine(const QString & line, quint64 seq);
+    void purgeIndex();
+
+private:
+    QVector<QString> lines;
+    int count = 0;
+    quint64 seqNext = 0;
+
+    bool searchIndex;
+    // Key: trigram. Value: sequence numbers of the lines, ascending. Evicted lines are purged once per capacity appends.
+    QHash<quint64, QVector<quint64>> trigrams;
+    quint64 nextPurgeSeq = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_LINESRINGBUFFER_H
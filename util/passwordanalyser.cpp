@@ -22,27 +22,23 @@ namespace util {
 PasswordAnalyser::PasswordAnalyser(QString _attentinColor, QString _happyColor ) :
         attentinColor(_attentinColor),
         happyColor(_happyColor),
+        dictionaries(":/resource/passwords.trie"),
         sequenceAnalyzer( dict::buldPasswordChackWordSequences() ) {
 
     Q_ASSERT(DICTS_NUM==4);
 
-    dictionaries[0] = new dict::WordDictionary(":/resource/passwords-1k.dat");
+    // Dictionaries order is defined by misk::compileDictionaries
+    double dictionaryWeight[DICTS_NUM];
     dictionaryWeight[0] = 1.0; // 1 k include 10 & 100.  Let's ban it to one symbol. In any case it is lett than 2 symbols
-
-    dictionaries[1] = new dict::WordDictionary(":/resource/passwords-10k.dat");
     dictionaryWeight[1] = 2.0; // 13.2 bits
-
-    dictionaries[2] = new dict::WordDictionary(":/resource/passwords-100k.dat");
     dictionaryWeight[2] = 2.5; // 16.6 bits  (7 per char is ok)
-
-    dictionaries[3] = new dict::WordDictionary(":/resource/passwords-1M.dat");
     dictionaryWeight[3] = 3.0; // 20 bits
+
+    for (double w : dictionaryWeight)
+        dictionaryWeightSums.push_back( w * 7.0 ); // dictionary has the full alphabet - 7 bits
 }
 
 PasswordAnalyser::~PasswordAnalyser() {
-    for ( auto d : dictionaries ) {
-        delete d;
-    }
 }
 
 // return String to print
@@ -110,10 +106,8 @@ QPair<QString, bool> PasswordAnalyser::getPasswordQualityReport(const QString &
         if (s.length()>2)
             seqWords << s;
 
-    // Let's check dictionary words
-    for ( int t=0; t<DICTS_NUM; t++ ) {
-        dictWords += dictionaries[t]->detectDictionaryWords(pass, weight, dictionaryWeight[t] * 7.0 ); // dictionary has the full alphabet - 7 bits
-    }
+    // Let's check dictionary words, all dictionaries at once
+    dictWords += dictionaries.detectDictionaryWords(pass, weight, dictionaryWeightSums);
 
     // Let's pack the dictionary words...
     for (int i=dictWords.size()-1; i>=0; i--) {
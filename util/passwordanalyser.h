@@ -17,7 +17,7 @@
 
 #include <QString>
 #include "../util/WordSequences.h"
-#include "../util/WordDictionary.h"
+#include "../util/WordTrie.h"
 
 namespace util {
 
@@ -42,8 +42,9 @@ private:
     QString attentinColor;
     QString happyColor;
 
-    dict::WordDictionary * dictionaries[DICTS_NUM];
-    double dictionaryWeight[DICTS_NUM];
+    // All dictionaries are in a single trie, it is used in place from the resources
+    dict::WordTrie dictionaries;
+    QVector<double> dictionaryWeightSums; // index: dictionary number
 
     dict::WordSequences sequenceAnalyzer;
 };
@@ -0,0 +1,137 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "qrimage.h"
+#include "QrCode.h"
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
+#include <QDebug>
+#include <cstring>
+
+namespace util {
+
+using qrcodegen::QrCode;
+
+// Encoding is the expensive part, but usually there is one code on the screen
+const int QR_CODE_CACHE_SIZE = 4;
+// Every code can be shown at few sizes while window is resized
+const int QR_IMAGE_CACHE_SIZE = 16;
+
+struct CachedQrCode {
+    QString content;
+    QSharedPointer<QrCode> code; // null if content is too long
+};
+
+struct CachedQrImage {
+    QString content;
+    QSize   size;
+    int     border = 0;
+    QImage  image;
+};
+
+// Most recent first
+static QList<CachedQrCode> qrCodeCache;
+static QList<CachedQrImage> qrImageCache;
+
+// Return null if content is too long
+static const QrCode * getQrCode(const QString & content) {
+    for (int i = 0; i < qrCodeCache.size(); i++) {
+        if (qrCodeCache[i].content == content) {
+            qrCodeCache.move(i, 0);
+            return qrCodeCache[0].code.data();
+        }
+    }
+
+    CachedQrCode cached;
+    cached.content = content;
+    try {
+        cached.code.reset( new QrCode(QrCode::encodeText(content.toStdString().c_str(), QrCode::Ecc::MEDIUM)) );
+    }
+    catch (const qrcodegen::data_too_long & ex) {
+        qDebug() << "Unable to generate QR code, " << ex.what();
+    }
+
+    qrCodeCache.push_front(cached);
+    while (qrCodeCache.size() > QR_CODE_CACHE_SIZE)
+        qrCodeCache.pop_back();
+
+    return cached.code.data();
+}
+
+// Number of modules per side without the border. 0 if content is too long for QR code.
+int getQrCodeSize(const QString & content) {
+    const QrCode * code = getQrCode(content);
+    return code == nullptr ? 0 : code->getSize();
+}
+
+static QImage renderQrCode(const QrCode & code, const QSize & imageSize, int border) {
+    const int w = imageSize.width();
+    const int h = imageSize.height();
+    const int n = code.getSize() + border * 2;
+
+    QImage image(w, h, QImage::Format_RGB32);
+
+    // Pixel column to module column
+    QVector<int> moduleX(w);
+    for (int px = 0; px < w; px++)
+        moduleX[px] = px * n / w - border;
+
+    int prevModuleY = -1;
+    for (int py = 0; py < h; py++) {
+        QRgb * line = reinterpret_cast<QRgb *>(image.scanLine(py));
+        const int my = py * n / h - border;
+        if (py > 0 && my == prevModuleY) {
+            // Same row of modules, copy the pixels
+            std::memcpy(line, image.constScanLine(py - 1), size_t(w) * sizeof(QRgb));
+            continue;
+        }
+        prevModuleY = my;
+
+        for (int px = 0; px < w; px++)
+            line[px] = code.getModule(moduleX[px], my) ? 0xFF000000 : 0xFFFFFFFF;
+    }
+    return image;
+}
+
+// QR code image, black modules on white. Code with the border is stretched to the image size.
+QImage getQrCodeImage(const QString & content, const QSize & imageSize, int border) {
+    if (imageSize.isEmpty())
+        return QImage();
+
+    for (int i = 0; i < qrImageCache.size(); i++) {
+        const CachedQrImage & img = qrImageCache[i];
+        if (img.size == imageSize && img.border == border && img.content == content) {
+            qrImageCache.move(i, 0);
+            return qrImageCache[0].image;
+        }
+    }
+
+    const QrCode * code = getQrCode(content);
+    if (code == nullptr)
+        return QImage();
+
+    CachedQrImage img;
+    img.content = content;
+    img.size = imageSize;
+    img.border = border;
+    img.image = renderQrCode(*code, imageSize, border);
+
+    qrImageCache.push_front(img);
+    while (qrImageCache.size() > QR_IMAGE_CACHE_SIZE)
+        qrImageCache.pop_back();
+
+    return img.image;
+}
+
+}
@@ -0,0 +1,36 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_QRIMAGE_H
+#define MWC_QT_WALLET_QRIMAGE_H
+
+#include <QString>
+#include <QImage>
+#include <QSize>
+
+namespace util {
+
+// QR code images for the text content (slatepacks, addresses). Modules are drawn directly into the image.
+// Encoded codes and rendered images are kept at the LRU caches, so showing, resizing or reopening
+// the same content doesn't encode it again. Must be called from the GUI thread.
+
+// Number of modules per side without the border. 0 if content is too long for QR code.
+int getQrCodeSize(const QString & content);
+
+// QR code image, black modules on white. Code with the border is stretched to the image size.
+// Return null image if content is too long for QR code.
+QImage getQrCodeImage(const QString & content, const QSize & imageSize, int border = 1);
+
+}
+
+#endif //MWC_QT_WALLET_QRIMAGE_H
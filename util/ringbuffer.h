@@ -0,0 +1,102 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_RINGBUFFER_H
+#define MWC_QT_WALLET_RINGBUFFER_H
+
+#include <QAtomicInteger>
+#include <QtGlobal>
+#include <utility>
+
+namespace util {
+
+// Bounded lock-free queue, many producers and a single consumer.
+// Every cell has a sequence number, producers reserve the cell by moving the write position
+// and publish the data by updating the cell sequence. Nobody waits for the lock, a producer
+// only retries if another producer took the same cell.
+// T expected to be cheap to move (QByteArray, QString).
+template <class T>
+class MpscRingBuffer {
+public:
+    // capacity will be rounded up to the power of 2
+    explicit MpscRingBuffer(int capacity) {
+        quint32 sz = 2;
+        while (sz < quint32(capacity))
+            sz <<= 1;
+        mask = sz - 1;
+        cells = new Cell[sz];
+        for (quint32 i = 0; i < sz; i++)
+            cells[i].seq.storeRelease(i);
+    }
+    ~MpscRingBuffer() { delete [] cells; }
+
+    MpscRingBuffer(const MpscRingBuffer &) = delete;
+    MpscRingBuffer & operator = (const MpscRingBuffer &) = delete;
+
+    // Any thread. Return false if the buffer is full, the item is not added.
+    bool push(T && item) {
+        quint32 pos = writePos.loadAcquire();
+        while (true) {
+            Cell & cell = cells[pos & mask];
+            const qint32 diff = qint32(cell.seq.loadAcquire() - pos);
+            if (diff == 0) {
+                if (writePos.testAndSetOrdered(pos, pos + 1)) {
+                    cell.data = std::move(item);
+                    cell.seq.storeRelease(pos + 1);
+                    return true;
+                }
+                pos = writePos.loadAcquire();
+            }
+            else if (diff < 0) {
+                return false; // Consumer didn't read this cell yet
+            }
+            else {
+                pos = writePos.loadAcquire(); // Somebody else got it
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool isEmpty() const {
+        return qint32(cells[readPos & mask].seq.loadAcquire() - (readPos + 1)) < 0;
+    }
+
+    // Consumer thread only. Return false if there is no data.
+    bool pop(T & item) {
+        Cell & cell = cells[readPos & mask];
+        if (qint32(cell.seq.loadAcquire() - (readPos + 1)) < 0)
+            return false;
+
+        item = std::move(cell.data);
+        cell.data = T();
+        cell.seq.storeRelease(readPos + mask + 1);
+        readPos++;
+        return true;
+    }
+
+private:
+    struct Cell {
+        QAtomicInteger<quint32> seq;
+        T data;
+    };
+
+    Cell * cells = nullptr;
+    quint32 mask = 0;
+    QAtomicInteger<quint32> writePos;
+    quint32 readPos = 0; // Consumer only
+};
+
+}
+
+#endif //MWC_QT_WALLET_RINGBUFFER_H
@@ -214,6 +214,15 @@ QString getSubString(const QString & str, int idx1, int idx2) {
     return str.mid(idx1, idx2-idx1).trimmed();
 }
 
+QString getSubString(const QStringRef & str, int idx1, int idx2) {
+    idx2 = std::min(idx2, str.length());
+
+    if (idx2<=idx1 || idx1>=str.length())
+        return "";
+
+    return str.mid(idx1, idx2-idx1).trimmed().toString();
+}
+
 static int calcOffsetFromUTC() {
      return QDateTime::currentDateTime().offsetFromUtc();
 }
@@ -246,6 +255,25 @@ QString timestamp2ThisTime(int64_t timestamp) {
     return res;
 }
 
+int64_t walletTime2Timestamp(const QString & timeStr) {
+    if (timeStr.isEmpty())
+        return 0;
+
+    // mwc713 prints UTC time
+    QDateTime time = QDateTime::fromString(timeStr, mwc::DATETIME_TEMPLATE_MWC713);
+    if (time.isValid()) {
+        time.setTimeSpec(Qt::UTC);
+        return time.toSecsSinceEpoch();
+    }
+
+    // This wallet time is local
+    time = QDateTime::fromString(timeStr, mwc::DATETIME_TEMPLATE_THIS);
+    if (time.isValid())
+        return time.toSecsSinceEpoch();
+
+    return 0;
+}
+
 // Convert time interval in seconds into 2 sevel word description.
 QString interval2String(int64_t intervalSec, bool shortUnits, int tiers) {
     if (tiers<=0 || intervalSec<=0)
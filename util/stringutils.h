@@ -54,6 +54,7 @@ QString formatErrorMessages(QStringList messages);
 
 // Get safely substring from the string. If indexes out of range, return emoty string
 QString getSubString(const QString & str, int idx1, int idx2);
+QString getSubString(const QStringRef & str, int idx1, int idx2);
 
 // Convert mwc713 UTC time to this wallet time. Time template is different.
 QString mwc713time2ThisTime(QString mwc713TimeStr);
@@ -61,6 +62,9 @@ QString mwc713time2ThisTime(QString mwc713TimeStr);
 // Convert timestamp to this wallet time.
 QString timestamp2ThisTime(int64_t timestamp);
 
+// Parse mwc713 UTC time or this wallet time (Json data) into the timestamp. Return 0 if it is not a time (empty, 'None').
+int64_t walletTime2Timestamp(const QString & timeStr);
+
 // Convert time interval in seconds into 2 sevel word description.
 QString interval2String(int64_t intervalSec, bool shortUnits, int tiers);
 
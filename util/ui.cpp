@@ -20,7 +20,12 @@
 #include "../util/stringutils.h"
 #include <QVector>
 #include <climits>
-#include <QSet>
+#include <limits>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <functional>
+#include <cmath>
 
 namespace util {
 
@@ -29,153 +34,176 @@ static
 uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs,
                                        uint64_t changeOutputs, uint64_t totalNanoCoins, QStringList& txnOutputList);
 
-static int calcSubstituteIndex( QVector<wallet::WalletOutput> & resultBucket, const wallet::WalletOutput & testOutput, int64_t change ) {
-    double bestWeightedGain = 0.0;
-    int bestIndex = -1;
-
-    const double testWeightedValue = testOutput.getWeightedValue();
+// Coin selection works on the compact struct-of-arrays copy of the outputs. WalletOutput is still large,
+// copying and sorting them for every call is expensive for the wallets with thousands of mining outputs.
+struct SelectionOutputs {
+    QVector<int64_t> value;       // nano coins, sorted in DEC order
+    QVector<double>  cost;        // weighted value, this is what we are minimizing
+    QVector<int>     outputIdx;   // index in the input outputs vector
+    QVector<int64_t> suffixValue; // suffixValue[i] - sum of value[i..]. Size is N+1
+    QVector<double>  suffixMinWeight; // suffixMinWeight[i] - min weight in [i..]. Size is N+1
+};
 
-    for (int k=0;k<resultBucket.size();k++) {
-        const auto & out = resultBucket[k];
-        if (out.valueNano - testOutput.valueNano > change)
-            continue;
+// Time budget for branch and bound. If it is not enough, the best found selection will be used.
+static const qint64 COIN_SELECTION_TIME_BUDGET_MS = 250;
+
+static void buildSelectionOutputs( const QVector<wallet::WalletOutput> & inputOutputs, SelectionOutputs & so ) {
+    const int N = inputOutputs.size();
+
+    // Reading the outputs once, sorting is done on the compact data
+    QVector<int64_t> value(N);
+    QVector<double>  cost(N);
+    QVector<double>  weight(N);
+    QVector<int>     order(N);
+    for (int i=0;i<N;i++) {
+        const auto & o = inputOutputs[i];
+        value[i] = o.valueNano;
+        cost[i] = o.getWeightedValue();
+        weight[i] = o.weight;
+        order[i] = i;
+    }
 
-        double weightedGain = out.getWeightedValue() - testWeightedValue;
-        if (weightedGain>bestWeightedGain) {
-            bestWeightedGain = weightedGain;
-            bestIndex = k;
-        }
+    // DEC by value, same values by INC cost. Identical outputs must be neighbours, search is skipping them.
+    std::sort(order.begin(), order.end(), [&value, &cost](int i1, int i2) {
+        if (value[i1] != value[i2])
+            return value[i2] < value[i1];
+        return cost[i1] < cost[i2];
+    });
+
+    so.value.resize(N);
+    so.cost.resize(N);
+    so.outputIdx = order;
+    so.suffixValue.resize(N+1);
+    so.suffixMinWeight.resize(N+1);
+
+    for (int i=0;i<N;i++) {
+        so.value[i] = value[order[i]];
+        so.cost[i] = cost[order[i]];
     }
 
-    return bestIndex;
+    so.suffixValue[N] = 0;
+    so.suffixMinWeight[N] = 0.0;
+    for (int i=N-1;i>=0;i--) {
+        so.suffixValue[i] = so.suffixValue[i+1] + so.value[i];
+        const double w = weight[order[i]];
+        so.suffixMinWeight[i] = (i==N-1) ? w : std::min(w, so.suffixMinWeight[i+1]);
+    }
 }
 
-// Return resulting bucket weighted amount. Reason: we don't case about change, minimization target is weighted amount.
-static double optimizeBucket( QVector<wallet::WalletOutput> & resultBucket, const QVector<wallet::WalletOutput> & inputOutputs, int64_t nanoCoins ) {
-
-    QSet<QString> bucketCommits;
-    int64_t change = -nanoCoins;
-    for (const auto & out: resultBucket) {
-        bucketCommits += out.outputCommitment;
-        change += out.valueNano;
-    }
-    Q_ASSERT(change>=0); // Not enough funds?
-
-    bool foundBetterSolution = true;
-    while (foundBetterSolution) {
-        foundBetterSolution = false;
-        // doing single scan
-        for (wallet::WalletOutput out: inputOutputs) {
-            if ( bucketCommits.contains(out.outputCommitment) )
-                continue;
-
-            // Check if can substitute
-            int idx = calcSubstituteIndex( resultBucket, out, change );
-            while (idx>=0) {
-                wallet::WalletOutput delOutput = resultBucket[idx];
-                resultBucket[idx] = out;
-                Q_ASSERT( out.getWeightedValue() < delOutput.getWeightedValue() );
-                change -= delOutput.valueNano;
-                change += out.valueNano;
-                Q_ASSERT(change>=0);
-
-                bucketCommits -= delOutput.outputCommitment;
-                bucketCommits += out.outputCommitment;
-
-                foundBetterSolution = true;
-
-                out = delOutput;
-                idx = calcSubstituteIndex( resultBucket, out, change );
+// Depth first branch and bound over the outputs sorted by value. Include branch goes first, so the first
+// solutions are found quickly, the rest of the time is spent on improving them.
+// Prune when:
+//   - the rest of the outputs can't cover the amount;
+//   - the selection cost plus the lowest possible cost of the missing amount is not better than the best solution.
+// selection - in/out: initial solution (must be valid), result is the best found solution.
+// Return true if the search space was fully explored, so the result is optimal.
+static bool selectOutputsBnB( const SelectionOutputs & so, int64_t nanoCoins, QVector<int> & selection ) {
+    const int N = so.value.size();
+
+    double bestCost = 0.0;
+    for (int i : selection)
+        bestCost += so.cost[i];
+
+    const double minWeight = so.suffixMinWeight[0];
+
+    QVector<int> current;
+    int64_t curValue = 0;
+    double curCost = 0.0;
+    int pos = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    uint32_t steps = 0;
+
+    while (true) {
+        if ( (++steps & 0xFFF) == 0 && timer.elapsed() > COIN_SELECTION_TIME_BUDGET_MS )
+            return false;
+
+        bool backtrack = false;
+        if (curValue >= nanoCoins) {
+            // Adding more outputs will only make it worse
+            if (curCost < bestCost) {
+                bestCost = curCost;
+                selection = current;
+                if (bestCost <= double(nanoCoins) * minWeight)
+                    return true; // No change, can't be better
             }
+            backtrack = true;
+        }
+        else if ( curValue + so.suffixValue[pos] < nanoCoins ) {
+            backtrack = true;
+        }
+        else if ( curCost + double(nanoCoins - curValue) * so.suffixMinWeight[pos] >= bestCost ) {
+            backtrack = true;
         }
-    }
 
-    double resultWeightedSum = 0.0;
-    for (const auto & out: resultBucket)
-        resultWeightedSum += out.getWeightedValue();
+        if (!backtrack) {
+            // Outputs that cover the amount but too large to improve the best solution are skipped.
+            // The limit is only decreasing deeper in the tree, so such outputs are useless for the whole subtree.
+            if (minWeight > 0.0) {
+                const double limit = std::max( double(nanoCoins - curValue), std::ceil((bestCost - curCost) / minWeight) );
+                if ( double(so.value[pos]) >= limit ) {
+                    // double(INT64_MAX) is 2^63, casting it or anything above back to int64_t overflows
+                    const int64_t limitValue = limit >= double(std::numeric_limits<int64_t>::max()) ?
+                                std::numeric_limits<int64_t>::max() : int64_t(limit);
+                    pos = int( std::upper_bound(so.value.begin() + pos, so.value.end(), limitValue, std::greater<int64_t>()) - so.value.begin() );
+                    continue;
+                }
+            }
 
-    return resultWeightedSum;
-}
+            // Include branch
+            Q_ASSERT(pos<N);
+            current.push_back(pos);
+            curValue += so.value[pos];
+            curCost += so.cost[pos];
+            pos++;
+            continue;
+        }
 
+        if (current.isEmpty())
+            return true; // Everything is explored
+
+        // Exclude branch for the last included output
+        const int last = current.takeLast();
+        curValue -= so.value[last];
+        curCost -= so.cost[last];
+        pos = last+1;
+        // Including same output instead of excluded one will give the same result
+        while ( pos<N && so.value[pos]==so.value[last] && so.cost[pos]==so.cost[last] )
+            pos++;
+    }
+}
 
-// nanoCoins expected to include the fees. Here we are calculating the outputs that will produce minimal change
+// nanoCoins expected to include the fees. Here we are calculating the outputs that will produce minimal change.
+// Minimization target is weighted amount, so for regular outputs (weight is 1.0) it is a change.
 bool calcOutputsToSpend( int64_t nanoCoins, const QVector<wallet::WalletOutput> & inputOutputs, QStringList & resultOutputs ) {
-    // Try 1,2,3 and 4 outputs to spend (sorry, different workflows)
-    // Than - first smallest commits
-
-    // Sorting in INC order
-    QVector<wallet::WalletOutput> outputs = inputOutputs;
-    std::sort(outputs.begin(), outputs.end(), [](const wallet::WalletOutput &o1, const wallet::WalletOutput &o2) {return o2.valueNano < o1.valueNano;});
+    // At least one output need to be spent
+    nanoCoins = std::max(nanoCoins, int64_t(1));
 
+    SelectionOutputs so;
+    buildSelectionOutputs(inputOutputs, so);
 
-    // Let's try to minimize the weighted cost for the outputs.
-    // 1 Select few sets of outputs on the result
-    // 2 Trying to minimize the weight by swapping the outputs from the bucket.
-    // 3 Increas number of ouput by step (1 will not work and our tests show that for 3 outputs. ).
-    // Repeat #2
-    // If new result better or the same, go to #3
-    // Done, prev result is an answer
+    if (so.suffixValue[0] < nanoCoins)
+        return false; // not enough funds
 
-    // Calculating min number of outputs.
-    QVector<int> outputsNumber;
-
-    // Min Number of outputs.
+    // Initial solution - the largest outputs first. It has min number of outputs.
+    QVector<int> selection;
     {
-        int64_t change = nanoCoins; // Expected to be negative
-        int minOutputsNumber = 0;
-        for ( const auto & out : outputs ) {
-            if (change <= 0)
-                break;
-            change -= out.valueNano;
-            minOutputsNumber++;
-        }
-        if(change>0)
-            return false; // not enough funds
-
-        change = nanoCoins; // Expected to be negative
-        int maxOutputsNumber = 0;
-        for ( auto o = outputs.rbegin(); o!=outputs.rend(); o++ ) {
-            if (change <= 0)
-                break;
-            change -= o->valueNano;
-            maxOutputsNumber++;
+        int64_t change = nanoCoins;
+        for (int i=0; change>0 || selection.isEmpty(); i++) {
+            selection.push_back(i);
+            change -= so.value[i];
         }
-        Q_ASSERT(change<=0);
-
-        Q_ASSERT(minOutputsNumber<=maxOutputsNumber);
-
-        int n=minOutputsNumber;
-        for (; n<std::min(maxOutputsNumber,5); n++)
-            outputsNumber.push_back(n);
-
-        int step = std::max(1,(maxOutputsNumber-minOutputsNumber)/10);
-        for (; n<maxOutputsNumber; n+=step)
-            outputsNumber.push_back(n);
-
-        outputsNumber.push_back(maxOutputsNumber);
     }
-    Q_ASSERT(!outputsNumber.isEmpty());
 
-    QVector<wallet::WalletOutput> resultBucket;
-    double resultWeightAmount = 100000000.0;
-
-    for ( int outN : outputsNumber ) {
-        QVector<wallet::WalletOutput> bucket;
-        for ( int t=0;t<outN; t++ ) {
-            bucket.push_back(outputs[t]);
-        }
-
-        double weightedAmount = optimizeBucket( bucket, outputs, nanoCoins );
-        if (resultBucket.isEmpty() || weightedAmount < resultWeightAmount) {
-            resultBucket = bucket;
-            resultWeightAmount = weightedAmount;
-        }
-    }
+    bool optimal = selectOutputsBnB( so, nanoCoins, selection );
+    if (!optimal)
+        qDebug() << "calcOutputsToSpend time budget is exceeded for " << inputOutputs.size() << " outputs, using the best found solution";
 
-    Q_ASSERT(!resultBucket.isEmpty());
+    Q_ASSERT(!selection.isEmpty());
 
-    for (const auto & o : resultBucket) {
-        resultOutputs += o.outputCommitment;
+    for (int i : selection) {
+        resultOutputs += inputOutputs[so.outputIdx[i]].outputCommitment;
     }
     return true;
 }
@@ -212,12 +240,12 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
 
     for (wallet::WalletOutput o : outputs) {
         // Keep unspent only
-        if (o.status != "Unspent") // Interesting only in Unspent outputs
+        if (!o.isUnspent()) // Interesting only in Unspent outputs
             continue;
         // Skip mined that can't spend
-        if (o.coinbase && o.numOfConfirms.toLong() <= 1440)
+        if (o.coinbase && o.numOfConfirms <= 1440)
             continue;
-        if (!o.coinbase && o.numOfConfirms.toInt() < appContext->getSendCoinsParams().inputConfirmationNumber)
+        if (!o.coinbase && o.numOfConfirms < appContext->getSendCoinsParams().inputConfirmationNumber)
             continue;
         // Skip locked
         if (appContext->isLockedOutputs(o.outputCommitment).first)
@@ -245,12 +273,12 @@ findSpendableOutputs(const QString& accountName, const wallet::Wallet* wallet, c
 
     QVector<wallet::WalletOutput>  outputs = wallet->getwalletOutputs().value(accountName);
     for ( wallet::WalletOutput o : outputs) {
-        if ( o.status != "Unspent" ) // Interested only in Unspent outputs
+        if ( !o.isUnspent() ) // Interested only in Unspent outputs
             continue;
         // Skip mined that can't spend
-        if (o.coinbase && o.numOfConfirms.toLong()<=mwc::COIN_BASE_CONFIRM_NUMBER )
+        if (o.coinbase && o.numOfConfirms<=mwc::COIN_BASE_CONFIRM_NUMBER )
             continue;
-        if (!o.coinbase && o.numOfConfirms.toInt() < appContext->getSendCoinsParams().inputConfirmationNumber)
+        if (!o.coinbase && o.numOfConfirms < appContext->getSendCoinsParams().inputConfirmationNumber)
             continue;
         // ensure outputs locked by Qt Wallet are not used
         // !!!! Commented because isLockOutputEnabled  is about permanent user defined settings
@@ -417,9 +417,10 @@ void MockWallet::sendTo(const QString &account, int64_t coinNano, const QString
 
 // Show outputs for the wallet
 // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-void MockWallet::getOutputs(QString account, bool show_spent, bool enforceSync) {
+void MockWallet::getOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache) {
     Q_UNUSED(show_spent)
     Q_UNUSED(enforceSync)
+    Q_UNUSED(fromCache)
 
     QVector<WalletOutput> outputs;
     outputs.push_back(WalletOutput::create("01234327643847563487654386",
@@ -436,8 +437,9 @@ void MockWallet::getOutputs(QString account, bool show_spent, bool enforceSync)
 
 // Show all transactions for current account
 // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-void MockWallet::getTransactions(QString account, bool enforceSync) {
+void MockWallet::getTransactions(QString account, bool enforceSync, bool fromCache) {
     Q_UNUSED(enforceSync)
+    Q_UNUSED(fromCache)
 
     WalletTransaction tx;
     tx.setData(2,
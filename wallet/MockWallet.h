@@ -264,11 +264,11 @@ public:
 
     // Show outputs for the wallet
     // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-    virtual void getOutputs(QString account, bool show_spent, bool enforceSync)  override;
+    virtual void getOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache)  override;
 
     // Show all transactions for current account
     // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-    virtual void getTransactions(QString account, bool enforceSync)  override;
+    virtual void getTransactions(QString account, bool enforceSync, bool fromCache)  override;
 
     // get Extended info for specific transaction
     // Check Signal: onTransactionById( bool success, QString account, int64_t height, WalletTransaction transaction, QVector<WalletOutput> outputs, QVector<QString> messages )
@@ -0,0 +1,83 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "balanceview.h"
+#include "../core/appcontext.h"
+
+namespace wallet {
+
+const QVector<AccountInfo> & BalanceView::getBalance(const QVector<AccountInfo> & accountInfoNoLocks,
+                                                     const QMap<QString, QVector<WalletOutput>> & walletOutputs,
+                                                     const core::AppContext * appContext) {
+    // Manual locks and confirmation number are settings, they can be changed at any time
+    if (!valid || confNumber != appContext->getSendCoinsParams().inputConfirmationNumber ||
+            lockOutputEnabled != appContext->isLockOutputEnabled())
+        rebuild(accountInfoNoLocks, walletOutputs, appContext);
+
+    return balance;
+}
+
+bool BalanceView::updateOutputLock(const QString & commitment, const core::AppContext * appContext) {
+    if (!valid)
+        return false;
+
+    auto out = outputs.find(commitment);
+    if (out == outputs.end())
+        return false;
+
+    const bool locked = appContext->isLockedOutputs(commitment).first;
+    if (locked == out->locked)
+        return false;
+
+    out->locked = locked;
+    AccountInfo & ai = balance[out->accountIdx];
+    const int64_t delta = locked ? out->valueNano : -out->valueNano;
+    ai.lockedByPrevTransaction += delta;
+    ai.currentlySpendable -= delta;
+    return true;
+}
+
+void BalanceView::rebuild(const QVector<AccountInfo> & accountInfoNoLocks,
+                          const QMap<QString, QVector<WalletOutput>> & walletOutputs,
+                          const core::AppContext * appContext) {
+    confNumber = appContext->getSendCoinsParams().inputConfirmationNumber;
+    lockOutputEnabled = appContext->isLockOutputEnabled();
+
+    balance = accountInfoNoLocks;
+    outputs.clear();
+
+    for (int accIdx = 0; accIdx < balance.size(); accIdx++) {
+        AccountInfo & ai = balance[accIdx];
+
+        for (const WalletOutput & out : walletOutputs.value(ai.accountName)) {
+            int64_t dh = ai.height - std::max(int64_t(0), out.blockHeight);
+            if (dh < int64_t(confNumber))
+                continue;
+
+            OutputRef ref;
+            ref.accountIdx = accIdx;
+            ref.valueNano = out.valueNano;
+            ref.locked = appContext->isLockedOutputs(out.outputCommitment).first;
+            outputs.insert(out.outputCommitment, ref);
+
+            if (ref.locked) {
+                ai.lockedByPrevTransaction += out.valueNano;
+                ai.currentlySpendable -= out.valueNano;
+            }
+        }
+    }
+    valid = true;
+}
+
+}
@@ -0,0 +1,71 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BALANCEVIEW_H
+#define MWC_QT_WALLET_BALANCEVIEW_H
+
+#include "wallet.h"
+#include <QHash>
+#include <QMap>
+
+namespace core {
+class AppContext;
+}
+
+namespace wallet {
+
+// Account balances with the locked outputs applied: locked outputs are moved from spendable to locked.
+// The view is built once from the balances and outputs that mwc713 reported, then lock changes
+// are applied per output. Every balance or outputs update from mwc713 invalidates the view.
+class BalanceView {
+public:
+    BalanceView() {}
+    ~BalanceView() {}
+
+    // Balances or outputs were changed (new block, new info), the view will be rebuilt on the next request
+    void invalidate() {valid = false;}
+
+    // Balances with the locks applied. Rebuild the view if needed.
+    const QVector<AccountInfo> & getBalance(const QVector<AccountInfo> & accountInfoNoLocks,
+                                            const QMap<QString, QVector<WalletOutput>> & walletOutputs,
+                                            const core::AppContext * appContext);
+
+    // Lock state of the output was changed. Return true if the view was affected.
+    bool updateOutputLock(const QString & commitment, const core::AppContext * appContext);
+
+private:
+    struct OutputRef {
+        int     accountIdx = -1;
+        int64_t valueNano = 0;
+        bool    locked = false;
+    };
+
+    void rebuild(const QVector<AccountInfo> & accountInfoNoLocks,
+                 const QMap<QString, QVector<WalletOutput>> & walletOutputs,
+                 const core::AppContext * appContext);
+
+private:
+    bool valid = false;
+    // Settings that the view was built with
+    int  confNumber = -1;
+    bool lockOutputEnabled = false;
+
+    QVector<AccountInfo> balance;
+    // Confirmed outputs by commitment. Only those can affect the spendable balance
+    QHash<QString, OutputRef> outputs;
+};
+
+}
+
+#endif //MWC_QT_WALLET_BALANCEVIEW_H
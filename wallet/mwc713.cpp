@@ -42,6 +42,7 @@
 #include "../node/MwcNode.h"
 #include <QCoreApplication>
 #include "../util/crypto.h"
+#include "../core/Scheduler.h"
 #include "../core/WndManager.h"
 #include "../bridge/notification_b.h"
 
@@ -66,7 +67,8 @@ MWC713::MWC713(QString _mwc713path, QString _mwc713configPath, core::AppContext
 
     defaultConfig = readWalletConfig(mwc::MWC713_DEFAULT_CONFIG);
 
-    startTimer(60000); // 1 minutre timer. Using to check tor connection
+    // 1 minute timer. Using to check tor connection
+    core::getScheduler()->addPeriodicJob("TorConnectionCheck", 60000, this, [this]() {checkTorConnection();});
 }
 
 MWC713::~MWC713() {
@@ -207,6 +209,7 @@ void MWC713::resetData(STARTED_MODE _startedMode) {
     hasHttpTls = false;
     walletPasswordHash = "";
     outputsLines.clear();
+    lineSplitter.reset();
     currentAccount = "default";
     recieveAccount = "default";
     currentConfig = WalletConfig();
@@ -423,6 +426,7 @@ void MWC713::processStop(bool exitNicely) {
     mwcAddress = "";
     accountInfoNoLocks.clear();
     walletOutputs.clear();
+    balanceView.invalidate();
     currentAccount = "default"; // Keep current account by name. It fit better to mwc713 interactions.
     collectedAccountInfo.clear();
 
@@ -674,6 +678,49 @@ void MWC713::updateWalletBalance(bool enforceSync, bool showSyncProgress, bool s
     eventCollector->addTask(TASK_PRIORITY::TASK_IDLE, taskGroup);
 }
 
+void MWC713::markAccountDirty(const QString & account) {
+    if (!account.isEmpty())
+        dirtyAccounts.insert(account);
+}
+
+// Request balance update for the dirty accounts. Switching to every account is expensive, for the wallets with
+// many accounts a single slate should not trigger the full sweep.
+// Check signal: onWalletBalanceUpdated
+void MWC713::updateDirtyAccountsBalance() {
+    if (!isWalletRunningAndLoggedIn())
+        return; // ignoring request
+
+    if (accountInfoNoLocks.isEmpty()) {
+        // Nothing to merge with, need the full list
+        updateWalletBalance(false, true);
+        return;
+    }
+
+    // Full update is in the queue, it will take care about all accounts
+    Mwc713Task *fullTask = new TaskAccountList(this);
+    bool hasFullTask = eventCollector->hasTask(fullTask);
+    delete fullTask;
+    if (hasFullTask)
+        return;
+
+    // Refresh is already in the queue, dirty accounts will be collected until it is started
+    Mwc713Task *task = new TaskDirtyAccountList(this);
+    if (eventCollector->hasTask(task)) {
+        delete task;
+        return;
+    }
+
+    QVector<QPair<Mwc713Task *, int64_t>> taskGroup;
+    if (!hasPassword()) {
+        // By some reasons wallet without password can be locked by itself
+        taskGroup.push_back(TSK(new TaskUnlock(this, ""), TaskUnlock::TIMEOUT));
+    }
+    taskGroup += create_sync_if_need(true, false);
+    taskGroup.push_back(TSK(task, -1));
+
+    eventCollector->addTask(TASK_PRIORITY::TASK_IDLE, taskGroup);
+}
+
 // Create another account, note no delete exist for accounts
 // Check Signal:  onAccountCreated
 void MWC713::createAccount(const QString &accountName) {
@@ -749,6 +796,9 @@ void MWC713::sendTo(const QString &account, int64_t coinNano, const QString &add
                     const QString &apiSecret,
                     QString message, int inputConfirmationNumber, int changeOutputs, const QStringList &outputs,
                     bool fluff, int ttl_blocks, bool generateProof, QString expectedproofAddress) {
+    // Balance will be refreshed at onSend. Refresh can't start before the send because it has idle priority
+    markAccountDirty(account);
+
     // switch account first
 
     QVector<QPair<Mwc713Task *, int64_t>> taskGroup{
@@ -878,7 +928,11 @@ void MWC713::finalizeSlatepack(QString slatepack, bool fluff, QString tag) {
 
 // Show outputs for the wallet
 // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> Transactions)
-void MWC713::getOutputs(QString account, bool show_spent, bool enforceSync) {
+void MWC713::getOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache) {
+    // Cached data is shown while the fresh one is requested
+    if (fromCache)
+        emitCachedOutputs(account, show_spent);
+
     QVector<QPair<Mwc713Task *, int64_t>> taskGroup = create_sync_if_need(true, enforceSync);
     // Need to switch account first
 
@@ -890,7 +944,11 @@ void MWC713::getOutputs(QString account, bool show_spent, bool enforceSync) {
     eventCollector->addTask(TASK_PRIORITY::TASK_NORMAL, taskGroup);
 }
 
-void MWC713::getTransactions(QString account, bool enforceSync) {
+void MWC713::getTransactions(QString account, bool enforceSync, bool fromCache) {
+    // Cached data is shown while the fresh one is requested
+    if (fromCache)
+        emitCachedTransactions(account);
+
     QVector<QPair<Mwc713Task *, int64_t>> taskGroup = create_sync_if_need(true, enforceSync);
     // Need to switch account first
     taskGroup.push_back(TSK(new TaskAccountSwitch(this, account), TaskAccountSwitch::TIMEOUT));
@@ -968,6 +1026,10 @@ void MWC713::createNewSwapTrade(QString account,
                                 QString mkt_trade_tag,
                                 QVector<QString> params) {
 
+    // Trade locks the outputs. Balance will be refreshed when trade is created
+    if (!dryRun)
+        markAccountDirty(account);
+
     QVector<QPair<Mwc713Task *, int64_t>> taskGroup{
             TSK(new TaskAccountSwitch(this, account), TaskAccountSwitch::TIMEOUT),
             TSK(new TaskCreateNewSwapTrade(this, outputs, min_confirmations, // minimum number of confimations
@@ -1427,6 +1489,7 @@ void MWC713::setRecoveryResults(bool started, bool finishedWithSuccess, QString
     }
 
     if (finishedWithSuccess) {
+        dataCache.clear();
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO,
                                           QString("MWC Wallet was successfully recovered from the mnemonic"));
     } else {
@@ -1444,6 +1507,8 @@ void MWC713::setRecoveryProgress(int64_t progress, int64_t limit) {
 // Apply account list. Exploring what does wallet has
 void MWC713::updateAccountList(QVector<QString> accounts) {
     collectedAccountInfo.clear();
+    // All accounts will be requested
+    dirtyAccounts.clear();
 
     core::SendCoinsParams params = appContext->getSendCoinsParams();
 
@@ -1473,6 +1538,7 @@ void MWC713::updateAccountProgress(int accountIdx, int totalAccounts) {
 void MWC713::updateAccountFinalize() {
     accountInfoNoLocks = collectedAccountInfo;
     collectedAccountInfo.clear();
+    balanceView.invalidate();
 
     QString accountBalanceStr;
 
@@ -1502,11 +1568,60 @@ void MWC713::updateAccountFinalize() {
                             {TSK(new TaskAccountSwitch(this, currentAccount), TaskAccountSwitch::TIMEOUT)}, 0);
 }
 
+// Request info for the dirty accounts only. Note, the order of the accounts is preserved.
+void MWC713::updateDirtyAccountList() {
+    QVector<QString> accounts;
+    for (const auto &acc : accountInfoNoLocks) {
+        if (dirtyAccounts.contains(acc.accountName))
+            accounts.push_back(acc.accountName);
+    }
+    // Unknown accounts are skipped, the full update will get them
+    dirtyAccounts.clear();
+
+    if (accounts.isEmpty())
+        return;
+
+    collectedAccountInfo.clear();
+
+    core::SendCoinsParams params = appContext->getSendCoinsParams();
+
+    QVector<QPair<Mwc713Task *, int64_t>> taskGroup;
+    for (const QString &acc : accounts) {
+        taskGroup.push_back(TSK(new TaskAccountSwitch(this, acc), TaskAccountSwitch::TIMEOUT));
+        taskGroup.push_back(TSK(new TaskAccountInfo(this, params.inputConfirmationNumber), TaskAccountInfo::TIMEOUT));
+    }
+    taskGroup.push_back(TSK(new TaskDirtyAccountListFinal(this, accounts), -1));
+
+    eventCollector->addTask(TASK_PRIORITY::TASK_NOW, taskGroup, 0); // Starting everything NOW
+}
+
+void MWC713::updateDirtyAccountsFinalize(QVector<QString> accounts) {
+    // Only requested accounts are collected, others are kept as they are
+    for (const auto &acc : collectedAccountInfo) {
+        for (auto &ai : accountInfoNoLocks) {
+            if (ai.accountName == acc.accountName) {
+                ai = acc;
+                break;
+            }
+        }
+    }
+    collectedAccountInfo.clear();
+    balanceView.invalidate();
+
+    logger::logEmit("MWC713", "onWalletBalanceUpdated",
+                    "origin from updateDirtyAccountsFinalize, accounts: " + QStringList(accounts.toList()).join(","));
+    emit onWalletBalanceUpdated();
+
+    eventCollector->addTask(TASK_PRIORITY::TASK_NOW,
+                            {TSK(new TaskAccountSwitch(this, currentAccount), TaskAccountSwitch::TIMEOUT)}, 0);
+}
+
 void MWC713::createNewAccount(QString newAccountName) {
     // Add new account info into the list. New account is allways empty
     AccountInfo acc;
     acc.setData(newAccountName, 0, 0, 0, 0, 0, false);
     accountInfoNoLocks.push_back(acc);
+    balanceView.invalidate();
 
     logger::logEmit("MWC713", "onAccountCreated", newAccountName);
     logger::logEmit("MWC713", "onWalletBalanceUpdated", "");
@@ -1528,6 +1643,7 @@ void MWC713::updateRenameAccount(const QString &oldName, const QString &newName,
             walletOutputs.insert(newName, walletOutputs.value(oldName));
         }
     }
+    balanceView.invalidate();
 
     if (createSimulation) {
         logger::logEmit("MWC713", "onAccountCreated", newName);
@@ -1579,6 +1695,7 @@ void MWC713::infoResults(QString currentAccountName, int64_t height,
 
 void
 MWC713::setSendResults(bool success, QStringList errors, QString address, int64_t txid, QString slate, QString mwc) {
+    dataCache.invalidate(); // New or updated transaction
     if (success) {
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO, QString("You successfully sent slate " + slate +
                                                                                " with " + mwc + " MWC to " + address));
@@ -1586,11 +1703,12 @@ MWC713::setSendResults(bool success, QStringList errors, QString address, int64_
 
     logger::logEmit("MWC713", "onSend", "success=" + QString::number(success));
     emit onSend(success, errors, address, txid, slate, mwc);
-    updateWalletBalance(false, true);
+    updateDirtyAccountsBalance();
 }
 
 
 void MWC713::reportSlateReceivedFrom(QString slate, QString mwc, QString fromAddr, QString message) {
+    dataCache.invalidate(); // New or updated transaction
     if ( fromAddr.startsWith("Integrity fee") || fromAddr=="Withdraw Integrity funds" )
         return; // We don't want to show that.
 
@@ -1603,7 +1721,8 @@ void MWC713::reportSlateReceivedFrom(QString slate, QString mwc, QString fromAdd
 
     emit onSlateReceivedFrom(slate, mwc, fromAddr, message);
 
-    updateWalletBalance(false, true);
+    markAccountDirty(recieveAccount);
+    updateDirtyAccountsBalance();
 
     //if (!appContext->getNotificationWindowsEnabled())
     // From almost everybody get a feedback that Receive message does expected.
@@ -1618,6 +1737,7 @@ void MWC713::reportSlateReceivedFrom(QString slate, QString mwc, QString fromAdd
 }
 
 void MWC713::setSendFileResult(bool success, QStringList errors, QString fileName) {
+    dataCache.invalidate(); // New or updated transaction
 
     notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO,
                                       QString("File transaction was initiated for " + fileName));
@@ -1627,6 +1747,7 @@ void MWC713::setSendFileResult(bool success, QStringList errors, QString fileNam
 }
 
 void MWC713::setReceiveFile(bool success, QStringList errors, QString inFileName, QString outFn) {
+    dataCache.invalidate(); // New or updated transaction
     if (success) {
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO,
                                           QString("File receive transaction was processed for " + inFileName));
@@ -1637,6 +1758,7 @@ void MWC713::setReceiveFile(bool success, QStringList errors, QString inFileName
 }
 
 void MWC713::setFinalizeFile(bool success, QStringList errors, QString fileName) {
+    dataCache.invalidate(); // New or updated transaction
     if (success) {
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO, QString("File finalized for " + fileName));
     }
@@ -1646,6 +1768,7 @@ void MWC713::setFinalizeFile(bool success, QStringList errors, QString fileName)
 }
 
 void MWC713::setSubmitFile(bool success, QString message, QString fileName) {
+    dataCache.invalidate(); // New or updated transaction
     if (success) {
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO,
                                           QString("Published transaction for " + fileName));
@@ -1656,22 +1779,29 @@ void MWC713::setSubmitFile(bool success, QString message, QString fileName) {
 }
 
 void MWC713::setSendSlatepack(QString error, QString slatepack, QString tag) {
+    dataCache.invalidate(); // New or updated transaction
     logger::logEmit("MWC713", "setSendSlatepack", +" tag=" + tag + " error=" + error + " Slatepack: " + slatepack);
     emit onSendSlatepack(tag, error, slatepack);
 
 }
 
 void MWC713::setReceiveSlatepack(QString error, QString slatepack, QString tag) {
+    dataCache.invalidate(); // New or updated transaction
     logger::logEmit("MWC713", "setReceiveSlatepack", +" tag=" + tag + " error=" + error + " Slatepack: " + slatepack);
     emit onReceiveSlatepack(tag, error, slatepack);
 }
 
 void MWC713::setFinalizedSlatepack(QString error, QString txUuid, QString tag) {
+    dataCache.invalidate(); // New or updated transaction
     logger::logEmit("MWC713", "setFinalizedSlatepack", +" tag=" + tag + " error=" + error + " txUuid: " + txUuid);
     emit onFinalizeSlatepack(tag, error, txUuid);
 }
 
 void MWC713::setTransactions(QString account, int64_t height, QVector<WalletTransaction> Transactions) {
+    AccountInfo balance;
+    if (getCacheAccountBalance(account, balance))
+        Transactions = dataCache.updateTransactions(account, balance, height, Transactions);
+
     logger::logEmit("MWC713", "onTransactions", "account=" + account);
     emit onTransactions(account, height, Transactions);
 }
@@ -1686,6 +1816,10 @@ void MWC713::setTransactionById(bool success, QString account, int64_t height, W
 
 
 void MWC713::setOutputs(QString account, bool show_spent, int64_t height, QVector<WalletOutput> outputs) {
+    AccountInfo balance;
+    if (getCacheAccountBalance(account, balance))
+        dataCache.updateOutputs(account, show_spent, balance, height, outputs);
+
     setWalletOutputs(account, outputs);
     logger::logEmit("MWC713", "onOutputs", "account=" + account);
     emit onOutputs(account, show_spent, height, outputs);
@@ -1702,6 +1836,7 @@ void MWC713::setVerifyProofResults(bool success, QString fn, QString msg) {
 }
 
 void MWC713::setTransCancelResult(bool success, const QString &account, int64_t transId, QString errMsg) {
+    dataCache.invalidate(); // New or updated transaction
     logger::logEmit("MWC713", "onCancelTransacton", "success=" + QString::number(success));
     emit onCancelTransacton(success, account, transId, errMsg);
 }
@@ -1720,6 +1855,8 @@ void MWC713::setSetReceiveAccount(bool ok, QString accountOrMessage) {
 }
 
 void MWC713::setCheckResult(bool ok, QString errors) {
+    // Transactions and outputs was rebuilt from the chain
+    dataCache.clear();
 
     if (ok)
         notify::appendNotificationMessage(bridge::MESSAGE_LEVEL::INFO, "Account re-sync was finished successfully.");
@@ -1811,6 +1948,8 @@ void MWC713::setCreateNewSwapTrade(QString tag, bool dryRun, QVector<QString> pa
                     tag + ", " + (dryRun ? "dryRun:ON, " : "") + swapId + ", " + errMsg);
     emit onCreateNewSwapTrade(tag, dryRun, params, swapId, errMsg);
 
+    if (!dryRun)
+        updateDirtyAccountsBalance();
 }
 
 void MWC713::setCancelSwapTrade(QString swapId, QString errMsg) {
@@ -1906,6 +2045,7 @@ void MWC713::setRequestReceiverWalletAddress(QString url, QString address, QStri
 
 
 void MWC713::setRepost(int txIdx, QString err) {
+    dataCache.invalidate(); // New or updated transaction
     logger::logEmit("MWC713", "onRepost", err);
     emit onRepost(txIdx, err);
 }
@@ -2114,39 +2254,23 @@ void MWC713::mwc713readyReadStandardOutput() {
     if (mwc713process == nullptr)
         return;
 
-    QString str(ioutils::FilterEscSymbols(mwc713process->readAllStandardOutput()));
-    qDebug() << "Get output:" << str;
-    logger::logMwc713out(str);
-
-    // Let's filter out the possible prompt from the editor it can be located anywhere
-    // To filter out:  'wallet713>'
-    auto lns = str.split(QRegExp("[\r\n]"), QString::SkipEmptyParts);
+    QByteArray data = ioutils::FilterEscSymbols(mwc713process->readAllStandardOutput());
+    logger::logMwc713out(QString(data));
 
-    QString filteredStr;
-    for (auto ln : lns) {
-        if (ln.startsWith("wallet713>"))
-            ln = ln.mid(strlen("wallet713>")).trimmed();
-
-        if (!filteredStr.isEmpty())
-            filteredStr += "\n";
-        filteredStr += ln;
-
-        if (!ln.isEmpty()) {
-            while (outputsLines.size() > outputsLinesBufferSize)
-                outputsLines.pop_front();
-
-            outputsLines.push_back(ln);
-        }
-    }
+    // Splitter filter out the possible prompt 'wallet713>' and take the table rows for the running task.
+    // Rows are not needed to go through the trie, task will parse them.
+    QString str = lineSplitter.processData(data, eventCollector!=nullptr && eventCollector->isTableRowsAccepted());
+    qDebug() << "Get output:" << str;
 
-    if (str.size() > 0 && (str[0] == '\n' || str[0] == '\r'))
-        filteredStr = "\n" + filteredStr;
+    lineSplitter.appendLastLines(outputsLines, outputsLinesBufferSize);
 
-    if (str.size() > 0 && (str[str.size() - 1] == '\n' || str[str.size() - 1] == '\r')) {
-        filteredStr += "\n";
+    if (lineSplitter.hasTableRows()) {
+        QString rows = lineSplitter.takeTableRows();
+        if (eventCollector)
+            eventCollector->appendTableRows(rows);
     }
 
-    inputParser->processInput(filteredStr);
+    inputParser->processInput(str);
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -2398,6 +2522,8 @@ bool MWC713::setWalletConfig(const WalletConfig &_config, bool canStartNode) {
 void MWC713::onOutputLockChanged(QString commit) {
     qDebug() << "MWC713 Get onOutputLockChanged for " << commit;
 
+    balanceView.updateOutputLock(commit, appContext);
+
     logger::logEmit("MWC713", "onWalletBalanceUpdated", "origin from onOutputLockChanged, commit=" + commit);
     emit onWalletBalanceUpdated();
 
@@ -2405,41 +2531,68 @@ void MWC713::onOutputLockChanged(QString commit) {
 
 // process accountInfoNoLocks, apply locked outputs
 QVector<AccountInfo> MWC713::applyOutputLocksToBalance() const {
-    // !!!! Commented because isLockOutputEnabled  is about permanent user defined settings
+    // !!!! Not checking isLockOutputEnabled because it is about permanent user defined settings
     // For swap marketplace also there are temporary locks that we should process here
-    /*if (!appContext->isLockOutputEnabled())
-        return accountInfoNoLocks;*/
-
-    // Locks are enabled, need to firter all outputs...
 
-    QVector<AccountInfo> accountInfoWithLocks;
-    int confNumber = appContext->getSendCoinsParams().inputConfirmationNumber;
+    // View is rebuilt only if balances or outputs were changed, lock changes are applied per output
+    return balanceView.getBalance(accountInfoNoLocks, walletOutputs, appContext);
+}
 
-    for (AccountInfo ai : accountInfoNoLocks) {
+void MWC713::setWalletOutputs(const QString &account, const QVector<wallet::WalletOutput> &outputs) {
+    walletOutputs[account] = outputs;
+    balanceView.invalidate();
+}
 
-        // Checking Outputs if they locked
-        const QVector<wallet::WalletOutput> &accountOutputs = walletOutputs.value(ai.accountName);
-        for (const wallet::WalletOutput &out : accountOutputs) {
-            int64_t dh = ai.height - out.blockHeight.toLongLong();
-            if (dh < int64_t(confNumber))
-                continue;
+bool MWC713::getCacheAccountBalance(const QString & account, AccountInfo & balance) {
+    // Cache is per wallet instance
+    dataCache.setWallet(getWalletConfig().getDataPath());
 
-            if (appContext->isLockedOutputs(out.outputCommitment).first) {
-                ai.lockedByPrevTransaction += out.valueNano;
-                ai.currentlySpendable -= out.valueNano;
-            }
+    for (const auto & acc : accountInfoNoLocks) {
+        if (acc.accountName == account) {
+            balance = acc;
+            return true;
         }
-        accountInfoWithLocks.push_back(ai);
     }
-    return accountInfoWithLocks;
+    return false;
 }
 
-void MWC713::setWalletOutputs(const QString &account, const QVector<wallet::WalletOutput> &outputs) {
-    walletOutputs[account] = outputs;
+bool MWC713::emitCachedOutputs(const QString & account, bool showSpent) {
+    AccountInfo balance;
+    if (!getCacheAccountBalance(account, balance))
+        return false;
+
+    int64_t height = 0;
+    QVector<WalletOutput> outputs;
+    if (!dataCache.getOutputs(account, showSpent, balance, height, outputs))
+        return false;
+
+    // Respond async, caller expects that
+    QTimer::singleShot(0, this, [this, account, showSpent, height, outputs]() {
+        setWalletOutputs(account, outputs);
+        logger::logEmit("MWC713", "onOutputs", "account=" + account + " from cache");
+        emit onOutputs(account, showSpent, height, outputs);
+    });
+    return true;
+}
+
+bool MWC713::emitCachedTransactions(const QString & account) {
+    AccountInfo balance;
+    if (!getCacheAccountBalance(account, balance))
+        return false;
+
+    int64_t height = 0;
+    QVector<WalletTransaction> transactions;
+    if (!dataCache.getTransactions(account, balance, height, transactions))
+        return false;
+
+    QTimer::singleShot(0, this, [this, account, height, transactions]() {
+        logger::logEmit("MWC713", "onTransactions", "account=" + account + " from cache");
+        emit onTransactions(account, height, transactions);
+    });
+    return true;
 }
 
-void MWC713::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event)
+void MWC713::checkTorConnection() {
     if (isWalletRunningAndLoggedIn()) {
         if (torStarted) {
             // Checking tor connection
@@ -19,7 +19,11 @@
 #include <QObject>
 #include <QProcess>
 #include "../core/global.h"
+#include "../tries/mwc713linesplitter.h"
+#include "walletdatacache.h"
+#include "balanceview.h"
 #include <QMap>
+#include <QSet>
 
 namespace tries {
     class Mwc713InputParser;
@@ -258,11 +262,11 @@ public:
 
     // Show outputs for the wallet
     // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-    virtual void getOutputs(QString account, bool show_spent, bool enforceSync)  override;
+    virtual void getOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache)  override;
 
     // Show all transactions for current account
     // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-    virtual void getTransactions(QString account, bool enforceSync)  override;
+    virtual void getTransactions(QString account, bool enforceSync, bool fromCache)  override;
 
     // get Extended info for specific transaction
     // Check Signal: onTransactionById( bool success, QString account, int64_t height, WalletTransaction transaction, QVector<WalletOutput> outputs, QVector<QString> messages )
@@ -455,6 +459,9 @@ public:
     void updateAccountList( QVector<QString> accounts );
     void updateAccountProgress(int accountIdx, int totalAccounts);
     void updateAccountFinalize();
+    // Targeted refresh feedback. Only accounts from dirtyAccounts are requested.
+    void updateDirtyAccountList();
+    void updateDirtyAccountsFinalize( QVector<QString> accounts );
     void createNewAccount( QString newAccountName );
 
     void updateRenameAccount(const QString & oldName, const QString & newName, bool createSimulation,
@@ -575,7 +582,12 @@ public:
 
     void setTorConnectionStatus(bool online);
 protected:
-    virtual void timerEvent(QTimerEvent *event) override;
+    void checkTorConnection();
+
+    // Respond with cached data if it is still valid for the current account balance.
+    // Return false if there is nothing to respond with.
+    bool emitCachedOutputs(const QString & account, bool showSpent);
+    bool emitCachedTransactions(const QString & account);
 
 private:
     // Request sync (update_wallet_state) if it is not at the task Q.
@@ -610,6 +622,14 @@ private:
     // process accountInfoNoLocks, apply locked outputs
     QVector<AccountInfo> applyOutputLocksToBalance() const;
 
+    // Balance of this account is expected to be changed, it will be requested with the next targeted refresh
+    void markAccountDirty(const QString & account);
+    // Request balance for the dirty accounts only. Requests are coalesced while the refresh is in the queue.
+    void updateDirtyAccountsBalance();
+
+    // Balance (without locks) that define the cache state. Return false if account is unknown.
+    bool getCacheAccountBalance(const QString & account, AccountInfo & balance);
+
     static QString getTorLogFilename();
 private:
     core::AppContext * appContext = nullptr; // app context to store current account name
@@ -619,6 +639,7 @@ private:
     QString mwc713configPath; // config file for mwc713
     QProcess * mwc713process = nullptr;
     tries::Mwc713InputParser * inputParser = nullptr; // Parser will generate bunch of signals that wallet will listem on
+    tries::Mwc713LineSplitter lineSplitter; // Split the mwc713 output into lines before the parser
     const int outputsLinesBufferSize = 15;
     QList<QString> outputsLines; // Last few output lines. Will print in case of the crash
 
@@ -654,9 +675,14 @@ private:
     QVector<AccountInfo> accountInfoNoLocks;
     QString currentAccount = "default"; // Keep current account by name. It fit better to mwc713 interactions.
     QString recieveAccount = "default";
+    QSet<QString> dirtyAccounts; // Accounts that need balance refresh. Full account list refresh clean it.
 
     QMap<QString, QVector<wallet::WalletOutput> > walletOutputs; // Available outputs from this wallet. Key: account name, value outputs for this account
 
+    WalletDataCache dataCache; // Transactions and outputs from the previous requests
+    // Balances with locked outputs applied, see applyOutputLocksToBalance
+    mutable BalanceView balanceView;
+
     int64_t lastSyncTime = 0;
 
     WalletConfig currentConfig;
@@ -21,6 +21,7 @@
 #include "../core/Config.h"
 #include "../core/Notification.h"
 #include "../core/WndManager.h"
+#include "../core/Scheduler.h"
 
 namespace wallet {
 
@@ -82,6 +83,12 @@ QString toString(WALLET_EVENTS event) {
 }
 
 
+taskInfo::taskInfo(int _groupId, TASK_PRIORITY _priority, Mwc713Task* _task, int _timeout) :
+    groupId(_groupId), priority(_priority), task(_task), timeout(_timeout)
+{
+    readyEvents = task->getReadyEvents();
+}
+
 Mwc713EventManager::Mwc713EventManager(MWC713 * _mwc713wallet) : mwc713wallet(_mwc713wallet)
 {
 }
@@ -100,6 +107,7 @@ void Mwc713EventManager::clear() {
         delete t.task;
     }
     taskQ.clear();
+    taskQIndex.clear();
     events.clear();
     taskExecutionTimeLimit = 0;
 }
@@ -109,7 +117,8 @@ void Mwc713EventManager::connectWith(tries::Mwc713InputParser * inputParser) {
     Q_ASSERT(connected);
     Q_UNUSED(connected);
 
-    startTimer(500); // timeout checking. Twice a second is good enough for us
+    // timeout checking. Twice a second is good enough for us. Active only while a task has the time limit
+    timeoutJobId = core::getScheduler()->addPeriodicJob("Mwc713TaskTimeout", 500, this, [this]() {checkTaskTimeout();}, false);
 }
 
 // Check if task already exist
@@ -117,16 +126,44 @@ bool Mwc713EventManager::hasTask(Mwc713Task * task) {
 
     QMutexLocker l( &taskQMutex );
 
-    bool found = false;
-    for ( const taskInfo & ti : taskQ ) {
-            if (ti.task->getTaskName() == task->getTaskName() && ti.task->getInputStr() == task->getInputStr()) {
-                found = true;
-                break;
-            }
+    // Key collision is possible, so names still need to be checked
+    for ( auto it = taskQIndex.constFind(task->getTaskKey()); it != taskQIndex.constEnd() && it.key() == task->getTaskKey(); ++it ) {
+        const Mwc713Task * t = it.value();
+        if (t->getTaskName() == task->getTaskName() && t->getInputStr() == task->getInputStr())
+            return true;
     }
-    return found;
+    return false;
+}
+
+taskInfo Mwc713EventManager::takeFirstTask() {
+    QMutexLocker l( &taskQMutex );
+    taskInfo ti = taskQ.takeFirst();
+    taskQIndex.remove(ti.task->getTaskKey(), ti.task);
+    return ti;
+}
+
+
+// Check if running task want to get table rows directly
+bool Mwc713EventManager::isTableRowsAccepted() {
+    QMutexLocker l( &taskQMutex );
+
+    if (taskQ.isEmpty() || !taskQ.front().wasStarted)
+        return false;
+
+    return taskQ.front().task->acceptTableRows();
 }
 
+// Deliver table rows to the running task
+void Mwc713EventManager::appendTableRows(const QString & rows) {
+    QMutexLocker l( &taskQMutex );
+
+    if (taskQ.isEmpty() || !taskQ.front().wasStarted || !taskQ.front().task->acceptTableRows()) {
+        Q_ASSERT(false); // Splitter must be in sync with the task queue
+        return;
+    }
+
+    taskQ.front().task->appendTableRows(rows);
+}
 
 // Add task (single wallet action) to perform.
 // tasks  - pairs of task + timeouts. All tasks creates a group that is not divisible buy other tasks.
@@ -152,6 +189,7 @@ void Mwc713EventManager::addTask( TASK_PRIORITY priority, QVector< QPair<Mwc713T
 
             for (int r = tasks.size() - 1; r >= 0; r--) {
                 taskQ.insert(pos, taskInfo(groupId, priority, tasks[r].first, tasks[r].second));
+                taskQIndex.insert(tasks[r].first->getTaskKey(), tasks[r].first);
             }
 
             tasks.clear();
@@ -162,6 +200,7 @@ void Mwc713EventManager::addTask( TASK_PRIORITY priority, QVector< QPair<Mwc713T
             groupId++;
             for (auto & t : tasks) {
                 taskQ.push_back(taskInfo(groupId, priority, t.first, t.second));
+                taskQIndex.insert(t.first->getTaskKey(), t.first);
             }
         }
         // Let's
@@ -174,6 +213,7 @@ void Mwc713EventManager::addTask( TASK_PRIORITY priority, QVector< QPair<Mwc713T
         groupId++;
         for (int r=tasks.size()-1; r>=0; r--) {
             taskQ.insert(idx, taskInfo(groupId, priority, tasks[r].first, tasks[r].second ));
+            taskQIndex.insert(tasks[r].first->getTaskKey(), tasks[r].first);
         }
     }
 
@@ -188,6 +228,9 @@ int Mwc713EventManager::cancelTasksInQueue() {
         return 0;
     }
 
+    for (int i=1; i<taskQ.size(); i++) {
+        taskQIndex.remove(taskQ[i].task->getTaskKey(), taskQ[i].task);
+    }
     taskQ.resize(1);
     return taskQ[0].timeout;
 }
@@ -237,25 +280,31 @@ void Mwc713EventManager::processNextTask() {
             if (!task.task->getInputStr().isEmpty()) {
                 mwc713wallet->executeMwc713command(task.task->getInputStr(), task.task->getShadowStr());
             }
-            taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(task.timeout * config::getTimeoutMultiplier());
+            startTaskTimeout(task.timeout);
         }
         else {
             // execute the task now. Next task will be started
-            executeTask(taskQ.takeFirst());
+            executeTask(takeFirstTask());
         }
     }
 }
 
-void Mwc713EventManager::timerEvent(QTimerEvent *event) {
-    QMutexLocker l( &taskQMutex );
+void Mwc713EventManager::startTaskTimeout(int timeout) {
+    taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(timeout * config::getTimeoutMultiplier());
+    core::getScheduler()->setJobActive(timeoutJobId, true);
+}
 
-    Q_UNUSED(event);
-    if (taskExecutionTimeLimit==0)
-        return;
+void Mwc713EventManager::checkTaskTimeout() {
+    QMutexLocker l( &taskQMutex );
 
     if (taskQ.empty()) {
         // Fine for exiting.
         taskExecutionTimeLimit = 0;
+    }
+
+    if (taskExecutionTimeLimit==0) {
+        // Task is finished, nothing to watch until the next one with the time limit
+        core::getScheduler()->setJobActive(timeoutJobId, false);
         return;
     }
 
@@ -276,7 +325,7 @@ void Mwc713EventManager::timerEvent(QTimerEvent *event) {
 
             // Note, here we might already have another task.
             if (!taskQ.isEmpty())
-                taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(taskQ.front().timeout * config::getTimeoutMultiplier());
+                startTaskTimeout(taskQ.front().timeout);
             return;
         }
 
@@ -293,11 +342,10 @@ void Mwc713EventManager::slReceiveEvent( WALLET_EVENTS event, QString message) {
 
     // Preprocess event with listeners
     {
-        QVector<WEvent> evt;
-        evt.push_back(WEvent(event, message));
+        const WEvent evt(event, message);
 
         for (Mwc713Task *t : listeners) {
-            if (t->processTask(evt)) {
+            if (t->processEvent(evt)) {
                 qDebug() << "Mwc713EventManager::sReceiveEvent was preprocessed. event=" << event << " msg='" << message
                          << "'";
             }
@@ -314,10 +362,10 @@ void Mwc713EventManager::slReceiveEvent( WALLET_EVENTS event, QString message) {
              << message << "'  New size:" << events.size();
 
 
-    if (!taskQ.front().task->getReadyEvents().contains(event))
+    if (!taskQ.front().readyEvents.contains(event))
         return; // still waiting for events
 
-    executeTask(taskQ.takeFirst());
+    executeTask(takeFirstTask());
 }
 
 void Mwc713EventManager::executeTask(taskInfo task) {
@@ -19,6 +19,7 @@
 #include <QVector>
 #include <QObject>
 #include <QMutex>
+#include <QMultiHash>
 
 namespace tries {
     class Mwc713InputParser;
@@ -99,6 +100,37 @@ enum WALLET_EVENTS {
 };
 QString toString(WALLET_EVENTS event);
 
+// Set of WALLET_EVENTS as a bit mask. Event codes must be below 128.
+// Mask can be built at compile time, checking is allocation free.
+// Note: mobile build is C++11, constexpr functions must be a single return statement.
+class WalletEventsMask {
+public:
+    constexpr WalletEventsMask() : low(0), high(0) {}
+    template<typename... Events>
+    constexpr WalletEventsMask(WALLET_EVENTS evt, Events... events) :
+        low(lowBits(evt, events...)), high(highBits(evt, events...)) {}
+
+    constexpr bool contains(WALLET_EVENTS evt) const {
+        return evt<64 ? ((low >> evt) & 1) != 0 : ((high >> (evt-64)) & 1) != 0;
+    }
+
+    constexpr bool isEmpty() const {return low==0 && high==0;}
+private:
+    static constexpr quint64 lowBits() {return 0;}
+    template<typename... Events>
+    static constexpr quint64 lowBits(WALLET_EVENTS evt, Events... events) {
+        return (evt<64 ? quint64(1) << evt : quint64(0)) | lowBits(events...);
+    }
+    static constexpr quint64 highBits() {return 0;}
+    template<typename... Events>
+    static constexpr quint64 highBits(WALLET_EVENTS evt, Events... events) {
+        return (evt<64 ? quint64(0) : quint64(1) << (evt-64)) | highBits(events...);
+    }
+
+    quint64 low;
+    quint64 high;
+};
+
 // Timeout values for the Tasks
 const int TASK_STARTING_TO = 5000;
 const int TASK_UNLOCK_TO = 3000;
@@ -121,9 +153,10 @@ struct taskInfo {
     Mwc713Task* task = nullptr; // task
     bool        wasStarted   = false;
     int         timeout = -1; // timeout for this task
+    WalletEventsMask readyEvents; // task->getReadyEvents(), cached
 
     taskInfo() = default;
-    taskInfo(int _groupId, TASK_PRIORITY _priority, Mwc713Task* _task, int _timeout) : groupId(_groupId), priority(_priority), task(_task), timeout(_timeout) {}
+    taskInfo(int _groupId, TASK_PRIORITY _priority, Mwc713Task* _task, int _timeout);
     taskInfo(const taskInfo&) = default;
     taskInfo & operator=(const taskInfo&) = default;
 };
@@ -155,6 +188,11 @@ public:
 
     const QVector<WEvent> & getEvents() const {return events;}
 
+    // Check if running task want to get table rows directly, see Mwc713Task::acceptTableRows()
+    bool isTableRowsAccepted();
+    // Deliver table rows to the running task
+    void appendTableRows(const QString & rows);
+
     // Cancelling all tasks except the current one. Return timeout valiue that needed to wait
     int cancelTasksInQueue();
 
@@ -164,8 +202,10 @@ public slots:
     void slReceiveEvent( WALLET_EVENTS event, QString message); // message is optional
 
 private:
-    // timer that we are using for timeouts
-    virtual void timerEvent(QTimerEvent *event) override;
+    // timer job that we are using for timeouts
+    void checkTaskTimeout();
+    // Set the time limit for the current task and activate the timer job
+    void startTaskTimeout(int timeout);
 
     // Process next task
     void processNextTask();
@@ -173,6 +213,9 @@ private:
     // Execute this task and start the next one
     void executeTask(taskInfo task);
 
+    // taskQ without first item. Keeping the index in sync
+    taskInfo takeFirstTask();
+
 private:
     // Wallet
     MWC713 * mwc713wallet = nullptr;
@@ -184,12 +227,14 @@ private:
 
     static QMutex taskQMutex; // recursive
     QVector< taskInfo > taskQ; // Owner of the tasks
+    QMultiHash< uint, Mwc713Task* > taskQIndex; // Key: Mwc713Task::getTaskKey(). Used to find duplicated tasks
     int groupId = 0;
 
     // Events for a new task
     QVector<WEvent> events;
 
     volatile qint64 taskExecutionTimeLimit = 0; // Timeout value for the task
+    int timeoutJobId = 0; // Scheduler job that checks taskExecutionTimeLimit
 
     QString lastWalletProgressCommand;
 };
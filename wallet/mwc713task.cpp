@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "mwc713task.h"
+#include <QHash>
 
 namespace wallet {
 
@@ -24,11 +25,16 @@ Mwc713Task::Mwc713Task(QString _taskName, QString _taskProgressName, QString _in
     shadowStr(_shadowStr)
 {
     Q_ASSERT(wallet713);
+    taskKey = qHash(taskName) ^ (qHash(inputStr) * 31);
 }
 
 Mwc713Task::~Mwc713Task() {
 }
 
+bool Mwc713Task::processEvent(const WEvent & event) {
+    return processTask( QVector<WEvent>{event} );
+}
+
 // Filter events by type
 QVector< WEvent > filterEvents(const QVector<WEvent> & events, WALLET_EVENTS type ) {
     QVector< WEvent > res;
@@ -47,10 +53,14 @@ QString printEvents(const QVector<WEvent> & events) {
         if (res.length()>0)
             res += ", ";
 
-        res += "Evt(T=" + toString(e.event) + ", msg=" + e.message + ")";
+        res += printEvent(e);
     }
     return res;
 }
 
+QString printEvent(const WEvent & event) {
+    return "Evt(T=" + toString(event.event) + ", msg=" + event.message + ")";
+}
+
 }
 
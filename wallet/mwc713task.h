@@ -17,7 +17,6 @@
 
 #include <QString>
 #include "mwc713events.h"
-#include <QSet>
 
 namespace wallet {
 
@@ -35,7 +34,10 @@ public:
     const QString & getTaskName() const {return taskName;}
     const QString & getTaskProgressName() const {return taskProgressName;}
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() = 0; // Set of final events that can trigger task execution and completion
+    virtual WalletEventsMask getReadyEvents() const = 0; // Set of final events that can trigger task execution and completion
+
+    // Hash of task name and input. Used to find the same task in the queue.
+    uint getTaskKey() const {return taskKey;}
 
     virtual void onStarted() {}
 
@@ -44,6 +46,16 @@ public:
     // Return true if data was processed. In this case processed evenets will be dropped
     virtual bool processTask(const QVector<WEvent> & events ) = 0;
 
+    // Listeners processing events one by one. Default implementation is calling processTask with a single event.
+    // Listeners override it to process event by reference.
+    virtual bool processEvent(const WEvent & event);
+
+    // Fast path for the big tables like 'txs' and 'outputs'. If task accept table rows, the table body
+    // (lines after the '=====' border) bypass the trie and delivered with appendTableRows instead of S_LINE events.
+    virtual bool acceptTableRows() const {return false;}
+    // rows - table rows separated by '\n'
+    void appendTableRows(const QString & rows) {tableRows.push_back(rows);}
+
     // Check if task require input. Tasks with valid input can be run only
     // from 'ready' state
     bool hasInput() const {return !inputStr.isEmpty();}
@@ -65,6 +77,27 @@ protected:
     MWC713 * wallet713;
     QString inputStr; // string (command) to feed to a wallet
     QString shadowStr; // If defined, will print this string into the logs instead of the task output
+    uint    taskKey = 0;
+    QVector<QString> tableRows; // Table rows from the fast path, see acceptTableRows()
+};
+
+// Base class for the listeners. Listeners are never ready, they get the events one by one as they come.
+class Mwc713Listener : public Mwc713Task
+{
+public:
+    Mwc713Listener(QString taskName, MWC713 * wallet713) :
+            Mwc713Task(taskName, "", "", wallet713, "") {}
+    virtual ~Mwc713Listener() override {}
+
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask();}
+
+    virtual bool processTask(const QVector<WEvent> & events) override {
+        // It is listener, one by one processing only
+        Q_ASSERT(events.size()==1);
+        return processEvent(events[0]);
+    }
+
+    virtual bool processEvent(const WEvent & event) override = 0;
 };
 
 // Some event utils
@@ -74,6 +107,7 @@ QVector< WEvent > filterEvents(const QVector<WEvent> & events, WALLET_EVENTS typ
 
 // Print events into the string
 QString printEvents(const QVector<WEvent> & events);
+QString printEvent(const WEvent & event);
 
 }
 
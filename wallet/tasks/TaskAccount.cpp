@@ -267,6 +267,20 @@ bool TaskAccountListFinal::processTask(const QVector<WEvent> &events) {
     return true;
 }
 
+// ------------------------- TaskDirtyAccountList --------------------------
+
+bool TaskDirtyAccountList::processTask(const QVector<WEvent> &events) {
+    Q_UNUSED(events);
+    wallet713->updateDirtyAccountList();
+    return true;
+}
+
+bool TaskDirtyAccountListFinal::processTask(const QVector<WEvent> &events) {
+    Q_UNUSED(events);
+    wallet713->updateDirtyAccountsFinalize(accounts);
+    return true;
+}
+
 
 }
 
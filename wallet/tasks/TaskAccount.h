@@ -33,7 +33,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 };
 
@@ -50,7 +50,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString newAccountName;
 };
@@ -71,7 +71,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString switchAccountName;
 };
@@ -92,7 +92,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString oldName;
     QString newName;
@@ -112,7 +112,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 };
 
 // Just a callback, not a real task
@@ -123,7 +123,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask();}
 private:
     int pos;
     int total;
@@ -137,7 +137,32 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask();}
+};
+
+// Just a callback, not a real task. Start the balance refresh for the dirty accounts.
+// Only one such task is expected in the queue, dirty accounts are collected until it is executed.
+class TaskDirtyAccountList : public Mwc713Task {
+public:
+    TaskDirtyAccountList( MWC713 * _wallet713 ) :
+            Mwc713Task("TaskDirtyAccountList","", "", _wallet713,"") {}
+
+    virtual bool processTask(const QVector<WEvent> &events) override;
+
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask();}
+};
+
+// Just a callback, not a real task
+class TaskDirtyAccountListFinal : public Mwc713Task {
+public:
+    TaskDirtyAccountListFinal( MWC713 * _wallet713, const QVector<QString> & _accounts ) :
+            Mwc713Task("TaskDirtyAccountListFinal","", "", _wallet713,""), accounts(_accounts) {}
+
+    virtual bool processTask(const QVector<WEvent> &events) override;
+
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask();}
+private:
+    QVector<QString> accounts;
 };
 
 }
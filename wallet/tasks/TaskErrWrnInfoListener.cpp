@@ -19,21 +19,16 @@
 
 namespace wallet {
 
-bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskErrWrnInfoListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
         case S_READY:
             if (!walletIsReady)
-                qDebug() << "TaskErrWrnInfoListener::processTask switch to ready state";
+                qDebug() << "TaskErrWrnInfoListener::processEvent switch to ready state";
             walletIsReady = true;
             return false;
         case S_GENERIC_ERROR: {
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with events: " << printEvent(evt);
                 notify::appendNotificationMessage( bridge::MESSAGE_LEVEL::CRITICAL,
                                                      evt.message);
             }
@@ -41,7 +36,7 @@ bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
         }
         case S_GENERIC_WARNING: {
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with events: " << printEvent(evt);
                 notify::appendNotificationMessage( bridge::MESSAGE_LEVEL::WARNING,
                                                      evt.message);
             }
@@ -49,7 +44,7 @@ bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
         }
         case S_GENERIC_INFO: {
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with events: " << printEvent(evt);
                 notify::appendNotificationMessage( bridge::MESSAGE_LEVEL::INFO,
                                                      evt.message);
             }
@@ -20,19 +20,18 @@
 namespace wallet {
 
 // istener: Listening for all Errors, Warnings and Infos
-class TaskErrWrnInfoListener : public Mwc713Task {
+class TaskErrWrnInfoListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // NA in any case
 
     // Start one listen per request. mwc713 doesn't support both
     TaskErrWrnInfoListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskErrWrnInfoListener", "", "", wallet713,"") {}
+            Mwc713Listener("TaskErrWrnInfoListener", wallet713) {}
 
     virtual ~TaskErrWrnInfoListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
+    virtual bool processEvent(const WEvent & evt) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
 private:
     bool walletIsReady = false;
 };
@@ -22,12 +22,7 @@ namespace wallet {
 
 // ------------------------------- TaskListeningListener ------------------------------------------
 
-bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskListeningListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
         case S_YOUR_MWC_ADDRESS: {
             QString address = evt.message;
@@ -39,7 +34,7 @@ bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
             return true;
         }
         case S_LISTENER_ON: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
 
             QStringList prms = evt.message.split('|');
             if (prms.size() == 0)
@@ -59,7 +54,7 @@ bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
             return true;
         }
         case S_LISTENER_OFF: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
 
             QStringList prms = evt.message.split('|');
             if ( prms.size()==0 ) {
@@ -70,45 +65,45 @@ bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
             return true;
         }
         case S_LISTENER_MQ_LOST_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             QStringList prms = evt.message.split('|');
             wallet713->setMwcMqListeningStatus(false, prms.size()>1 ? prms[1] : "", false );
             return true;
         }
         case S_LISTENER_MQ_GET_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             QStringList prms = evt.message.split('|');
             wallet713->setMwcMqListeningStatus(true, prms.size()>1 ? prms[1] : "", false );
             return true;
         }
         case S_LISTENER_TOR_LOST_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             wallet713->setTorListeningStatus(false);
             return true;
         }
         case S_LISTENER_TOR_GET_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             wallet713->setTorListeningStatus(true);
             return true;
         }
         case S_LISTENER_MQ_COLLISION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             wallet713->notifyListenerMqCollision();
             return true;
         }
         case S_LISTENER_MQ_FAILED_TO_START: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             wallet713->notifyMqFailedToStart();
             return true;
         }
         case S_LISTENER_HTTP_STARTING: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             QString address = evt.message;
             wallet713->setHttpListeningStatus(true, address);
             return true;
         }
         case S_LISTENER_HTTP_FAILED: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with events: " << printEvent(evt);
             QString error = evt.message;
             wallet713->setHttpListeningStatus(false, error);
             return true;
@@ -21,18 +21,16 @@ namespace wallet {
 
 // It is listener task. No input can be defined.
 // Listening for MWC MQ & tor connection statuses
-class TaskListeningListener : public Mwc713Task {
+class TaskListeningListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // NA in any case
 
     TaskListeningListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskListeningListener", "", "", wallet713,"") {}
+            Mwc713Listener("TaskListeningListener", wallet713) {}
 
     virtual ~TaskListeningListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 
@@ -50,7 +48,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString calcCommand(bool startMq, bool startTor) const;
     QString calcProgressStr(bool startMq, bool startTor) const;
@@ -72,7 +70,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString calcCommand(bool stopMq, bool stopTor) const;
     QString calcProgressStr(bool startMq, bool startTor) const;
@@ -35,7 +35,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 private:
     QString calcCommandLine( bool genNext, int idx ) const;
@@ -55,7 +55,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 };
 
 
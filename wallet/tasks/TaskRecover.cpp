@@ -46,15 +46,11 @@ static bool ProcessRecoverTask(const QVector<WEvent> &events,MWC713 *wallet713)
 
 // ----------------------------------- TaskRecoverProgressListener ---------------------------------
 
-bool TaskRecoverProgressListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
+bool TaskRecoverProgressListener::processEvent(const WEvent & evt) {
     if (evt.event != S_RECOVERY_PROGRESS)
         return false;
 
-    qDebug() << "TaskRecoverProgressListener::processTask with events: " << printEvents(events);
+    qDebug() << "TaskRecoverProgressListener::processEvent with events: " << printEvent(evt);
 
     QStringList lst = evt.message.split('|');
     Q_ASSERT(lst.size()==2);
@@ -22,19 +22,17 @@
 namespace wallet {
 
 // It is listener task. No input can be defined
-class TaskRecoverProgressListener : public Mwc713Task {
+class TaskRecoverProgressListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // 5 hours should be enough
 
     // Start one listen per request. mwc713 doesn't support both
     TaskRecoverProgressListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskRecoverProgressListener", "", "", wallet713,"") {}
+            Mwc713Listener("TaskRecoverProgressListener", wallet713) {}
 
     virtual ~TaskRecoverProgressListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual bool processEvent(const WEvent & evt) override;
 
 };
 
@@ -54,7 +52,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 };
 
@@ -77,7 +75,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 };
 
@@ -100,7 +98,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 private:
     bool sleepBeforeStart;
@@ -23,16 +23,11 @@ namespace wallet {
 
 // ---------------- TaskSlatesListener -----------------------
 
-bool TaskSlatesListener::processTask(const QVector<WEvent> & events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskSlatesListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
     case S_SLATE_WAS_RECEIVED_FROM: {
         // We get some moner from somebody!!!
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
+        qDebug() << "TaskSlatesListener::processEvent with events: " << printEvent(evt);
         QStringList prms = evt.message.split('|');
         if (prms.size()>=3) {
             wallet713->reportSlateReceivedFrom( prms[0], util::zeroDbl2Dbl( prms[2] ), prms[1], prms.size()>3 ? prms[3] : "" );
@@ -21,16 +21,14 @@
 namespace wallet {
 
 // Listening for transaction task
-class TaskSlatesListener : public Mwc713Task {
+class TaskSlatesListener : public Mwc713Listener {
 public:
     TaskSlatesListener( MWC713 * wallet713) :
             Mwc713Task("TaskSlatesListener","", "", wallet713, "") {}
 
     virtual ~TaskSlatesListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> & events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 ////////////////////////////////////     set-recv       ///////////////
@@ -48,7 +46,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 };
 
 
@@ -71,7 +69,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     // coinNano == -1  - mean All
     QString buildCommand(int64_t coinNano, const QString & address, const QString & apiSecret, QString message, int inputConfirmationNumber, int changeOutputs, const QStringList & outputs, bool fluff, int ttl_blocks, bool generateProof, const QString & expectedproofAddress) const;
@@ -94,7 +92,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand( int64_t coinNano, QString message, QString fileTx, int inputConfirmationNumber, int changeOutputs, const QStringList & outputs, int ttl_blocks, bool generateProof ) const;
 };
@@ -110,7 +108,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand(QString fileName, QString description, QString identifier) const;
     QString inFileName;
@@ -127,7 +125,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand(QString filename, bool fluff) const;
 };
@@ -148,7 +146,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand( int64_t coinNano, QString message, int inputConfirmationNumber, int changeOutputs,
                           const QStringList & outputs, int ttl_blocks, bool generateProof, QString slatepackRecipientAddress,
@@ -168,7 +166,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand(QString slatepack, QString description) const;
     QString tag;
@@ -186,7 +184,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString buildCommand(QString slatepack, bool fluff) const;
     QString tag;
@@ -206,7 +204,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString url;
 };
@@ -226,7 +224,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString slatepack;
     QString tag;
@@ -28,7 +28,7 @@ namespace wallet {
 
         virtual bool processTask(const QVector<WEvent> & events) override;
 
-        virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_INIT, WALLET_EVENTS::S_READY };}
+        virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_INIT, WALLET_EVENTS::S_READY };}
 
     private:
     };
@@ -25,12 +25,7 @@ namespace wallet {
 
 // ---------------- TaskSwapNewTradeArrive ----------------
 
-bool TaskSwapNewTradeArrive::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size() == 1);
-
-    const WEvent &evt = events[0];
-
+bool TaskSwapNewTradeArrive::processEvent(const WEvent & evt) {
     if (evt.event == S_SWAP_GET_OFFER) {
         QStringList prms = evt.message.split('|');
         if (prms.size() != 2)
@@ -23,18 +23,16 @@ namespace wallet {
 
 // It is listener task. No input can be defined.
 // Listening for a new Trade to arrive
-class TaskSwapNewTradeArrive : public Mwc713Task {
+class TaskSwapNewTradeArrive : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // NA in any case
 
     TaskSwapNewTradeArrive( MWC713 *wallet713 ) :
-            Mwc713Task("TaskSwapNewTradeArrive", "", "", wallet713,"") {}
+            Mwc713Listener("TaskSwapNewTradeArrive", wallet713) {}
 
     virtual ~TaskSwapNewTradeArrive() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 // Get list of the trades
@@ -52,7 +50,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString cookie;
 };
@@ -72,7 +70,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString swapId;
 };
@@ -113,7 +111,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString generateCommandLine(
                                 QVector<QString> outputs, // If defined, those outputs will be used to trade. They might belong to another trade, that if be fine.
@@ -153,7 +151,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString swapId;
 };
@@ -175,7 +173,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString swapId;
     QString cookie;
@@ -201,7 +199,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString generateCommandLine(const QString &swapId,
                                 const QString &destinationMethod, const QString & destinationDest,
@@ -230,7 +228,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString swapId;
 };
@@ -249,7 +247,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString swapId;
 };
@@ -268,7 +266,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 private:
     QString fileName;
 };
@@ -287,7 +285,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 };
 
 
@@ -27,12 +27,7 @@ namespace wallet {
 ////////////////////////////////////////////////////////////////////////////////
 // TaskSwapMktNewMessage
 
-bool TaskSwapMktNewMessage::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size() == 1);
-
-    const WEvent &evt = events[0];
-
+bool TaskSwapMktNewMessage::processEvent(const WEvent & evt) {
     if (evt.event == S_MKT_ACCEPT_OFFER || evt.event == S_MKT_FAIL_BIDDING) {
         QStringList prms = evt.message.split('|');
         if (prms.size() != 2)
@@ -41,7 +41,7 @@ static QVector<int> parseHeadersLine( const QString & str, const QVector<QString
     return res;
 }
 
-static QVector<QString> parseDataLine( const QString & str, const QVector<int> & offsets ) {
+static QVector<QString> parseDataLine( const QStringRef & str, const QVector<int> & offsets ) {
     Q_ASSERT(offsets.size()>0);
 
     QVector<QString> res;
@@ -57,12 +57,27 @@ static QVector<QString> parseDataLine( const QString & str, const QVector<int> &
     return res;
 }
 
-
+// Call func for every row from the fast path, see Mwc713Task::acceptTableRows.
+// func return false to stop.
+template <class F>
+static void forEachTableRow(const QVector<QString> & tableRows, F func) {
+    for (const QString & rows : tableRows) {
+        int pos = 0;
+        while (pos < rows.length()) {
+            int end = rows.indexOf('\n', pos);
+            if (end<0)
+                end = rows.length();
+            if (!func( QStringRef(&rows, pos, end-pos) ))
+                return;
+            pos = end+1;
+        }
+    }
+}
 
 
 // ------------------------------------ TaskOutputs -------------------------------------------
 
-WalletOutput parseOutputLine( QString str, const QVector<int> & outputLayout) {
+static WalletOutput parseOutputLine( const QStringRef & str, const QVector<int> & outputLayout) {
 
     WalletOutput res; // invalid until data is set
 
@@ -105,6 +120,7 @@ WalletOutput parseOutputLine( QString str, const QVector<int> & outputLayout) {
 
 
 static void parseOutputs(const QVector<WEvent> & events, // in
+                              const QVector<QString> & tableRows, // in, rows from the fast path
                               QString & account, // out
                               int64_t & height,  // out
                               QVector<WalletOutput> & outputVector) // out
@@ -155,22 +171,34 @@ static void parseOutputs(const QVector<WEvent> & events, // in
         }
     }
 
-    // Processing transactions
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
+    if (outputLayout.isEmpty())
+        return;
 
-            if (str.startsWith("--------------------"))
-                continue;
+    // Processing outputs
+    auto processRow = [&outputLayout, &outputVector](const QStringRef & str) -> bool {
+        if (str.startsWith("--------------------"))
+            return true;
 
-            if (str.startsWith("=============="))
-                break; // multiple data types case, nned to handle without surprises
+        if (str.startsWith("=============="))
+            return false; // multiple data types case, nned to handle without surprises
 
-            // Expected to be a normal line
-            WalletOutput output = parseOutputLine(str, outputLayout);
-            if ( output.isValid() ) {
-                outputVector.push_back(output);
-            }
+        // Expected to be a normal line
+        WalletOutput output = parseOutputLine(str, outputLayout);
+        if ( output.isValid() ) {
+            outputVector.push_back(output);
+        }
+        return true;
+    };
+
+    if (!tableRows.isEmpty()) {
+        forEachTableRow(tableRows, processRow);
+        return;
+    }
+
+    for ( ; curEvt < events.size(); curEvt++ ) {
+        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
+            if (!processRow( QStringRef(&events[curEvt].message) ))
+                break;
         }
     }
 }
@@ -182,7 +210,7 @@ bool TaskOutputs::processTask(const QVector<WEvent> & events) {
     int64_t  height = -1;
     QVector< WalletOutput > outputResult;
 
-    parseOutputs(events, // in
+    parseOutputs(events, tableRows, // in
            account, height, outputResult); // out
 
     wallet713->setOutputs(account, showSpent, height, outputResult );
@@ -195,7 +223,7 @@ bool TaskOutputsForAccount::processTask(const QVector<WEvent> & events) {
     int64_t  height = -1;
     QVector< WalletOutput > outputResult;
 
-    parseOutputs( events, // in
+    parseOutputs( events, tableRows, // in
                      account, height, outputResult );
 
     wallet713->setWalletOutputs( account, outputResult);
@@ -205,7 +233,7 @@ bool TaskOutputsForAccount::processTask(const QVector<WEvent> & events) {
 
 // ------------------------------------ TaskTransactions -------------------------------------------
 
-static WalletTransaction parseTransactionLine( const QString & str, const QVector<int> & txLayout) {
+static WalletTransaction parseTransactionLine( const QStringRef & str, const QVector<int> & txLayout) {
 
     Q_ASSERT(txLayout.size()==18);
 
@@ -287,6 +315,7 @@ static WalletTransaction parseTransactionLine( const QString & str, const QVecto
 
 // local utility function that parse transactions output
 static void parseTransactions(const QVector<WEvent> & events, // in
+                                    const QVector<QString> & tableRows, // in, rows from the fast path
                                     QString & account, // out
                                     int64_t & height,  // out
                                     QVector<WalletTransaction> & trVector) // out
@@ -341,37 +370,49 @@ static void parseTransactions(const QVector<WEvent> & events, // in
         }
     }
 
+    trVector.clear();
+
+    if (txLayout.isEmpty())
+        return;
+
     QMap<int64_t, WalletTransaction > transactions;
 
     // Processing transactions
     int64_t lastTransId = -1;
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
+    auto processRow = [&txLayout, &transactions, &lastTransId](const QStringRef & str) -> bool {
+        if (str.startsWith("--------------------"))
+            return true;
 
-            if (str.startsWith("--------------------"))
-                continue;
-
-            if (str.startsWith("=============="))
-                break; // multiple data types case, nned to handle without surprises
+        if (str.startsWith("=============="))
+            return false; // multiple data types case, nned to handle without surprises
 
+        // mwc713 has a special line for 'cancelled'
+        if (str.contains("- Cancelled")) {
+            transactions[lastTransId].cancelled();
+            return true;
+        }
 
-            // mwc713 has a special line for 'cancelled'
-            if (str.contains("- Cancelled")) {
-                transactions[lastTransId].cancelled();
-                continue;
-            }
+        // Expected to be a normal line
+        WalletTransaction trans = parseTransactionLine(str, txLayout);
+        if ( trans.isValid() ) {
+            lastTransId = trans.txIdx;
+            transactions[trans.txIdx] = trans;
+        }
+        return true;
+    };
 
-            // Expected to be a normal line
-            WalletTransaction trans = parseTransactionLine(str, txLayout);
-            if ( trans.isValid() ) {
-                lastTransId = trans.txIdx;
-                transactions[trans.txIdx] = trans;
+    if (!tableRows.isEmpty()) {
+        forEachTableRow(tableRows, processRow);
+    }
+    else {
+        for ( ; curEvt < events.size(); curEvt++ ) {
+            if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
+                if (!processRow( QStringRef(&events[curEvt].message) ))
+                    break;
             }
         }
     }
 
-    trVector.clear();
     for ( WalletTransaction & trItem : transactions )
         trVector.push_back( trItem );
 }
@@ -382,7 +423,7 @@ bool TaskTransactions::processTask(const QVector<WEvent> & events) {
     int64_t height = -1;
     QVector<WalletTransaction> trVector;
 
-    parseTransactions(events, // in
+    parseTransactions(events, tableRows, // in
                            account, height, trVector); // out
 
     wallet713->setTransactions( account, height, trVector );
@@ -439,7 +480,7 @@ static void parseMessages(const QVector<WEvent> & events, // in
             if (str.startsWith("=============="))
                 break; // multiple data types case, nned to handle without surprises
 
-            QVector<QString> values = parseDataLine(str, messagesLayout);
+            QVector<QString> values = parseDataLine(QStringRef(&str), messagesLayout);
             if (values.isEmpty())
                 continue;
 
@@ -494,7 +535,7 @@ bool TaskTransactionsById::processTask(const QVector<WEvent> & events) {
     int64_t height = -1;
     QVector<WalletTransaction> trVector;
 
-    parseTransactions(events, // in
+    parseTransactions(events, {}, // in
          account, height, trVector); // out
 
     if ( trVector.size()!=1 ) {
@@ -507,7 +548,7 @@ bool TaskTransactionsById::processTask(const QVector<WEvent> & events) {
 
     // Continue with outputs
     QVector< WalletOutput > outputResult;
-    parseOutputs(events, // in
+    parseOutputs(events, {}, // in
                  account, height, outputResult); // out
 
     QVector<QString> messages;
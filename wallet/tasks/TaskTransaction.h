@@ -31,9 +31,11 @@ public:
 
     virtual ~TaskOutputs() override {}
 
+    virtual bool acceptTableRows() const override {return true;}
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     bool showSpent;
 };
@@ -49,9 +51,11 @@ public:
 
     virtual ~TaskOutputsForAccount() override {}
 
+    virtual bool acceptTableRows() const override {return true;}
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString accountName;
 };
@@ -66,9 +70,11 @@ public:
 
     virtual ~TaskTransactions() override {}
 
+    virtual bool acceptTableRows() const override {return true;}
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 };
 
 class TaskTransactionsById : public Mwc713Task {
@@ -83,7 +89,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString buildCommandLine(QString txIdxOrUUID) const;
 };
@@ -99,7 +105,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     int64_t transactionId;
     QString account;
@@ -118,7 +124,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     int64_t transactionId;
     QString proofFileName;
@@ -135,7 +141,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString proofFileName;
 };
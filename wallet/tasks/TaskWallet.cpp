@@ -343,15 +343,11 @@ Scanning Complete
 
 // ----------------------------------- TaskRecoverProgressListener ---------------------------------
 
-bool TaskSyncProgressListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
+bool TaskSyncProgressListener::processEvent(const WEvent & evt) {
     if (evt.event != S_SYNC_PROGRESS)
         return false;
 
-    qDebug() << "TaskSyncProgressListener::processTask with events: " << printEvents(events) << " TaskSyncShowProgress=" << TaskSyncShowProgress;
+    qDebug() << "TaskSyncProgressListener::processEvent with events: " << printEvent(evt) << " TaskSyncShowProgress=" << TaskSyncShowProgress;
 
     // See Mwc713InputParser::initSyncProgress()  for details
     QStringList lst = evt.message.split('|');
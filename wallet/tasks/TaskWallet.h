@@ -35,8 +35,8 @@ public:
 
     virtual void onStarted() override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {
-        return QSet<WALLET_EVENTS>{WALLET_EVENTS::S_INIT_WANT_ENTER};
+    virtual WalletEventsMask getReadyEvents() const override {
+        return WalletEventsMask{WALLET_EVENTS::S_INIT_WANT_ENTER};
     }
 
 };
@@ -52,8 +52,8 @@ public:
 
     virtual bool processTask(const QVector<WEvent> &events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {
-        return QSet<WALLET_EVENTS>{WALLET_EVENTS::S_READY};
+    virtual WalletEventsMask getReadyEvents() const override {
+        return WalletEventsMask{WALLET_EVENTS::S_READY};
     }
 
 };
@@ -71,7 +71,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_PASSWORD_ERROR, WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_PASSWORD_ERROR, WALLET_EVENTS::S_READY };}
 
 private:
     QString buildWalletRequest(QString password);
@@ -91,7 +91,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_INIT_WANT_ENTER, WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_INIT_WANT_ENTER, WALLET_EVENTS::S_READY };}
 
 };
 
@@ -107,7 +107,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return WalletEventsMask{ WALLET_EVENTS::S_READY };}
 
 };
 
@@ -123,7 +123,7 @@ virtual ~TaskLogout() override {}
 
 virtual bool processTask(const QVector<WEvent> & events) override;
 
-virtual QSet<WALLET_EVENTS> getReadyEvents() override {return {};}
+virtual WalletEventsMask getReadyEvents() const override {return {};}
 };
 
 // Logout from the wallet. Close that app
@@ -138,7 +138,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return {};}
+    virtual WalletEventsMask getReadyEvents() const override {return {};}
 };
 
 
@@ -155,7 +155,7 @@ virtual ~TaskGetNextKey() override {}
 
 virtual bool processTask(const QVector<WEvent> & events) override;
 
-virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString btcaddress;
     QString airDropAccPassword;
@@ -173,7 +173,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 };
 
 // submit file - posts a transaction that has been finalized. Primarily for use with cold storage.
@@ -188,7 +188,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString fileTx;
 };
@@ -207,26 +207,24 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     bool showProgress;
 };
 
 // It is listener task. No input can be defined
 // This test dependent on TaskSync by global variable, see implementation.
-class TaskSyncProgressListener : public Mwc713Task {
+class TaskSyncProgressListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = -1; // NA
 
     // Start one listen per request. mwc713 doesn't support both
     TaskSyncProgressListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskSyncProgressListener", "", "", wallet713,"") {}
+            Mwc713Listener("TaskSyncProgressListener", wallet713) {}
 
     virtual ~TaskSyncProgressListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 
@@ -246,7 +244,7 @@ public:
 
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     QString message;
 };
@@ -265,7 +263,7 @@ public:
     virtual ~TaskRepost() override {}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 private:
     int idx = -1;
 };
@@ -283,7 +281,7 @@ public:
     virtual ~TaskCheckTorConnection() override {}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual WalletEventsMask getReadyEvents() const override {return { WALLET_EVENTS::S_READY };}
 };
 
 
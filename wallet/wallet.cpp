@@ -319,10 +319,10 @@ void WalletTransaction::setData(int64_t _txIdx,
     transactionType = _transactionType;
     txid = _txid;
     address = _address;
-    creationTime = util::mwc713time2ThisTime(_creationTime);
+    creationTime = util::walletTime2Timestamp(_creationTime);
     confirmed = _confirmed;
     height = _height;
-    confirmationTime = util::mwc713time2ThisTime(_confirmationTime);
+    confirmationTime = util::walletTime2Timestamp(_confirmationTime);
     coinNano = _coinNano;
     proof = _proof;
     ttlCutoffHeight = _ttlCutoffHeight;
@@ -336,10 +336,9 @@ void WalletTransaction::setData(int64_t _txIdx,
 
 // return transaction age (time interval from creation moment) in Seconds.
 int64_t WalletTransaction::calculateTransactionAge( const QDateTime & current ) const {
-    // Example: 2019-06-22 05:44:53
-    QDateTime setTime = QDateTime::fromString (creationTime, mwc::DATETIME_TEMPLATE_THIS );
-//    setTime.setOffsetFromUtc(0);
-    return setTime.secsTo(current);
+    if (creationTime==0)
+        return 0;
+    return current.toSecsSinceEpoch() - creationTime;
 }
 
 QString WalletTransaction::toStringCSV(const QStringList & extraData) const {
@@ -361,11 +360,11 @@ QString WalletTransaction::toStringCSV(const QStringList & extraData) const {
                       txTypeStr + separator +                   // Type
                       txid + separator +                        // Shared Transaction Id
                       address + separator +                     // Address
-                      creationTime + separator +                // Creation Time
+                      getCreationTimeStr() + separator +        // Creation Time
                       QString::number(ttlCutoffHeight) + separator + // TTL Cutoff Height
                       (confirmed ? "YES" : "NO") + separator +  // Confirmed?
                       QString::number(height) + separator +     // height
-                      confirmationTime + separator +            // Confirmation Time
+                      getConfirmationTimeStr() + separator +    // Confirmation Time
                       QString::number(numInputs) + separator +  // Num. Inputs
                       QString::number(numOutputs) + separator + // Num. Outputs
                       util::nano2one(tx_credited) + separator +    // Amount Credited
@@ -386,11 +385,11 @@ QString WalletTransaction::toJson() const {
     obj.insert("transactionType", int(transactionType) );
     obj.insert("txid", txid );
     obj.insert("address", address);
-    obj.insert("creationTime", creationTime);
+    obj.insert("creationTime", getCreationTimeStr());
     obj.insert("ttlCutoffHeight", QString::number(ttlCutoffHeight) );
     obj.insert("confirmed", confirmed);
     obj.insert("height", QString::number(height) );
-    obj.insert("confirmationTime", confirmationTime);
+    obj.insert("confirmationTime", getConfirmationTimeStr());
     obj.insert("numInputs", numInputs);
     obj.insert("numOutputs", numOutputs);
     obj.insert("credited", QString::number(credited));
@@ -435,6 +434,22 @@ WalletTransaction WalletTransaction::fromJson(QString str) {
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  WalletOutput
 
+// mwc713 prints empty cells for the missing values
+static int64_t str2number(const QString & str) {
+    bool ok = false;
+    int64_t res = str.toLongLong(&ok);
+    return ok ? res : -1;
+}
+
+static QString number2str(int64_t val) {
+    return val<0 ? QString() : QString::number(val);
+}
+
+// Json values can be strings (our data) or numbers
+static QString jsonValue2str(const QJsonValue & val) {
+    return val.isDouble() ? QString::number(val.toVariant().toLongLong()) : val.toString();
+}
+
 void WalletOutput::setData(QString _outputCommitment,
         QString     _MMRIndex,
         QString     _blockHeight,
@@ -446,30 +461,56 @@ void WalletOutput::setData(QString _outputCommitment,
         int64_t     _txIdx)
 {
     outputCommitment = _outputCommitment;
-    MMRIndex = _MMRIndex;
-    blockHeight = _blockHeight;
-    lockedUntil = _lockedUntil;
-    status = _status;
+    MMRIndex = str2number(_MMRIndex);
+    blockHeight = str2number(_blockHeight);
+    lockedUntil = str2number(_lockedUntil);
+    status = str2status(_status);
+    unknownStatus = status==STATUS::UNKNOWN ? _status : QString();
     coinbase = _coinbase;
-    numOfConfirms = _numOfConfirms;
+    numOfConfirms = int(str2number(_numOfConfirms));
     valueNano = _valueNano;
     txIdx = _txIdx;
 }
 
+QString WalletOutput::getMMRIndexStr() const {return number2str(MMRIndex);}
+QString WalletOutput::getBlockHeightStr() const {return number2str(blockHeight);}
+QString WalletOutput::getLockedUntilStr() const {return number2str(lockedUntil);}
+QString WalletOutput::getNumOfConfirmsStr() const {return number2str(numOfConfirms);}
+
+// Names as mwc713 prints them. UNKNOWN is any other non empty status
+static const QString OUTPUT_STATUS_NAMES[] = {"", "Unconfirmed", "Unspent", "Locked", "Spent", "Reverted", "Unknown"};
+
+//static
+WalletOutput::STATUS WalletOutput::str2status(const QString & status) {
+    if (status.isEmpty())
+        return STATUS::NONE;
+    for (int st = STATUS::UNCONFIRMED; st < STATUS::UNKNOWN; st++) {
+        if (status == OUTPUT_STATUS_NAMES[st])
+            return STATUS(st);
+    }
+    return STATUS::UNKNOWN;
+}
+
+//static
+const QString & WalletOutput::status2str(STATUS status) {
+    Q_ASSERT(status <= STATUS::UNKNOWN);
+    return OUTPUT_STATUS_NAMES[status];
+}
+
 QString WalletOutput::toString() const {
-    return  "Output(" + outputCommitment + ", MMR=" + MMRIndex + ", Height=" + blockHeight + ", Locked=" + lockedUntil + ", status=" +
-            status + ", coinbase=" + (coinbase?"true":"false") + ", confirms=" + numOfConfirms, ", value=" + QString::number(valueNano) + ", txIdx=" + txIdx + ")";
+    return  "Output(" + outputCommitment + ", MMR=" + getMMRIndexStr() + ", Height=" + getBlockHeightStr() + ", Locked=" + getLockedUntilStr() + ", status=" +
+            getStatusStr() + ", coinbase=" + (coinbase?"true":"false") + ", confirms=" + getNumOfConfirmsStr() + ", value=" + QString::number(valueNano) + ", txIdx=" + QString::number(txIdx) + ")";
 }
 
 QString WalletOutput::toJson() const {
     QJsonObject obj;
     obj.insert("outputCommitment", outputCommitment);
-    obj.insert("MMRIndex", MMRIndex);
-    obj.insert("blockHeight", blockHeight);
-    obj.insert("lockedUntil", lockedUntil);
-    obj.insert("status", status);
+    obj.insert("MMRIndex", getMMRIndexStr());
+    obj.insert("blockHeight", getBlockHeightStr());
+    obj.insert("lockedUntil", getLockedUntilStr());
+    obj.insert("status", getStatusStr());
     obj.insert("coinbase", coinbase);
-    obj.insert("numOfConfirms", numOfConfirms);
+    obj.insert("numOfConfirms", getNumOfConfirmsStr());
     obj.insert("valueNano", QString::number(valueNano) );
     obj.insert("txIdx", QString::number(txIdx) );
     obj.insert("weight", weight);
@@ -488,12 +529,12 @@ WalletOutput WalletOutput::fromJson(QString str) {
 
     WalletOutput res;
     res.setData(obj.value("outputCommitment").toString(),
-                obj.value("MMRIndex").toString(),
-                obj.value("blockHeight").toString(),
-                obj.value("lockedUntil").toString(),
+                jsonValue2str(obj.value("MMRIndex")),
+                jsonValue2str(obj.value("blockHeight")),
+                jsonValue2str(obj.value("lockedUntil")),
                 obj.value("status").toString(),
                 obj.value("coinbase").toBool(),
-                obj.value("numOfConfirms").toString(),
+                jsonValue2str(obj.value("numOfConfirms")),
                 obj.value("valueNano").toString().toLongLong(),
                 obj.value("txIdx").toString().toLongLong());
     return res;
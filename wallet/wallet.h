@@ -167,18 +167,23 @@ public:
     QString toString() const;
 };
 
+// Wallet can have many outputs. Data is converted from the mwc713 text at setData, so only the commitment (and a rare
+// unknown status) takes the heap. Numeric values are -1 if mwc713 didn't provide them.
 struct WalletOutput {
+    // UNKNOWN - status that this wallet doesn't know about, the original string is kept at unknownStatus
+    enum STATUS : quint8 { NONE=0, UNCONFIRMED=1, UNSPENT=2, LOCKED=3, SPENT=4, REVERTED=5, UNKNOWN=6 };
 
     QString    outputCommitment;
-    QString    MMRIndex;
-    QString    blockHeight;
-    QString    lockedUntil;
-    QString    status;
-    bool       coinbase = false;
-    QString    numOfConfirms;
+    int64_t    MMRIndex = -1;
+    int64_t    blockHeight = -1;
+    int64_t    lockedUntil = -1;
     int64_t    valueNano = 0L;
-    int64_t    txIdx;
+    int64_t    txIdx = -1;
     double     weight = 0.0; // HODL weight, used for ouptus optimization
+    int        numOfConfirms = -1;
+    STATUS     status = STATUS::NONE;
+    bool       coinbase = false;
+    QString    unknownStatus; // empty unless status is UNKNOWN
 
     void setData(QString outputCommitment,
             QString     MMRIndex,
@@ -210,12 +215,23 @@ struct WalletOutput {
     QString toString() const;
 
     bool isValid() const {
-        return !(outputCommitment.isEmpty() || status.isEmpty());
+        return !(outputCommitment.isEmpty() || status==STATUS::NONE);
     }
 
     double getWeightedValue() const {return weight*valueNano; }
 
-    bool isUnspent() const {return status == "Unspent";}
+    bool isUnspent() const {return status == STATUS::UNSPENT;}
+
+    // Values as mwc713 printed them. Empty string for the missing values
+    const QString & getStatusStr() const {return status==STATUS::UNKNOWN ? unknownStatus : status2str(status);}
+    QString getMMRIndexStr() const;
+    QString getBlockHeightStr() const;
+    QString getLockedUntilStr() const;
+    QString getNumOfConfirmsStr() const;
+
+    // Status strings are interned, there are only few of them
+    static STATUS str2status(const QString & status);
+    static const QString & status2str(STATUS status);
 
     QString toJson() const;
     static WalletOutput fromJson(QString str);
@@ -228,11 +244,11 @@ struct WalletTransaction {
     uint    transactionType = TRANSACTION_TYPE::NONE;
     QString txid; // Full tx UUID
     QString address;
-    QString creationTime;
+    int64_t creationTime = 0; // seconds since epoch, 0 - unknown. Use getCreationTimeStr for the wallet time string
     int64_t ttlCutoffHeight = -1;
     bool    confirmed = false;
     int64_t height = 0;
-    QString confirmationTime;
+    int64_t confirmationTime = 0; // seconds since epoch, 0 - not confirmed or unknown
     int     numInputs = -1;
     int     numOutputs = -1;
     int64_t credited = -1;
@@ -269,6 +285,10 @@ struct WalletTransaction {
 
     bool isCoinbase() const { return transactionType==TRANSACTION_TYPE::COIN_BASE; }
 
+    // Time in wallet format (mwc::DATETIME_TEMPLATE_THIS), empty if it is unknown
+    QString getCreationTimeStr() const {return util::timestamp2ThisTime(creationTime);}
+    QString getConfirmationTimeStr() const {return util::timestamp2ThisTime(confirmationTime);}
+
     // return transaction age (time interval from creation moment) in Seconds.
     int64_t calculateTransactionAge( const QDateTime & current ) const;
 
@@ -302,7 +322,7 @@ struct WalletTransaction {
         return expandStrR( QString::number(txIdx), 3) +
                 expandStrR(nano2one(coinNano), 8) +
                 expandStrR( string2shortStrR(txid, 12), 12) +
-                " " + creationTime;
+                " " + getCreationTimeStr();
     }
 
     static QString getCSVHeaders(const QStringList & extraHeaders) {
@@ -716,12 +736,14 @@ public:
 
 
     // Show outputs for the wallet
+    // fromCache - respond with the data from the previous request first (if it is still valid), then refresh it.
     // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-    virtual void getOutputs(QString account, bool show_spent, bool enforceSync)  = 0;
+    virtual void getOutputs(QString account, bool show_spent, bool enforceSync, bool fromCache)  = 0;
 
     // Show all transactions for current account
+    // fromCache - respond with the data from the previous request first (if it is still valid), then refresh it.
     // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-    virtual void getTransactions(QString account, bool enforceSync)  = 0;
+    virtual void getTransactions(QString account, bool enforceSync, bool fromCache)  = 0;
 
     // get Extended info for specific transaction
     // Check Signal: onTransactionById( bool success, QString account, int64_t height, WalletTransaction transaction, QVector<WalletOutput> outputs, QVector<QString> messages )
@@ -0,0 +1,102 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "walletdatacache.h"
+
+namespace wallet {
+
+void WalletDataCache::setWallet(const QString & _walletId) {
+    if (walletId == _walletId)
+        return;
+
+    walletId = _walletId;
+    accounts.clear();
+}
+
+// Any transaction change the amounts. Height is not included because transactions doesn't depend on it.
+QString WalletDataCache::calcBalanceState(const AccountInfo & balance) {
+    return QString::number(balance.total) + "|" + QString::number(balance.awaitingConfirmation) + "|" +
+           QString::number(balance.lockedByPrevTransaction) + "|" + QString::number(balance.currentlySpendable);
+}
+
+bool WalletDataCache::getTransactions(const QString & account, const AccountInfo & balance,
+                                      int64_t & height, QVector<WalletTransaction> & transactions) {
+    if (walletId.isEmpty())
+        return false;
+
+    AccountData & data = getAccount(account);
+    if (data.txBalanceState.isEmpty() || data.txBalanceState != calcBalanceState(balance))
+        return false;
+
+    height = data.txHeight;
+    transactions = data.transactions.values().toVector();
+    return true;
+}
+
+bool WalletDataCache::getOutputs(const QString & account, bool showSpent, const AccountInfo & balance,
+                                 int64_t & height, QVector<WalletOutput> & outputs) {
+    if (walletId.isEmpty())
+        return false;
+
+    const CachedOutputs & cached = getAccount(account).outputs[showSpent ? 1 : 0];
+    // Outputs has number of confirmations, so the height must match as well
+    if (cached.balanceState.isEmpty() || cached.height != balance.height ||
+            cached.balanceState != calcBalanceState(balance))
+        return false;
+
+    height = cached.height;
+    outputs = cached.outputs;
+    return true;
+}
+
+QVector<WalletTransaction> WalletDataCache::updateTransactions(const QString & account, const AccountInfo & balance,
+                                                               int64_t height, const QVector<WalletTransaction> & transactions) {
+    if (walletId.isEmpty())
+        return transactions;
+
+    AccountData & data = getAccount(account);
+    data.transactions.clear();
+    for (const auto & tx : transactions)
+        data.transactions.insert(tx.txIdx, tx);
+
+    data.txHeight = height;
+    data.txBalanceState = calcBalanceState(balance);
+
+    return data.transactions.values().toVector();
+}
+
+void WalletDataCache::updateOutputs(const QString & account, bool showSpent, const AccountInfo & balance,
+                                    int64_t height, const QVector<WalletOutput> & outputs) {
+    if (walletId.isEmpty())
+        return;
+
+    CachedOutputs & cached = getAccount(account).outputs[showSpent ? 1 : 0];
+    cached.outputs = outputs;
+    cached.height = height;
+    cached.balanceState = calcBalanceState(balance);
+}
+
+void WalletDataCache::invalidate() {
+    for (auto & data : accounts) {
+        data.txBalanceState = "";
+        data.outputs[0].balanceState = "";
+        data.outputs[1].balanceState = "";
+    }
+}
+
+void WalletDataCache::clear() {
+    accounts.clear();
+}
+
+}
@@ -0,0 +1,82 @@
+// Copyright 2021 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_WALLETDATACACHE_H
+#define MWC_QT_WALLET_WALLETDATACACHE_H
+
+#include "wallet.h"
+#include <QMap>
+#include <QHash>
+
+namespace wallet {
+
+// Local copy of the transactions and outputs, per wallet and account.
+// Cached data is valid while the account balance state (height, amounts) is the same as it was at the moment
+// when data was retrieved. So the transactions/outputs pages can be shown while mwc713 is listing
+// the fresh data. Data is kept in memory only, wallet data must not be stored unencrypted at the disk.
+class WalletDataCache {
+public:
+    WalletDataCache() {}
+    ~WalletDataCache() {}
+
+    // walletId - wallet data path. Switching the wallet drop the data from the memory.
+    void setWallet(const QString & walletId);
+
+    // Return true and the data if cache is valid for this balance state
+    bool getTransactions(const QString & account, const AccountInfo & balance,
+                         int64_t & height, QVector<WalletTransaction> & transactions);
+    bool getOutputs(const QString & account, bool showSpent, const AccountInfo & balance,
+                    int64_t & height, QVector<WalletOutput> & outputs);
+
+    // Store the data from mwc713.
+    // balance - account state before the data was requested.
+    // Return the stored data (the same content as the input, in the cache order).
+    QVector<WalletTransaction> updateTransactions(const QString & account, const AccountInfo & balance,
+                                                  int64_t height, const QVector<WalletTransaction> & transactions);
+    void updateOutputs(const QString & account, bool showSpent, const AccountInfo & balance,
+                       int64_t height, const QVector<WalletOutput> & outputs);
+
+    // Something happens with the wallet, data need to be requested from mwc713.
+    void invalidate();
+
+    // Full rescan was done, drop everything for the current wallet.
+    void clear();
+
+private:
+    struct CachedOutputs {
+        int64_t height = -1;
+        QString balanceState; // empty - not valid
+        QVector<WalletOutput> outputs;
+    };
+
+    struct AccountData {
+        int64_t txHeight = -1;
+        QString txBalanceState; // empty - not valid
+        QMap<int64_t, WalletTransaction> transactions; // key: txIdx
+
+        CachedOutputs outputs[2]; // index: showSpent
+    };
+
+    static QString calcBalanceState(const AccountInfo & balance);
+
+    AccountData & getAccount(const QString & account) {return accounts[account];}
+
+private:
+    QString walletId;
+    QHash<QString, AccountData> accounts;
+};
+
+}
+
+#endif //MWC_QT_WALLET_WALLETDATACACHE_H
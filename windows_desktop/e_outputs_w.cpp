@@ -30,18 +30,6 @@ bool Outputs::lockMessageWasShown = false;
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void OutputData::setBtns(control::RichItem * _ritem,
-                         QWidget * _markWnd,
-                         control::RichButton * _lockBtn,
-                         QLabel * _lockLabel,
-                         QLabel * _comment) {
-    ritem = _ritem;
-    markWnd = _markWnd;
-    lockBtn = _lockBtn;
-    lockLabel = _lockLabel;
-    comment = _comment;
-}
-
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Outputs::Outputs(QWidget *parent) :
@@ -53,16 +41,20 @@ Outputs::Outputs(QWidget *parent) :
     wallet = new bridge::Wallet(this);
     outputs = new bridge::Outputs(this);
 
-    QObject::connect( wallet, &bridge::Wallet::sgnOutputs,
-                      this, &Outputs::onSgnOutputs, Qt::QueuedConnection);
+    QObject::connect( wallet, &bridge::Wallet::sgnOutputList,
+                      this, &Outputs::onSgnOutputList, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnWalletBalanceUpdated,
                       this, &Outputs::onSgnWalletBalanceUpdated, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnNewNotificationMessage,
                       this, &Outputs::onSgnNewNotificationMessage, Qt::QueuedConnection);
 
-    QObject::connect(ui->outputsTable, &control::RichVBox::onItemActivated,
+    QObject::connect(ui->outputsTable, &control::RichListView::onItemActivated,
                      this, &Outputs::onItemActivated, Qt::QueuedConnection);
 
+    // Newest outputs first
+    ui->outputsTable->setItemFactory(this);
+    ui->outputsTable->setSortOrder(Qt::DescendingOrder);
+
     ui->progress->initLoader(true);
     ui->progressFrame->hide();
 
@@ -71,7 +63,7 @@ Outputs::Outputs(QWidget *parent) :
 
     QString accName = updateAccountsData();
 
-    requestOutputs(accName, false);
+    requestOutputs(accName, false, true);
 }
 
 void Outputs::panelWndStarted() {
@@ -85,136 +77,135 @@ Outputs::~Outputs() {
 
 bool Outputs::calcMarkFlag(const wallet::WalletOutput & out) {
     QString lockState = calcLockedState(out);
-    return out.status == "Unconfirmed" || out.status == "Locked" || lockState == "YES";
+    return out.status == wallet::WalletOutput::STATUS::UNCONFIRMED || out.status == wallet::WalletOutput::STATUS::LOCKED || lockState == "YES";
 }
 
 void Outputs::updateShownData(bool resetScrollData) {
-    ui->outputsTable->clearAll(resetScrollData);
-
-    int total = allData.size();
-
-    qDebug() << "updating output table for " << total << " outputs";
-    // Printing first 200 outputs. For normal usage 200 is enough. The re
-    for (int i = allData.size()-1; i >= std::max(0, allData.size()-5000); i--) {
-        auto &out = allData[i].output;
-
-        // Data filtering was done on outputs request level. No need to filter out anything
-
-        // return "N/A, Yes, "No"
-        QString lockState = calcLockedState(out);
-        bool mark = calcMarkFlag(out);
-
-        control::RichItem * itm = control::createMarkedItem(QString::number(i), ui->outputsTable, mark, "" );
-
-        QWidget * markWnd = (QWidget *) itm->getCurrentWidget();
-
-        // First row with Info about the commit
-        {
-            itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
-            // Adding Icon and a text
-            if (out.status == "Unconfirmed") {
-                itm->addWidget(control::createIcon(itm, ":/img/iconUnconfirmed@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
-            } else if (out.status == "Unspent") {
-                if (out.coinbase)
-                    itm->addWidget(control::createIcon(itm, ":/img/iconCoinbase@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
-                else
-                    itm->addWidget(control::createIcon(itm, ":/img/iconReceived@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
-            } else if (out.status == "Locked") {
-                itm->addWidget( control::createIcon(itm, ":/img/iconLock@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
-            } else if (out.status == "Spent") {
-                itm->addWidget( control::createIcon(itm, ":/img/iconSent@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
-            } else {
-                Q_ASSERT(false);
-            }
+    qDebug() << "updating output table for " << allData.size() << " outputs";
+    // Items are built by the list for the visible rows only, see createRichItem
+    ui->outputsTable->setRowCount(allData.size(), resetScrollData);
+}
 
-            itm->addWidget(control::createLabel(itm, false, false, out.status));
-            itm->addHSpacer();
+control::RichItem * Outputs::createRichItem(int i, QWidget * parent) {
+    Q_ASSERT(i>=0 && i<allData.size());
+    const wallet::WalletOutput & out = allData[i].output;
 
-            bool hok = false;
-            int height = out.blockHeight.toInt(&hok);
-            bool lok = false;
-            int lockH = out.lockedUntil.toInt(&lok);
+    // Spent outputs filtering was done on outputs request level
 
-            if (hok) {
-                itm->addWidget(control::createLabel(itm, false, true, "Block: " + out.blockHeight));
-            }
-            if (lok && hok && lockH > height) {
-                itm->addFixedHSpacer(control::LEFT_MARK_SPACING).addWidget(
-                        control::createLabel(itm, false, true, "Lock Height: " + out.lockedUntil));
-            }
-            itm->pop();
-        } // First line
+    // return "N/A, Yes, "No"
+    QString lockState = calcLockedState(out);
+    bool mark = calcMarkFlag(out);
+
+    control::RichItem * itm = control::createMarkedItem(QString::number(i), parent, mark, "" );
+
+    // First row with Info about the commit
+    {
+        itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
+        // Adding Icon and a text
+        if (out.status == wallet::WalletOutput::STATUS::UNCONFIRMED) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconUnconfirmed@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
+        } else if (out.status == wallet::WalletOutput::STATUS::UNSPENT) {
+            if (out.coinbase)
+                itm->addWidget(control::createIcon(itm, ":/img/iconCoinbase@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
+            else
+                itm->addWidget(control::createIcon(itm, ":/img/iconReceived@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
+        } else if (out.status == wallet::WalletOutput::STATUS::LOCKED) {
+            itm->addWidget( control::createIcon(itm, ":/img/iconLock@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
+        } else if (out.status == wallet::WalletOutput::STATUS::SPENT) {
+            itm->addWidget( control::createIcon(itm, ":/img/iconSent@2x.svg", control::ROW_HEIGHT, control::ROW_HEIGHT));
+        } else {
+            Q_ASSERT(false);
+        }
 
-        itm->addWidget( control::createHorzLine(itm) );
+        itm->addWidget(control::createLabel(itm, false, false, out.getStatusStr()));
+        itm->addHSpacer();
 
-        QLabel * lockL = nullptr;
-        control::RichButton * lockBtn = nullptr;
+        if (out.blockHeight >= 0) {
+            itm->addWidget(control::createLabel(itm, false, true, "Block: " + out.getBlockHeightStr()));
+        }
+        if (out.lockedUntil >= 0 && out.blockHeight >= 0 && out.lockedUntil > out.blockHeight) {
+            itm->addFixedHSpacer(control::LEFT_MARK_SPACING).addWidget(
+                    control::createLabel(itm, false, true, "Lock Height: " + out.getLockedUntilStr()));
+        }
+        itm->pop();
+    } // First line
 
-        { // Line with amount
-            itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
+    itm->addWidget( control::createHorzLine(itm) );
 
-            itm->addWidget(control::createIcon(itm, ":/img/iconLock@2x", control::ROW_HEIGHT, control::ROW_HEIGHT));
-            lockL = (QLabel*)itm->getCurrentWidget();
+    QLabel * lockL = nullptr;
+    control::RichButton * lockBtn = nullptr;
 
-            if (lockState != "YES") {
-                lockL->hide();
-            }
+    { // Line with amount
+        itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
 
-            itm->addWidget( control::createLabel(itm, false, false, util::nano2one(out.valueNano) + " MWC", control::FONT_LARGE));
-            itm->addHSpacer();
+        itm->addWidget(control::createIcon(itm, ":/img/iconLock@2x", control::ROW_HEIGHT, control::ROW_HEIGHT));
+        lockL = (QLabel*)itm->getCurrentWidget();
 
-            if (config->isLockOutputEnabled()) {
-                // Add lock button if it is applicable
-                if ( lockState == "YES" ) {
-                    itm->addWidget(new control::RichButton(itm, "Unlock", 60, control::ROW_HEIGHT, "Unlock this output and make it spendable"));
-                    lockBtn = (control::RichButton*) itm->getCurrentWidget();
-                }
-                else if (lockState == "NO") {
-                    itm->addWidget(new control::RichButton(itm, "Lock", 60, control::ROW_HEIGHT, "Lock this output and make it non spendable"));
-                    lockBtn = (control::RichButton*) itm->getCurrentWidget();
-                }
+        if (lockState != "YES") {
+            lockL->hide();
+        }
 
-                if (lockBtn) {
-                    lockBtn->setCallback(this, QString::number(i) );
-                    itm->addFixedHSpacer(control::ROW_HEIGHT);
-                }
-            }
+        itm->addWidget( control::createLabel(itm, false, false, util::nano2one(out.valueNano) + " MWC", control::FONT_LARGE));
+        itm->addHSpacer();
 
-            itm->addWidget( control::createLabel(itm, false, true, "Conf: " + out.numOfConfirms));
+        if (config->isLockOutputEnabled()) {
+            // Add lock button if it is applicable
+            if ( lockState == "YES" ) {
+                itm->addWidget(new control::RichButton(itm, "Unlock", 60, control::ROW_HEIGHT, "Unlock this output and make it spendable"));
+                lockBtn = (control::RichButton*) itm->getCurrentWidget();
+            }
+            else if (lockState == "NO") {
+                itm->addWidget(new control::RichButton(itm, "Lock", 60, control::ROW_HEIGHT, "Lock this output and make it non spendable"));
+                lockBtn = (control::RichButton*) itm->getCurrentWidget();
+            }
 
-            itm->pop();
+            if (lockBtn) {
+                lockBtn->setCallback(this, QString::number(i) );
+                itm->addFixedHSpacer(control::ROW_HEIGHT);
+            }
         }
 
-        // line with commit
-        {
-            itm->hbox().setContentsMargins(0, 0, 0, 0);
-            itm->addWidget(control::createLabel(itm, false, true, out.outputCommitment, control::FONT_SMALL));
-            itm->addHSpacer();
-            itm->pop();
-        }
+        itm->addWidget( control::createLabel(itm, false, true, "Conf: " + out.getNumOfConfirmsStr()));
 
-        // And the last optional line is comment
-        QLabel *noteL = nullptr;
-        {
-            QString outputNote = config->getOutputNote(out.outputCommitment);
-            itm->hbox().setContentsMargins(0, 0, 0, 0);
-            itm->addWidget(control::createLabel(itm, true, false, outputNote));
-            noteL = (QLabel *) itm->getCurrentWidget();
-            //itm->addHSpacer();
-            itm->pop();
-
-            if (outputNote.isEmpty())
-                noteL->hide();
-        }
-        Q_ASSERT(noteL);
+        itm->pop();
+    }
 
-        itm->apply();
+    // line with commit
+    {
+        itm->hbox().setContentsMargins(0, 0, 0, 0);
+        itm->addWidget(control::createLabel(itm, false, true, out.outputCommitment, control::FONT_SMALL));
+        itm->addHSpacer();
+        itm->pop();
+    }
 
-        allData[i].setBtns(itm, markWnd, lockBtn, lockL, noteL);
-        ui->outputsTable->addItem(itm);
+    // And the last optional line is comment
+    QLabel *noteL = nullptr;
+    {
+        QString outputNote = config->getOutputNote(out.outputCommitment);
+        itm->hbox().setContentsMargins(0, 0, 0, 0);
+        itm->addWidget(control::createLabel(itm, true, false, outputNote));
+        noteL = (QLabel *) itm->getCurrentWidget();
+        //itm->addHSpacer();
+        itm->pop();
+
+        if (outputNote.isEmpty())
+            noteL->hide();
     }
+    Q_ASSERT(noteL);
 
-    ui->outputsTable->apply();
+    itm->apply();
+    return itm;
+}
+
+QString Outputs::getRichItemFilterText(int i) {
+    Q_ASSERT(i>=0 && i<allData.size());
+    const wallet::WalletOutput & out = allData[i].output;
+    return out.getStatusStr() + " " + util::nano2one(out.valueNano) + " " + out.outputCommitment + " " +
+            config->getOutputNote(out.outputCommitment);
+}
+
+void Outputs::on_searchEdit_textChanged(const QString & text) {
+    ui->outputsTable->setFilterText(text.trimmed());
 }
 
 void Outputs::richButtonPressed(control::RichButton * button, QString coockie) {
@@ -237,26 +228,10 @@ bool Outputs::updateOutputState(int idx, bool lock) {
     if ( idx>=0 && idx<allData.size() && showLockMessage() ) {
 
         wallet::WalletOutput & selected = allData[idx].output;
-        QLabel * lockL = allData[idx].lockLabel;
-        control::RichButton * lockBtn = allData[idx].lockBtn;
-
         config->setLockedOutput(lock, selected.outputCommitment);
-        if (lock) {
-            if (lockBtn)
-                lockBtn->setText("Unlock");
-            if (lockL)
-                lockL->show();
-        }
-        else {
-            if (lockBtn)
-                lockBtn->setText("Lock");
-            if (lockL)
-                lockL->hide();
-        }
-
-        bool mark = calcMarkFlag(selected);
-        allData[idx].markWnd->setStyleSheet( mark ? control::LEFT_MARK_ON("") : control::LEFT_MARK_OFF );
 
+        // Lock button, lock icon and the mark are built from the current state
+        ui->outputsTable->refreshRow(idx);
         return true;
     }
     return false;
@@ -266,7 +241,7 @@ QString Outputs::currentSelectedAccount() {
     return ui->accountComboBox->currentData().toString();
 }
 
-void Outputs::onSgnOutputs( QString account, bool showSpent, QString height, QVector<QString> outputs) {
+void Outputs::onSgnOutputList( QString account, bool showSpent, QString height, QVector<wallet::WalletOutput> outputs) {
     Q_UNUSED(height);
 
     if (account != currentSelectedAccount() || showSpent != config->isShowOutputAll() )
@@ -276,10 +251,11 @@ void Outputs::onSgnOutputs( QString account, bool showSpent, QString height, QVe
     ui->tableFrame->show();
 
     allData.clear();
+    allData.reserve(outputs.size());
 
-    for (const QString & s : outputs) {
+    for (const wallet::WalletOutput & o : outputs) {
         OutputData out;
-        out.output = wallet::WalletOutput::fromJson(s);
+        out.output = o;
         allData.push_back( out );
     }
 
@@ -287,11 +263,11 @@ void Outputs::onSgnOutputs( QString account, bool showSpent, QString height, QVe
 }
 
 void Outputs::on_refreshButton_clicked() {
-    requestOutputs(currentSelectedAccount(), false);
+    requestOutputs(currentSelectedAccount(), false, false);
 }
 
 // Request and reset page counter
-void Outputs::requestOutputs(QString account, bool resetScrollPos) {
+void Outputs::requestOutputs(QString account, bool resetScrollPos, bool fromCache) {
     allData.clear();
 
     ui->progressFrame->show();
@@ -299,7 +275,7 @@ void Outputs::requestOutputs(QString account, bool resetScrollPos) {
 
     updateShownData(resetScrollPos);
 
-    wallet->requestOutputs(account, config->isShowOutputAll(), true);
+    wallet->requestOutputs(account, config->isShowOutputAll(), true, fromCache);
 }
 
 void Outputs::on_accountComboBox_activated(int index) {
@@ -308,7 +284,7 @@ void Outputs::on_accountComboBox_activated(int index) {
     QString selectedAccount = currentSelectedAccount();
     if (!selectedAccount.isEmpty()) {
         wallet->switchAccount(selectedAccount);
-        requestOutputs(selectedAccount, true);
+        requestOutputs(selectedAccount, true, false);
     }
 }
 
@@ -412,14 +388,12 @@ void Outputs::onItemActivated(QString itemId) {
             if (resNote != outputNote ) {
                 if (resNote.isEmpty()) {
                     config->deleteOutputNote( out.outputCommitment );
-                    allData[idx].comment->hide();
                 }
                 else {
                     // add new note or update existing note for this commitment
                     config->updateOutputNote(out.outputCommitment, resNote);
-                    allData[idx].comment->setText(resNote);
-                    allData[idx].comment->show();
                 }
+                ui->outputsTable->refreshRow(idx);
             }
         }
     }
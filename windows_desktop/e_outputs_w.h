@@ -18,6 +18,7 @@
 #include "../core_desktop/navwnd.h"
 #include "../wallet/wallet.h"
 #include "../control_desktop/richbutton.h"
+#include "../control_desktop/richlistview.h"
 
 class QLabel;
 
@@ -39,16 +40,9 @@ namespace wnd {
 
 struct OutputData {
     wallet::WalletOutput output;
-    control::RichItem * ritem = nullptr;
-    QWidget * markWnd = nullptr;
-    control::RichButton * lockBtn = nullptr;
-    QLabel * lockLabel = nullptr;
-    QLabel * comment = nullptr;
-
-    void setBtns(control::RichItem * ritem, QWidget * markWnd, control::RichButton * lockBtn, QLabel * lockLabel, QLabel * comment);
 };
 
-class Outputs : public core::NavWnd,  control::RichButtonPressCallback
+class Outputs : public core::NavWnd,  control::RichButtonPressCallback, control::RichListItemFactory
 {
     Q_OBJECT
 
@@ -60,9 +54,10 @@ private slots:
     void on_accountComboBox_activated(int index);
     void on_refreshButton_clicked();
     void on_showUnspent_clicked();
+    void on_searchEdit_textChanged(const QString & text);
 
     void onSgnWalletBalanceUpdated();
-    void onSgnOutputs( QString account, bool showSpent, QString height, QVector<QString> outputs);
+    void onSgnOutputList( QString account, bool showSpent, QString height, QVector<wallet::WalletOutput> outputs);
 
     void onSgnNewNotificationMessage(int level, QString message);
 
@@ -71,6 +66,10 @@ private slots:
 protected:
     virtual void richButtonPressed(control::RichButton * button, QString coockie) override;
 
+    // Items for the outputsTable, row is allData index
+    virtual control::RichItem * createRichItem(int row, QWidget * parent) override;
+    virtual QString getRichItemFilterText(int row) override;
+
 private:
     virtual void panelWndStarted() override;
 
@@ -78,7 +77,8 @@ private:
 
     bool updateOutputState(int idx, bool lock);
 
-    void requestOutputs(QString account, bool resetScrollPos);
+    // fromCache - show the cached outputs until the fresh ones come
+    void requestOutputs(QString account, bool resetScrollPos, bool fromCache);
 
     QString currentSelectedAccount();
 
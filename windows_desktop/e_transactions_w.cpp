@@ -31,18 +31,6 @@
 
 namespace wnd {
 
-void TransactionData::setBtns(control::RichItem * _ritem, control::RichButton * _cancelBtn,
-             control::RichButton * _repostBtn, control::RichButton * _proofBtn,
-             QLabel * _noteL) {
-    ritem = _ritem;
-    cancelBtn = _cancelBtn;
-    repostBtn = _repostBtn;
-    proofBtn = _proofBtn;
-    noteL = _noteL;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 Transactions::Transactions(QWidget *parent) :
     core::NavWnd(parent),
     ui(new Ui::Transactions)
@@ -56,8 +44,8 @@ Transactions::Transactions(QWidget *parent) :
 
     QObject::connect( wallet, &bridge::Wallet::sgnWalletBalanceUpdated,
                       this, &Transactions::onSgnWalletBalanceUpdated, Qt::QueuedConnection);
-    QObject::connect( wallet, &bridge::Wallet::sgnTransactions,
-                      this, &Transactions::onSgnTransactions, Qt::QueuedConnection);
+    QObject::connect( wallet, &bridge::Wallet::sgnTransactionList,
+                      this, &Transactions::onSgnTransactionList, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnCancelTransacton,
                       this, &Transactions::onSgnCancelTransacton, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnTransactionById,
@@ -73,14 +61,18 @@ Transactions::Transactions(QWidget *parent) :
     QObject::connect( wallet, &bridge::Wallet::sgnRepost,
                       this, &Transactions::onSgnRepost, Qt::QueuedConnection);
 
-    QObject::connect(ui->transactionTable, &control::RichVBox::onItemActivated,
+    QObject::connect(ui->transactionTable, &control::RichListView::onItemActivated,
                      this, &Transactions::onItemActivated, Qt::QueuedConnection);
 
+    // Newest transactions first
+    ui->transactionTable->setItemFactory(this);
+    ui->transactionTable->setSortOrder(Qt::DescendingOrder);
+
     ui->progress->initLoader(true);
     ui->progressFrame->hide();
 
     onSgnWalletBalanceUpdated();
-    requestTransactions(false);
+    requestTransactions(false, true);
 
     updateData(false);
 
@@ -92,156 +84,156 @@ Transactions::~Transactions()
 }
 
 void Transactions::updateData(bool resetScroller) {
-    ui->transactionTable->clearAll(resetScroller);
+    // Items are built by the list for the visible rows only, see createRichItem
+    ui->transactionTable->setRowCount(allTrans.size(), resetScroller);
+}
+
+control::RichItem * Transactions::createRichItem(int idx, QWidget * parent) {
+    Q_ASSERT(idx>=0 && idx<allTrans.size());
+    const wallet::WalletTransaction &trans = allTrans[idx].trans;
 
-    QDateTime current = QDateTime::currentDateTime();
     int expectedConfirmNumber = config->getInputConfirmationNumber();
     QString currentAccount = ui->accountComboBox->currentData().toString();
 
-    int txCnt = 0;
-
-    for ( int idx = allTrans.size()-1; idx>=0 && txCnt<5000; idx--, txCnt++) {
-        TransactionData &tr = allTrans[idx];
-        const wallet::WalletTransaction &trans = tr.trans;
-
-        // if the node is online and in sync, display the number of confirmations instead of time
-        // trans.confirmationTime format: 2020-10-13 04:36:54
-        // Expected: Jan 2, 2020 / 2:07am
-        QString txTimeStr = trans.confirmationTime;
-        if (txTimeStr.isEmpty() || txTimeStr == "None")
-            txTimeStr = trans.creationTime;
-
-        QDateTime txTime = QDateTime::fromString(txTimeStr, "HH:mm:ss dd-MM-yyyy");
-        txTimeStr = txTime.toString("MMM d, yyyy / H:mmap");
-        bool blocksPrinted = false;
-        if (trans.confirmed && nodeHeight > 0 && trans.height > 0) {
-            int needConfirms = trans.isCoinbase() ? mwc::COIN_BASE_CONFIRM_NUMBER : expectedConfirmNumber;
-            // confirmations are 1 more than the difference between the node and transaction heights
-            int64_t confirmations = nodeHeight - trans.height + 1;
-            if (needConfirms >= confirmations) {
-                txTimeStr = "(" + QString::number(confirmations) + "/" + QString::number(needConfirms) + " blocks)";
-                blocksPrinted = true;
-            }
+    // if the node is online and in sync, display the number of confirmations instead of time
+    // Expected: Jan 2, 2020 / 2:07am
+    int64_t txTimestamp = trans.confirmationTime > 0 ? trans.confirmationTime : trans.creationTime;
+    QString txTimeStr = txTimestamp > 0 ? QDateTime::fromSecsSinceEpoch(txTimestamp).toString("MMM d, yyyy / H:mmap") : QString();
+    bool blocksPrinted = false;
+    if (trans.confirmed && nodeHeight > 0 && trans.height > 0) {
+        int needConfirms = trans.isCoinbase() ? mwc::COIN_BASE_CONFIRM_NUMBER : expectedConfirmNumber;
+        // confirmations are 1 more than the difference between the node and transaction heights
+        int64_t confirmations = nodeHeight - trans.height + 1;
+        if (needConfirms >= confirmations) {
+            txTimeStr = "(" + QString::number(confirmations) + "/" + QString::number(needConfirms) + " blocks)";
+            blocksPrinted = true;
         }
+    }
 
-        control::RichItem *itm = control::createMarkedItem(QString::number(idx), ui->transactionTable,
-                                                           trans.canBeCancelled(), "");
-
-        { // First line
-            itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
-            // Adding Icon and a text
-            itm->addWidget( control::createLabel(itm, false, false, "#" + QString::number(trans.txIdx + 1)) ).addFixedHSpacer(10);
-
-            if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::CANCELLED) {
-                itm->addWidget(control::createIcon(itm, ":/img/iconClose@2x.svg", control::ROW_HEIGHT,
-                                                   control::ROW_HEIGHT))
-                        .addWidget(control::createLabel(itm, false, false, "Cancelled"));
-            } else if (!trans.confirmed) {
-                itm->addWidget(control::createIcon(itm, ":/img/iconUnconfirmed@2x.svg", control::ROW_HEIGHT,
-                                                   control::ROW_HEIGHT))
-                        .addWidget(control::createLabel(itm, false, false, "Unconfirmed"));
-            } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::SEND) {
-                itm->addWidget(control::createIcon(itm, ":/img/iconSent@2x.svg", control::ROW_HEIGHT,
-                                                   control::ROW_HEIGHT))
-                        .addWidget(control::createLabel(itm, false, false, "Sent"));
-            } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::RECEIVE) {
-                itm->addWidget(control::createIcon(itm, ":/img/iconReceived@2x.svg", control::ROW_HEIGHT,
-                                                   control::ROW_HEIGHT))
-                        .addWidget(control::createLabel(itm, false, false, "Received"));
-            } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::COIN_BASE) {
-                itm->addWidget(control::createIcon(itm, ":/img/iconCoinbase@2x.svg", control::ROW_HEIGHT,
-                                                   control::ROW_HEIGHT))
-                        .addWidget(control::createLabel(itm, false, false, "CoinBase"));
-            } else {
-                Q_ASSERT(false);
-            }
+    control::RichItem *itm = control::createMarkedItem(QString::number(idx), parent,
+                                                       trans.canBeCancelled(), "");
+
+    { // First line
+        itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
+        // Adding Icon and a text
+        itm->addWidget( control::createLabel(itm, false, false, "#" + QString::number(trans.txIdx + 1)) ).addFixedHSpacer(10);
+
+        if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::CANCELLED) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconClose@2x.svg", control::ROW_HEIGHT,
+                                               control::ROW_HEIGHT))
+                    .addWidget(control::createLabel(itm, false, false, "Cancelled"));
+        } else if (!trans.confirmed) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconUnconfirmed@2x.svg", control::ROW_HEIGHT,
+                                               control::ROW_HEIGHT))
+                    .addWidget(control::createLabel(itm, false, false, "Unconfirmed"));
+        } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::SEND) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconSent@2x.svg", control::ROW_HEIGHT,
+                                               control::ROW_HEIGHT))
+                    .addWidget(control::createLabel(itm, false, false, "Sent"));
+        } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::RECEIVE) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconReceived@2x.svg", control::ROW_HEIGHT,
+                                               control::ROW_HEIGHT))
+                    .addWidget(control::createLabel(itm, false, false, "Received"));
+        } else if (trans.transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::COIN_BASE) {
+            itm->addWidget(control::createIcon(itm, ":/img/iconCoinbase@2x.svg", control::ROW_HEIGHT,
+                                               control::ROW_HEIGHT))
+                    .addWidget(control::createLabel(itm, false, false, "CoinBase"));
+        } else {
+            Q_ASSERT(false);
+        }
 
-            // Update with time or blocks
-            itm->addHSpacer().addWidget(control::createLabel(itm, false, true, txTimeStr));
+        // Update with time or blocks
+        itm->addHSpacer().addWidget(control::createLabel(itm, false, true, txTimeStr));
 
-            itm->pop();
-        } // First line
+        itm->pop();
+    } // First line
 
-        itm->addWidget(control::createHorzLine(itm));
+    itm->addWidget(control::createHorzLine(itm));
 
-        control::RichButton *cancelBtn = nullptr;
-        control::RichButton *repostBtn = nullptr;
+    control::RichButton *cancelBtn = nullptr;
+    control::RichButton *repostBtn = nullptr;
 
-        // Line with amount
-        {
-            QString amount = util::nano2one(trans.coinNano);
+    // Line with amount
+    {
+        QString amount = util::nano2one(trans.coinNano);
 
-            itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
-            itm->addWidget(control::createLabel(itm, false, false, amount + " MWC", control::FONT_LARGE));
+        itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
+        itm->addWidget(control::createLabel(itm, false, false, amount + " MWC", control::FONT_LARGE));
 
-            itm->addHSpacer();
+        itm->addHSpacer();
 
-            if (!blocksPrinted && nodeHeight > 0 && trans.height > 0) {
-                itm->addWidget(control::createLabel(itm, false, true,
-                                                   "Conf: " + QString::number(nodeHeight - trans.height + 1)));
-            }
-            if (trans.canBeCancelled()) {
-                itm->addWidget(new control::RichButton(itm, "Cancel", 60, control::ROW_HEIGHT, "Cancel this transaction and unlock coins"));
-                cancelBtn = (control::RichButton *) itm->getCurrentWidget();
-                cancelBtn->setCallback(this, "Cancel:" + QString::number(idx));
-            }
-            // Can be reposted
-            if (trans.transactionType == wallet::WalletTransaction::TRANSACTION_TYPE::SEND && !trans.confirmed) {
-                itm->addWidget(new control::RichButton(itm, "Repost", 60, control::ROW_HEIGHT, "Report this transaction to the network"));
-                repostBtn = (control::RichButton *) itm->getCurrentWidget();
-                repostBtn->setCallback(this,
-                                       "Repost:" + QString::number(idx) + ":" + currentAccount);
-            }
-            itm->pop();
+        if (!blocksPrinted && nodeHeight > 0 && trans.height > 0) {
+            itm->addWidget(control::createLabel(itm, false, true,
+                                               "Conf: " + QString::number(nodeHeight - trans.height + 1)));
         }
+        if (trans.canBeCancelled()) {
+            itm->addWidget(new control::RichButton(itm, "Cancel", 60, control::ROW_HEIGHT, "Cancel this transaction and unlock coins"));
+            cancelBtn = (control::RichButton *) itm->getCurrentWidget();
+            cancelBtn->setCallback(this, "Cancel:" + QString::number(idx));
+        }
+        // Can be reposted
+        if (trans.transactionType == wallet::WalletTransaction::TRANSACTION_TYPE::SEND && !trans.confirmed) {
+            itm->addWidget(new control::RichButton(itm, "Repost", 60, control::ROW_HEIGHT, "Report this transaction to the network"));
+            repostBtn = (control::RichButton *) itm->getCurrentWidget();
+            repostBtn->setCallback(this,
+                                   "Repost:" + QString::number(idx) + ":" + currentAccount);
+        }
+        itm->pop();
+    }
 
-        control::RichButton *proofBtn = nullptr;
-
-        // Line with ID
-        {
-            itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
-            itm->addWidget(control::createLabel(itm, false, true, trans.txid, control::FONT_SMALL));
-            itm->addHSpacer();
-            if (trans.proof) {
-                itm->addWidget(new control::RichButton(itm, "Proof", 60, control::ROW_HEIGHT,
-                                                       "Generate proof file for this transaction. Proof file can be validated by public at MWC Block Explorer"));
-                proofBtn = (control::RichButton *) itm->getCurrentWidget();
-                proofBtn->setCallback(this, "Proof:" + QString::number(idx));
-            }
-            itm->pop();
+    control::RichButton *proofBtn = nullptr;
+
+    // Line with ID
+    {
+        itm->hbox().setContentsMargins(0, 0, 0, 0).setSpacing(4);
+        itm->addWidget(control::createLabel(itm, false, true, trans.txid, control::FONT_SMALL));
+        itm->addHSpacer();
+        if (trans.proof) {
+            itm->addWidget(new control::RichButton(itm, "Proof", 60, control::ROW_HEIGHT,
+                                                   "Generate proof file for this transaction. Proof file can be validated by public at MWC Block Explorer"));
+            proofBtn = (control::RichButton *) itm->getCurrentWidget();
+            proofBtn->setCallback(this, "Proof:" + QString::number(idx));
         }
+        itm->pop();
+    }
 
 
-        // Address field...
-        if (!trans.address.isEmpty()) {
-            itm->hbox().setContentsMargins(0, 0, 0, 0);
-            itm->addWidget(control::createLabel(itm, false, true, trans.address, control::FONT_SMALL));
-            itm->addHSpacer().pop();
-        }
+    // Address field...
+    if (!trans.address.isEmpty()) {
+        itm->hbox().setContentsMargins(0, 0, 0, 0);
+        itm->addWidget(control::createLabel(itm, false, true, trans.address, control::FONT_SMALL));
+        itm->addHSpacer().pop();
+    }
 
-        // And the last optional line is comment
-        QLabel *noteL = nullptr;
-        {
-            QString txnNote = config->getTxNote(trans.txid);
+    // And the last optional line is comment
+    QLabel *noteL = nullptr;
+    {
+        QString txnNote = config->getTxNote(trans.txid);
 
-            itm->hbox().setContentsMargins(0, 0, 0, 0);
-            itm->addWidget(control::createLabel(itm, true, false, txnNote));
-            //itm->addHSpacer();
-            itm->pop();
+        itm->hbox().setContentsMargins(0, 0, 0, 0);
+        itm->addWidget(control::createLabel(itm, true, false, txnNote));
+        //itm->addHSpacer();
+        itm->pop();
 
-            noteL = (QLabel *) itm->getCurrentWidget();
-            if (txnNote.isEmpty())
-                noteL->hide();
-        }
-        Q_ASSERT(noteL);
+        noteL = (QLabel *) itm->getCurrentWidget();
+        if (txnNote.isEmpty())
+            noteL->hide();
+    }
+    Q_ASSERT(noteL);
 
-        itm->apply();
+    itm->apply();
+    return itm;
+}
 
-        tr.setBtns(itm, cancelBtn, repostBtn, proofBtn, noteL);
+QString Transactions::getRichItemFilterText(int idx) {
+    Q_ASSERT(idx>=0 && idx<allTrans.size());
+    const wallet::WalletTransaction &trans = allTrans[idx].trans;
+    return "#" + QString::number(trans.txIdx + 1) + " " + util::nano2one(trans.coinNano) + " " +
+            trans.txid + " " + trans.address + " " + config->getTxNote(trans.txid);
+}
 
-        ui->transactionTable->addItem(itm);
-    }
-    ui->transactionTable->apply();
+void Transactions::on_searchEdit_textChanged(const QString & text) {
+    ui->transactionTable->setFilterText(text.trimmed());
 }
 
 void Transactions::richButtonPressed(control::RichButton * button, QString coockie) {
@@ -328,7 +320,7 @@ void Transactions::onSgnRepost( int idx, QString err ) {
 }
 
 
-void Transactions::onSgnTransactions( QString acc, QString height, QVector<QString> transactions) {
+void Transactions::onSgnTransactionList( QString acc, QString height, QVector<wallet::WalletTransaction> transactions) {
     Q_UNUSED(height)
 
     if (acc != ui->accountComboBox->currentData().toString() )
@@ -339,10 +331,11 @@ void Transactions::onSgnTransactions( QString acc, QString height, QVector<QStri
 
     account = acc;
     allTrans.clear();
+    allTrans.reserve(transactions.size());
 
-    for (QString & t : transactions ) {
+    for (const wallet::WalletTransaction & t : transactions ) {
         TransactionData dt;
-        dt.trans = wallet::WalletTransaction::fromJson(t);
+        dt.trans = t;
         allTrans.push_back( dt );
     }
 
@@ -385,7 +378,7 @@ void Transactions::onSgnVerifyProofResult(bool success, QString fn, QString msg
 }
 
 
-void Transactions::requestTransactions(bool resetScroller) {
+void Transactions::requestTransactions(bool resetScroller, bool fromCache) {
     allTrans.clear();
     nodeHeight = -1;
 
@@ -395,17 +388,16 @@ void Transactions::requestTransactions(bool resetScroller) {
 
     ui->progressFrame->show();
     ui->transactionTable->hide();
-    ui->transactionTable->clearAll(resetScroller);
 
     // !!! Note, order is important even it is async. We want node status be processed first..
     wallet->requestNodeStatus(); // Need to know th height.
-    wallet->requestTransactions(account, true);
+    wallet->requestTransactions(account, true, fromCache);
     updateData(resetScroller);
 }
 
 void Transactions::on_refreshButton_clicked()
 {
-    requestTransactions(false);
+    requestTransactions(false, false);
 }
 
 void Transactions::on_validateProofButton_clicked()
@@ -520,14 +512,9 @@ void Transactions::onSgnTransactionById(bool success, QString account, QString h
                 }
 
                 // Updating the UI
-                for (const auto &tx : allTrans) {
-                    if (tx.trans.txid == transaction.txid) {
-                        tx.noteL->setText(txnNote);
-                        if (txnNote.isEmpty())
-                            tx.noteL->hide();
-                        else
-                            tx.noteL->show();
-                    }
+                for (int i=0; i<allTrans.size(); i++) {
+                    if (allTrans[i].trans.txid == transaction.txid)
+                        ui->transactionTable->refreshRow(i);
                 }
             }
         }
@@ -612,7 +599,7 @@ void Transactions::on_accountComboBox_activated(int index)
     QString account = ui->accountComboBox->currentData().toString();
     if (!account.isEmpty())
         wallet->switchAccount(account);
-    requestTransactions(true);
+    requestTransactions(true, false);
 }
 
 void Transactions::onSgnCancelTransacton(bool success, QString account, QString trIdxStr, QString errMessage) {
@@ -626,7 +613,7 @@ void Transactions::onSgnCancelTransacton(bool success, QString account, QString
 
     util::TimeoutLockObject to("Transactions");
     if (success) {
-        requestTransactions(false);
+        requestTransactions(false, false);
         // We don't need this confirmation, it makes UX worse
         //control::MessageBox::messageText(this, "Transaction was cancelled", "Transaction number " + QString::number(trIdx+1) + " was successfully cancelled");
     }
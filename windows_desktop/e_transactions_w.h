@@ -18,6 +18,7 @@
 #include "../core_desktop/navwnd.h"
 #include "../wallet/wallet.h"
 #include "../control_desktop/richbutton.h"
+#include "../control_desktop/richlistview.h"
 
 namespace Ui {
 class Transactions;
@@ -43,19 +44,9 @@ struct TransactionData {
     wallet::WalletTransaction trans;
     QString tx_note;
     QStringList tx_messages;
-
-    control::RichItem * ritem = nullptr;
-    control::RichButton * cancelBtn = nullptr;
-    control::RichButton * repostBtn = nullptr;
-    control::RichButton * proofBtn = nullptr;
-    QLabel * noteL = nullptr;
-
-    void setBtns(control::RichItem * ritem, control::RichButton * cancelBtn,
-                 control::RichButton * repostBtn, control::RichButton * proofBtn,
-                 QLabel * noteL);
 };
 
-class Transactions : public core::NavWnd,  control::RichButtonPressCallback
+class Transactions : public core::NavWnd,  control::RichButtonPressCallback, control::RichListItemFactory
 {
     Q_OBJECT
 
@@ -69,9 +60,10 @@ private slots:
     void on_refreshButton_clicked();
     void on_validateProofButton_clicked();
     void on_exportButton_clicked();
+    void on_searchEdit_textChanged(const QString & text);
 
     void onSgnWalletBalanceUpdated();
-    void onSgnTransactions( QString account, QString height, QVector<QString> transactions);
+    void onSgnTransactionList( QString account, QString height, QVector<wallet::WalletTransaction> transactions);
     void onSgnCancelTransacton(bool success, QString account, QString trIdx, QString errMessage);
 
     void onSgnTransactionById(bool success, QString account, QString height, QString transaction,
@@ -90,8 +82,13 @@ private slots:
 protected:
     virtual void richButtonPressed(control::RichButton * button, QString coockie) override;
 
+    // Items for the transactionTable, row is allTrans index
+    virtual control::RichItem * createRichItem(int row, QWidget * parent) override;
+    virtual QString getRichItemFilterText(int row) override;
+
 private:
-    void requestTransactions(bool resetScroller);
+    // fromCache - show the cached transactions until the fresh ones come
+    void requestTransactions(bool resetScroller, bool fromCache);
     void updateData(bool resetScroller);
 
 private:
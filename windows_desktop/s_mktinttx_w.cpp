@@ -32,8 +32,8 @@ IntegrityTransactions::IntegrityTransactions(QWidget *parent) :
     swapMarketplace = new bridge::SwapMarketplace(this);
     util = new bridge::Util(this);
 
-    QObject::connect( wallet, &bridge::Wallet::sgnTransactions,
-                      this, &IntegrityTransactions::onSgnTransactions, Qt::QueuedConnection);
+    QObject::connect( wallet, &bridge::Wallet::sgnTransactionList,
+                      this, &IntegrityTransactions::onSgnTransactionList, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnNodeStatus,
                       this, &IntegrityTransactions::onSgnNodeStatus, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnNewNotificationMessage,
@@ -61,7 +61,7 @@ void IntegrityTransactions::requestTransactions() {
 
     // !!! Note, order is important even it is async. We want node status be processed first..
     wallet->requestNodeStatus(); // Need to know th height.
-    wallet->requestTransactions("integrity", true);
+    wallet->requestTransactions("integrity", true, false);
     updateData();
 }
 
@@ -81,14 +81,9 @@ void IntegrityTransactions::updateData() {
             continue;
 
         // if the node is online and in sync, display the number of confirmations instead of time
-        // trans.confirmationTime format: 2020-10-13 04:36:54
         // Expected: Jan 2, 2020 / 2:07am
-        QString txTimeStr = trans.confirmationTime;
-        if (txTimeStr.isEmpty() || txTimeStr == "None")
-            txTimeStr = trans.creationTime;
-
-        QDateTime txTime = QDateTime::fromString(txTimeStr, "HH:mm:ss dd-MM-yyyy");
-        txTimeStr = txTime.toString("MMM d, yyyy / H:mmap");
+        int64_t txTimestamp = trans.confirmationTime > 0 ? trans.confirmationTime : trans.creationTime;
+        QString txTimeStr = txTimestamp > 0 ? QDateTime::fromSecsSinceEpoch(txTimestamp).toString("MMM d, yyyy / H:mmap") : QString();
         bool blocksPrinted = false;
         if (trans.confirmed && nodeHeight > 0 && trans.height > 0) {
             // confirmations are 1 more than the difference between the node and transaction heights
@@ -146,7 +141,7 @@ void IntegrityTransactions::on_backButton_clicked() {
     swapMarketplace->pageFee();
 }
 
-void IntegrityTransactions::onSgnTransactions( QString acc, QString height, QVector<QString> transactions)  {
+void IntegrityTransactions::onSgnTransactionList( QString acc, QString height, QVector<wallet::WalletTransaction> transactions)  {
     Q_UNUSED(height)
 
     if (acc != "integrity" )
@@ -155,11 +150,7 @@ void IntegrityTransactions::onSgnTransactions( QString acc, QString height, QVec
     ui->progressFrame->hide();
     ui->transactionTable->show();
 
-    allTrans.clear();
-
-    for (QString & t : transactions ) {
-        allTrans.push_back( wallet::WalletTransaction::fromJson(t) );
-    }
+    allTrans = transactions;
 
     updateData();
 }
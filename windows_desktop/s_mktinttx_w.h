@@ -46,7 +46,7 @@ private:
 private slots:
     void on_backButton_clicked();
 
-    void onSgnTransactions( QString account, QString height, QVector<QString> transactions);
+    void onSgnTransactionList( QString account, QString height, QVector<wallet::WalletTransaction> transactions);
 
     void onSgnNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, QString totalDifficulty, int connections );
     void onSgnNewNotificationMessage(int level, QString message); // level: bridge::MESSAGE_LEVEL values
@@ -6,24 +6,50 @@ Item {
     id: notificationsItem
 
     readonly property int msg_group_size: 5
+    // Wallet keeps the last 1000 notifications, no reasons to show more
+    readonly property int msg_limit: 1000
     property var locale: Qt.locale()
 
     EventsBridge {
         id: events
     }
 
+    Connections {
+        target: events
+        onSgnUpdateShowMessages: {
+            if (visible) {
+                showNewMessages()
+            }
+        }
+    }
+
+    function message2item(messages, i) {
+        const level = messages[i * msg_group_size + 2] === "Crit" ? "critical error" : messages[i * msg_group_size + 2];
+        const message = messages[i * msg_group_size + 4];
+
+        return {
+            date: messages[i*msg_group_size + 1],
+            level,
+            message
+        }
+    }
+
     function updateShowMessages() {
         const messages = events.getWalletNotificationMessages()
         notificationModel.clear()
         for (let i = messages.length / msg_group_size - 1; i>=0; i--) {
-            const level = messages[i * msg_group_size + 2] === "Crit" ? "critical error" : messages[i * msg_group_size + 2];
-            const message = messages[i * msg_group_size + 4];
-
-            notificationModel.append({
-                date: messages[i*msg_group_size + 1],
-                level,
-                message
-            })
+            notificationModel.append(message2item(messages, i))
+        }
+    }
+
+    // Only new messages are requested, they are going to the top
+    function showNewMessages() {
+        const messages = events.getNewNotificationMessages()
+        for (let i = 0; i < messages.length / msg_group_size; i++) {
+            notificationModel.insert(0, message2item(messages, i))
+        }
+        if (notificationModel.count > msg_limit) {
+            notificationModel.remove(msg_limit, notificationModel.count - msg_limit)
         }
     }
 
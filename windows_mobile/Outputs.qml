@@ -106,18 +106,19 @@ Item {
         }
     }
 
-    function requestOutputs(account) {
+    // fromCache - show the cached outputs until the fresh ones come
+    function requestOutputs(account, fromCache) {
         if (account) {
             allData = []
             outputsModel.clear()
             rect_progress.visible = true
             updateShownData()
-            wallet.requestOutputs(account, config.isShowOutputAll(), true)
+            wallet.requestOutputs(account, config.isShowOutputAll(), true, fromCache === true)
         }
     }
 
     function refreshOutputs() {
-        requestOutputs(currentSelectedAccount())
+        requestOutputs(currentSelectedAccount(), false)
     }
 
     function getOutputTypeIcon(outputStatus, coinbase) {
@@ -142,7 +143,7 @@ Item {
             showAll = config.isShowOutputAll()
             const accName = updateAccountsData();
             canLockOutputs = config.isLockOutputEnabled();
-            requestOutputs(accName);
+            requestOutputs(accName, true);
         }
     }
 
@@ -362,7 +363,7 @@ Item {
                 const selectedAccount = currentSelectedAccount();
                 if (selectedAccount !== "") {
                     wallet.switchAccount(selectedAccount);
-                    requestOutputs(selectedAccount);
+                    requestOutputs(selectedAccount, false);
                 }
             }
 
@@ -129,7 +129,7 @@ Item {
     onVisibleChanged: {
         if (visible) {
             rect_progress.visible = true
-           requestTransactions()
+           requestTransactions(true)
            updateData()
         }
     }
@@ -144,7 +144,8 @@ Item {
         wallet.requestCancelTransacton(wallet.getCurrentAccountName(), Number(txIdx).toString())
     }
 
-    function requestTransactions() {
+    // fromCache - show the cached transactions until the fresh ones come
+    function requestTransactions(fromCache) {
         transactionModel.clear()
         allTrans = []
         const account = wallet.getCurrentAccountName()
@@ -154,7 +155,7 @@ Item {
         rect_progress.visible = true
         transactionList.visible = false
         wallet.requestNodeStatus()
-        wallet.requestTransactions(account, true)
+        wallet.requestTransactions(account, true, fromCache === true)
         updateData()
     }
 